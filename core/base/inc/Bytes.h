@@ -585,4 +585,21 @@ inline Long64_t  net2host(Long64_t x)  { return host2net(x); }
 inline Float_t   net2host(Float_t x)   { return host2net(x); }
 inline Double_t  net2host(Double_t x)  { return host2net(x); }
 
+//______________________________________________________________________________
+// Array versions of the byte swapping done by frombuf() and tobuf(): copy n
+// elements of 2, 4 or 8 bytes from 'from' to 'to', reversing the byte order
+// of each element, and conversions of arrays of floats to and from the
+// truncated float encoding of Float16_t and Double32_t (3 bytes per value,
+// 2 <= nbits <= 16, see TBufferFile::WriteFloat16). They use the widest
+// vector instructions supported by the CPU, selected at run time.
+namespace ROOT {
+namespace Internal {
+void ByteSwapCopy16(void *to, const void *from, size_t n);
+void ByteSwapCopy32(void *to, const void *from, size_t n);
+void ByteSwapCopy64(void *to, const void *from, size_t n);
+void PackTruncatedFloats(char *to, const Float_t *from, size_t n, Int_t nbits);
+void UnpackTruncatedFloats(Float_t *to, const char *from, size_t n, Int_t nbits);
+} // namespace Internal
+} // namespace ROOT
+
 #endif
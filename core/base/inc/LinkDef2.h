@@ -98,6 +98,7 @@
 #pragma link C++ class TMessageHandler+;
 #pragma link C++ class TNamed+;
 #pragma link C++ class TNotifyLinkBase+;
+#pragma link C++ class TObjectPool;
 #pragma link C++ class TObjString+;
 #pragma link C++ class TObject-;
 #pragma link C++ class TRemoteObject-;
@@ -22,6 +22,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "TObject.h"
+#include "TObjectPool.h"
 #include "TString.h"
 
 
@@ -48,6 +49,7 @@ public:
    TString    &String() { return fString; }
 
    ClassDef(TObjString,1)  //Collectable string class
+   R__USE_OBJECT_POOL
 };
 
 #endif
@@ -0,0 +1,80 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TObjectPool
+#define ROOT_TObjectPool
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TObjectPool                                                          //
+//                                                                      //
+// Thread-local pooled allocator for small objects.                     //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TStorage.h"
+
+#include <vector>
+
+class TObjectPool {
+
+public:
+   enum {
+      kGranularity = 16,                       ///< step between two size classes
+      kMaxSize     = 256,                      ///< largest pooled object, larger ones use TStorage
+      kNSizeClasses = kMaxSize / kGranularity, ///< number of size classes
+      kChunkSize   = 64 * 1024                 ///< size of the arenas blocks are carved from
+   };
+
+   struct SizeClassStat_t {
+      size_t   fSize = 0;         ///< size of the blocks of this class
+      Long64_t fNAlloc = 0;       ///< number of allocations
+      Long64_t fNFree = 0;        ///< number of deallocations, by any thread
+      Long64_t fNRemoteFree = 0;  ///< deallocations by another thread than the allocating one
+      Long64_t fNChunks = 0;      ///< number of arenas reserved for this class
+   };
+
+   virtual ~TObjectPool() { }
+
+   static void  *ObjectAlloc(size_t size);
+   static void   ObjectDealloc(void *ptr, size_t size);
+
+   static std::vector<SizeClassStat_t> GetStatistics();
+   static Long64_t GetReservedBytes();
+   static Int_t    GetNHeaps();
+   static void     PrintStatistics();
+
+   ClassDef(TObjectPool,0)  //Thread-local pooled allocator for small objects
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give a class pooled operator new and delete. Put it in the class body,
+/// typically after ClassDef:
+/// ~~~ {.cpp}
+/// class TMyHit : public TObject {
+///    ...
+///    ClassDef(TMyHit, 1)
+///    R__USE_OBJECT_POOL
+/// };
+/// ~~~
+/// Objects of the class, and of the classes deriving from it, are then
+/// allocated from per-thread arenas, one per size class, if they are at most
+/// TObjectPool::kMaxSize bytes; larger ones go through TStorage as usual.
+/// They can be deleted from any thread. Arrays are not pooled.
+
+#define R__USE_OBJECT_POOL                                                        \
+public:                                                                           \
+   void *operator new(size_t sz) { return TObjectPool::ObjectAlloc(sz); }         \
+   void *operator new(size_t sz, void *vp) { return TStorage::ObjectAlloc(sz, vp); } \
+   void  operator delete(void *ptr, size_t sz) { TObjectPool::ObjectDealloc(ptr, sz); } \
+   void  operator delete(void *ptr, void *vp) { TStorage::ObjectDealloc(ptr, vp); }
+
+#endif
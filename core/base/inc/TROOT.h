@@ -30,6 +30,7 @@
 #include "RConfigure.h"
 
 #include <atomic>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -80,6 +81,7 @@ namespace Internal {
    void EnableParTreeProcessing();
    void DisableParTreeProcessing();
    Bool_t IsParTreeProcessingEnabled();
+   void ParallelFor(UInt_t n, const std::function<void(UInt_t)> &func);
    class TParTreeProcessingRAII {
    public:
       TParTreeProcessingRAII()  { EnableParTreeProcessing();  }
@@ -24,10 +24,108 @@
 
 #include "TObject.h"
 
+#include <atomic>
 #include <memory>
+#include <string>
 
 class TVirtualMutex;
 
+namespace ROOT {
+
+void EnableLockProfiling(const char *jsonfile = nullptr);
+void DisableLockProfiling();
+std::string GetLockProfile();
+void ResetLockProfile();
+
+namespace Internal {
+
+R__EXTERN std::atomic<bool> gLockProfiling;
+
+inline bool IsLockProfilingEnabled() { return gLockProfiling.load(std::memory_order_relaxed); }
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TLockSite                                                            //
+//                                                                      //
+// Acquisition statistics of one R__LOCKGUARD, R__READ_LOCKGUARD or     //
+// R__WRITE_LOCKGUARD call site. The macros create one static instance  //
+// per expansion; it is only updated while the lock profiling is        //
+// enabled, see ROOT::EnableLockProfiling(). The statistics of a site   //
+// destroyed at exit or when its library is unloaded are kept for      //
+// ROOT::GetLockProfile().                                              //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+class TLockSite {
+private:
+   std::string fFile;
+   int fLine;
+   std::string fMutex;
+   std::string fKind;
+   std::atomic<ULong64_t> fCount{0};     // number of acquisitions
+   std::atomic<ULong64_t> fWaitNs{0};    // total time waiting for the lock
+   std::atomic<ULong64_t> fMaxWaitNs{0}; // longest wait
+   std::atomic<ULong64_t> fHoldNs{0};    // total time holding the lock
+   std::atomic<ULong64_t> fMaxHoldNs{0}; // longest hold
+
+   TLockSite(const TLockSite &) = delete;
+   TLockSite &operator=(const TLockSite &) = delete;
+
+public:
+   TLockSite(const char *file, int line, const char *mutex, const char *kind);
+   ~TLockSite();
+
+   void Record(ULong64_t waitNs, ULong64_t holdNs);
+   void Reset();
+
+   const char *GetFile() const { return fFile.c_str(); }
+   int GetLine() const { return fLine; }
+   const char *GetMutex() const { return fMutex.c_str(); }
+   const char *GetKind() const { return fKind.c_str(); }
+   ULong64_t GetCount() const { return fCount; }
+   ULong64_t GetWaitNs() const { return fWaitNs; }
+   ULong64_t GetMaxWaitNs() const { return fMaxWaitNs; }
+   ULong64_t GetHoldNs() const { return fHoldNs; }
+   ULong64_t GetMaxHoldNs() const { return fMaxHoldNs; }
+
+   static ULong64_t Now();
+};
+
+// Measures one acquisition for the lock guards.
+class TLockProbe {
+private:
+   TLockSite *fSite = nullptr;
+   ULong64_t fTime = 0;
+   ULong64_t fWait = 0;
+
+public:
+   void Start(TLockSite *site)
+   {
+      if (site && IsLockProfilingEnabled()) {
+         fSite = site;
+         fTime = TLockSite::Now();
+      }
+   }
+   void Acquired()
+   {
+      if (fSite) {
+         ULong64_t now = TLockSite::Now();
+         fWait = now - fTime;
+         fTime = now;
+      }
+   }
+   void Released()
+   {
+      if (fSite) {
+         fSite->Record(fWait, TLockSite::Now() - fTime);
+         fSite = nullptr;
+      }
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
 // Global mutex set in TThread::Init
 R__EXTERN TVirtualMutex *gGlobalMutex;
 
@@ -70,20 +168,30 @@ class TLockGuard {
 
 private:
    TVirtualMutex *fMutex;
+   ROOT::Internal::TLockProbe fProbe; //! Profiling of the acquisition
 
    TLockGuard(const TLockGuard&);             // not implemented
    TLockGuard& operator=(const TLockGuard&);  // not implemented
 
 public:
-   TLockGuard(TVirtualMutex *mutex)
-     : fMutex(mutex) { if (fMutex) fMutex->Lock(); }
+   TLockGuard(TVirtualMutex *mutex, ROOT::Internal::TLockSite *site = nullptr)
+     : fMutex(mutex)
+   {
+      if (fMutex) {
+         fProbe.Start(site);
+         fMutex->Lock();
+         fProbe.Acquired();
+      }
+   }
    Int_t UnLock() {
       if (!fMutex) return 0;
       auto tmp = fMutex;
       fMutex = 0;
-      return tmp->UnLock();
+      auto res = tmp->UnLock();
+      fProbe.Released();
+      return res;
    }
-   ~TLockGuard() { if (fMutex) fMutex->UnLock(); }
+   ~TLockGuard() { UnLock(); }
 
    ClassDefNV(TLockGuard,0)  // Exception safe locking/unlocking of mutex
 };
@@ -91,7 +199,11 @@ public:
 // Zero overhead macros in case not compiled with thread support
 #if defined (_REENTRANT) || defined (WIN32)
 
-#define R__LOCKGUARD(mutex) TLockGuard _R__UNIQUE_(R__guard)(mutex)
+#define R__LOCKSITE(mutex, kind) \
+   static ::ROOT::Internal::TLockSite _R__UNIQUE_(R__locksite)(__FILE__, __LINE__, #mutex, kind)
+#define R__LOCKGUARD(mutex)      \
+   R__LOCKSITE(mutex, "lock"); \
+   TLockGuard _R__UNIQUE_(R__guard)(mutex, &_R__UNIQUE_(R__locksite))
 #define R__LOCKGUARD2(mutex)                             \
    if (gGlobalMutex && !mutex) {                         \
       gGlobalMutex->Lock();                              \
@@ -100,7 +212,9 @@ public:
       gGlobalMutex->UnLock();                            \
    }                                                     \
    R__LOCKGUARD(mutex)
-#define R__LOCKGUARD_NAMED(name,mutex) TLockGuard _NAME2_(R__guard,name)(mutex)
+#define R__LOCKGUARD_NAMED(name,mutex) \
+   R__LOCKSITE(mutex, "lock");        \
+   TLockGuard _NAME2_(R__guard,name)(mutex, &_R__UNIQUE_(R__locksite))
 #define R__LOCKGUARD_UNLOCK(name) _NAME2_(R__guard,name).UnLock()
 #else
 #define R__LOCKGUARD(mutex)  (void)(mutex); { }
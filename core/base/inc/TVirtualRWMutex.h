@@ -98,16 +98,26 @@ class TReadLockGuard {
 private:
    TVirtualRWMutex *const fMutex;
    TVirtualRWMutex::Hint_t *fHint;
+   Internal::TLockProbe fProbe; //! Profiling of the acquisition
 
    TReadLockGuard(const TReadLockGuard&) = delete;
    TReadLockGuard& operator=(const TReadLockGuard&) = delete;
 
 public:
-   TReadLockGuard(TVirtualRWMutex *mutex) : fMutex(mutex), fHint(nullptr) {
-      if (fMutex) fHint = fMutex->ReadLock();
+   TReadLockGuard(TVirtualRWMutex *mutex, Internal::TLockSite *site = nullptr) : fMutex(mutex), fHint(nullptr) {
+      if (fMutex) {
+         fProbe.Start(site);
+         fHint = fMutex->ReadLock();
+         fProbe.Acquired();
+      }
    }
 
-   ~TReadLockGuard() { if (fMutex) fMutex->ReadUnLock(fHint); }
+   ~TReadLockGuard() {
+      if (fMutex) {
+         fMutex->ReadUnLock(fHint);
+         fProbe.Released();
+      }
+   }
 
    ClassDefNV(TReadLockGuard,0)  // Exception safe read locking/unlocking of mutex
 };
@@ -117,16 +127,26 @@ class TWriteLockGuard {
 private:
    TVirtualRWMutex *const fMutex;
    TVirtualRWMutex::Hint_t *fHint;
+   Internal::TLockProbe fProbe; //! Profiling of the acquisition
 
    TWriteLockGuard(const TWriteLockGuard&) = delete;
    TWriteLockGuard& operator=(const TWriteLockGuard&) = delete;
 
 public:
-   TWriteLockGuard(TVirtualRWMutex *mutex) : fMutex(mutex), fHint(nullptr) {
-      if (fMutex) fHint = fMutex->WriteLock();
+   TWriteLockGuard(TVirtualRWMutex *mutex, Internal::TLockSite *site = nullptr) : fMutex(mutex), fHint(nullptr) {
+      if (fMutex) {
+         fProbe.Start(site);
+         fHint = fMutex->WriteLock();
+         fProbe.Acquired();
+      }
    }
 
-   ~TWriteLockGuard() { if (fMutex) fMutex->WriteUnLock(fHint); }
+   ~TWriteLockGuard() {
+      if (fMutex) {
+         fMutex->WriteUnLock(fHint);
+         fProbe.Released();
+      }
+   }
 
    ClassDefNV(TWriteLockGuard,0)  // Exception safe read locking/unlocking of mutex
 };
@@ -136,11 +156,19 @@ public:
 // Zero overhead macros in case not compiled with thread support
 #if defined (_REENTRANT) || defined (WIN32)
 
-#define R__READ_LOCKGUARD(mutex) ::ROOT::TReadLockGuard _R__UNIQUE_(R__readguard)(mutex)
-#define R__READ_LOCKGUARD_NAMED(name,mutex) ::ROOT::TReadLockGuard _NAME2_(R__readguard,name)(mutex)
-
-#define R__WRITE_LOCKGUARD(mutex) ::ROOT::TWriteLockGuard _R__UNIQUE_(R__readguard)(mutex)
-#define R__WRITE_LOCKGUARD_NAMED(name,mutex) ::ROOT::TWriteLockGuard _NAME2_(R__readguard,name)(mutex)
+#define R__READ_LOCKGUARD(mutex) \
+   R__LOCKSITE(mutex, "read");  \
+   ::ROOT::TReadLockGuard _R__UNIQUE_(R__readguard)(mutex, &_R__UNIQUE_(R__locksite))
+#define R__READ_LOCKGUARD_NAMED(name,mutex) \
+   R__LOCKSITE(mutex, "read");              \
+   ::ROOT::TReadLockGuard _NAME2_(R__readguard,name)(mutex, &_R__UNIQUE_(R__locksite))
+
+#define R__WRITE_LOCKGUARD(mutex) \
+   R__LOCKSITE(mutex, "write");  \
+   ::ROOT::TWriteLockGuard _R__UNIQUE_(R__readguard)(mutex, &_R__UNIQUE_(R__locksite))
+#define R__WRITE_LOCKGUARD_NAMED(name,mutex) \
+   R__LOCKSITE(mutex, "write");              \
+   ::ROOT::TWriteLockGuard _NAME2_(R__readguard,name)(mutex, &_R__UNIQUE_(R__locksite))
 
 #else
 
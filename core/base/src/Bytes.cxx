@@ -0,0 +1,365 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// Array byte swapping and truncated float conversion kernels.          //
+//                                                                      //
+// On x86 the kernels are compiled for SSSE3, AVX2 and AVX-512BW in     //
+// addition to the generic version and the best one supported by the    //
+// CPU is selected the first time a kernel is called.                   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Bytes.h"
+
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && !defined(__INTEL_COMPILER) && \
+    (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define R__BYTES_X86_DISPATCH
+#include <immintrin.h>
+#if (defined(__clang__) && __clang_major__ >= 5) || (!defined(__clang__) && __GNUC__ >= 6)
+#define R__BYTES_AVX512
+#endif
+#endif
+
+namespace {
+
+using SwapKernel_t = void (*)(void *, const void *, size_t);
+using PackKernel_t = void (*)(char *, const Float_t *, size_t, Int_t);
+using UnpackKernel_t = void (*)(Float_t *, const char *, size_t, Int_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generic versions, also used for the tail of the vectorized ones.
+
+void SwapCopy16Generic(void *to, const void *from, size_t n)
+{
+   const unsigned char *in = (const unsigned char *)from;
+   unsigned char *out = (unsigned char *)to;
+   for (size_t i = 0; i < n; ++i, in += 2, out += 2) {
+      unsigned char b0 = in[0];
+      out[0] = in[1];
+      out[1] = b0;
+   }
+}
+
+void SwapCopy32Generic(void *to, const void *from, size_t n)
+{
+   const char *in = (const char *)from;
+   char *out = (char *)to;
+   for (size_t i = 0; i < n; ++i, in += 4, out += 4) {
+      UInt_t x;
+      memcpy(&x, in, 4);
+      x = ((x & 0xff000000u) >> 24) | ((x & 0x00ff0000u) >> 8) | ((x & 0x0000ff00u) << 8) | ((x & 0x000000ffu) << 24);
+      memcpy(out, &x, 4);
+   }
+}
+
+void SwapCopy64Generic(void *to, const void *from, size_t n)
+{
+   const char *in = (const char *)from;
+   char *out = (char *)to;
+   for (size_t i = 0; i < n; ++i, in += 8, out += 8) {
+      UInt_t lo, hi;
+      memcpy(&lo, in, 4);
+      memcpy(&hi, in + 4, 4);
+      SwapCopy32Generic(out, &hi, 1);
+      SwapCopy32Generic(out + 4, &lo, 1);
+   }
+}
+
+// See TBufferFile::WriteFloat16 for the description of the encoding.
+void PackFloatsGeneric(char *to, const Float_t *from, size_t n, Int_t nbits)
+{
+   for (size_t i = 0; i < n; ++i, to += 3) {
+      UInt_t bits;
+      memcpy(&bits, &from[i], 4);
+      UChar_t theExp = (UChar_t)(0x000000ff & (bits >> 23));
+      UShort_t theMan = ((1 << (nbits + 1)) - 1) & (bits >> (23 - nbits - 1));
+      theMan++;
+      theMan = theMan >> 1;
+      if (theMan & 1 << nbits)
+         theMan = (1 << nbits) - 1;
+      if (from[i] < 0)
+         theMan |= 1 << (nbits + 1);
+      to[0] = (char)theExp;
+      to[1] = (char)(theMan >> 8);
+      to[2] = (char)(theMan & 0xff);
+   }
+}
+
+void UnpackFloatsGeneric(Float_t *to, const char *from, size_t n, Int_t nbits)
+{
+   for (size_t i = 0; i < n; ++i, from += 3) {
+      UInt_t theExp = (UChar_t)from[0];
+      UInt_t theMan = ((UInt_t)(UChar_t)from[1] << 8) | (UChar_t)from[2];
+      UInt_t bits = theExp << 23;
+      bits |= (theMan & ((1 << (nbits + 1)) - 1)) << (23 - nbits);
+      if ((1 << (nbits + 1)) & theMan)
+         bits ^= 0x80000000u;
+      memcpy(&to[i], &bits, 4);
+   }
+}
+
+#ifdef R__BYTES_X86_DISPATCH
+
+////////////////////////////////////////////////////////////////////////////////
+/// Byte swapping with one byte shuffle per vector.
+
+__attribute__((target("ssse3"))) __m128i SwapMask128(int size)
+{
+   if (size == 2)
+      return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+   if (size == 4)
+      return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+   return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+}
+
+template <int Size>
+__attribute__((target("ssse3"))) void SwapCopySSSE3(void *to, const void *from, size_t n)
+{
+   const char *in = (const char *)from;
+   char *out = (char *)to;
+   const __m128i mask = SwapMask128(Size);
+   size_t nbytes = n * Size;
+   size_t i = 0;
+   for (; i + 16 <= nbytes; i += 16) {
+      __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+      _mm_storeu_si128((__m128i *)(out + i), _mm_shuffle_epi8(v, mask));
+   }
+   size_t done = i / Size;
+   if (Size == 2)
+      SwapCopy16Generic(out + i, in + i, n - done);
+   else if (Size == 4)
+      SwapCopy32Generic(out + i, in + i, n - done);
+   else
+      SwapCopy64Generic(out + i, in + i, n - done);
+}
+
+template <int Size>
+__attribute__((target("avx2"))) void SwapCopyAVX2(void *to, const void *from, size_t n)
+{
+   const char *in = (const char *)from;
+   char *out = (char *)to;
+   const __m128i half = SwapMask128(Size);
+   const __m256i mask = _mm256_inserti128_si256(_mm256_castsi128_si256(half), half, 1);
+   size_t nbytes = n * Size;
+   size_t i = 0;
+   for (; i + 64 <= nbytes; i += 64) {
+      __m256i v0 = _mm256_loadu_si256((const __m256i *)(in + i));
+      __m256i v1 = _mm256_loadu_si256((const __m256i *)(in + i + 32));
+      _mm256_storeu_si256((__m256i *)(out + i), _mm256_shuffle_epi8(v0, mask));
+      _mm256_storeu_si256((__m256i *)(out + i + 32), _mm256_shuffle_epi8(v1, mask));
+   }
+   SwapCopySSSE3<Size>(out + i, in + i, n - i / Size);
+}
+
+#ifdef R__BYTES_AVX512
+template <int Size>
+__attribute__((target("avx512f,avx512bw"))) void SwapCopyAVX512(void *to, const void *from, size_t n)
+{
+   const char *in = (const char *)from;
+   char *out = (char *)to;
+   const __m512i mask = _mm512_broadcast_i32x4(SwapMask128(Size));
+   size_t nbytes = n * Size;
+   size_t i = 0;
+   for (; i + 64 <= nbytes; i += 64) {
+      __m512i v = _mm512_loadu_si512((const void *)(in + i));
+      _mm512_storeu_si512((void *)(out + i), _mm512_shuffle_epi8(v, mask));
+   }
+   SwapCopyAVX2<Size>(out + i, in + i, n - i / Size);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Truncated floats: the 3 bytes (exponent, mantissa high, mantissa low) of
+/// 4 values are shuffled to/from one 32 bits lane each, holding exp<<16|man.
+
+__attribute__((target("ssse3"))) __m128i UnpackFloats128(__m128i packed, __m128i manMask, __m128i signBit,
+                                                         __m128i manShift, __m128i signShift)
+{
+   const __m128i spread = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+   __m128i v = _mm_shuffle_epi8(packed, spread);
+   __m128i exp = _mm_slli_epi32(_mm_srli_epi32(v, 16), 23);
+   __m128i man = _mm_sll_epi32(_mm_and_si128(v, manMask), manShift);
+   __m128i sign = _mm_slli_epi32(_mm_srl_epi32(_mm_and_si128(v, signBit), signShift), 31);
+   return _mm_or_si128(_mm_or_si128(exp, man), sign);
+}
+
+__attribute__((target("ssse3"))) void UnpackFloatsSSSE3(Float_t *to, const char *from, size_t n, Int_t nbits)
+{
+   // The mantissa is stored on 16 bits.
+   const __m128i manMask = _mm_set1_epi32(((1 << (nbits + 1)) - 1) & 0xffff);
+   const __m128i signBit = _mm_set1_epi32((1 << (nbits + 1)) & 0xffff);
+   const __m128i manShift = _mm_cvtsi32_si128(23 - nbits);
+   const __m128i signShift = _mm_cvtsi32_si128(nbits + 1);
+   size_t i = 0;
+   // Each load reads 16 bytes for 12 used ones.
+   for (; i + 6 <= n; i += 4) {
+      __m128i packed = _mm_loadu_si128((const __m128i *)(from + 3 * i));
+      __m128i bits = UnpackFloats128(packed, manMask, signBit, manShift, signShift);
+      _mm_storeu_ps(to + i, _mm_castsi128_ps(bits));
+   }
+   UnpackFloatsGeneric(to + i, from + 3 * i, n - i, nbits);
+}
+
+__attribute__((target("avx2"))) void UnpackFloatsAVX2(Float_t *to, const char *from, size_t n, Int_t nbits)
+{
+   const __m256i spread = _mm256_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+                                           2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+   const __m256i manMask = _mm256_set1_epi32(((1 << (nbits + 1)) - 1) & 0xffff);
+   const __m256i signBit = _mm256_set1_epi32((1 << (nbits + 1)) & 0xffff);
+   const __m128i manShift = _mm_cvtsi32_si128(23 - nbits);
+   const __m128i signShift = _mm_cvtsi32_si128(nbits + 1);
+   size_t i = 0;
+   for (; i + 10 <= n; i += 8) {
+      __m128i lo = _mm_loadu_si128((const __m128i *)(from + 3 * i));
+      __m128i hi = _mm_loadu_si128((const __m128i *)(from + 3 * i + 12));
+      __m256i v = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), spread);
+      __m256i exp = _mm256_slli_epi32(_mm256_srli_epi32(v, 16), 23);
+      __m256i man = _mm256_sll_epi32(_mm256_and_si256(v, manMask), manShift);
+      __m256i sign = _mm256_slli_epi32(_mm256_srl_epi32(_mm256_and_si256(v, signBit), signShift), 31);
+      __m256i bits = _mm256_or_si256(_mm256_or_si256(exp, man), sign);
+      _mm256_storeu_ps(to + i, _mm256_castsi256_ps(bits));
+   }
+   UnpackFloatsSSSE3(to + i, from + 3 * i, n - i, nbits);
+}
+
+__attribute__((target("ssse3"))) void PackFloatsSSSE3(char *to, const Float_t *from, size_t n, Int_t nbits)
+{
+   const __m128i gather = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+   // The mantissa is computed on 16 bits, as in the generic version.
+   const __m128i expMask = _mm_set1_epi32(0xff);
+   const __m128i shortMask = _mm_set1_epi32(0xffff);
+   const __m128i manMask = _mm_set1_epi32(((1 << (nbits + 1)) - 1) & 0xffff);
+   const __m128i one = _mm_set1_epi32(1);
+   const __m128i saturated = _mm_set1_epi32((1 << nbits) - 1);
+   const __m128i signBit = _mm_set1_epi32((1 << (nbits + 1)) & 0xffff);
+   const __m128i manShift = _mm_cvtsi32_si128(23 - nbits - 1);
+   const __m128 zero = _mm_setzero_ps();
+   size_t i = 0;
+   // Each store writes 16 bytes for 12 used ones.
+   for (; i + 6 <= n; i += 4) {
+      __m128 f = _mm_loadu_ps(from + i);
+      __m128i bits = _mm_castps_si128(f);
+      __m128i exp = _mm_and_si128(_mm_srli_epi32(bits, 23), expMask);
+      __m128i man = _mm_and_si128(_mm_sra_epi32(bits, manShift), manMask);
+      man = _mm_srli_epi32(_mm_and_si128(_mm_add_epi32(man, one), shortMask), 1);
+      // man has at most nbits+1 bits, bit nbits is set if it is above the saturated value.
+      __m128i isOverflow = _mm_cmpgt_epi32(man, saturated);
+      man = _mm_or_si128(_mm_andnot_si128(isOverflow, man), _mm_and_si128(isOverflow, saturated));
+      man = _mm_or_si128(man, _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(f, zero)), signBit));
+      __m128i v = _mm_or_si128(_mm_slli_epi32(exp, 16), man);
+      _mm_storeu_si128((__m128i *)(to + 3 * i), _mm_shuffle_epi8(v, gather));
+   }
+   PackFloatsGeneric(to + 3 * i, from + i, n - i, nbits);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Select the best kernel supported by the CPU.
+
+SwapKernel_t SelectSwapKernel(int size)
+{
+   __builtin_cpu_init();
+#ifdef R__BYTES_AVX512
+   if (__builtin_cpu_supports("avx512bw"))
+      return size == 2 ? &SwapCopyAVX512<2> : size == 4 ? &SwapCopyAVX512<4> : &SwapCopyAVX512<8>;
+#endif
+   if (__builtin_cpu_supports("avx2"))
+      return size == 2 ? &SwapCopyAVX2<2> : size == 4 ? &SwapCopyAVX2<4> : &SwapCopyAVX2<8>;
+   if (__builtin_cpu_supports("ssse3"))
+      return size == 2 ? &SwapCopySSSE3<2> : size == 4 ? &SwapCopySSSE3<4> : &SwapCopySSSE3<8>;
+   return size == 2 ? &SwapCopy16Generic : size == 4 ? &SwapCopy32Generic : &SwapCopy64Generic;
+}
+
+PackKernel_t SelectPackKernel()
+{
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("ssse3"))
+      return &PackFloatsSSSE3;
+   return &PackFloatsGeneric;
+}
+
+UnpackKernel_t SelectUnpackKernel()
+{
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+      return &UnpackFloatsAVX2;
+   if (__builtin_cpu_supports("ssse3"))
+      return &UnpackFloatsSSSE3;
+   return &UnpackFloatsGeneric;
+}
+
+#else
+
+SwapKernel_t SelectSwapKernel(int size)
+{
+   return size == 2 ? &SwapCopy16Generic : size == 4 ? &SwapCopy32Generic : &SwapCopy64Generic;
+}
+
+PackKernel_t SelectPackKernel()
+{
+   return &PackFloatsGeneric;
+}
+
+UnpackKernel_t SelectUnpackKernel()
+{
+   return &UnpackFloatsGeneric;
+}
+
+#endif
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy n elements of 2 bytes from 'from' to 'to', swapping their bytes.
+
+void ROOT::Internal::ByteSwapCopy16(void *to, const void *from, size_t n)
+{
+   static const SwapKernel_t kernel = SelectSwapKernel(2);
+   kernel(to, from, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy n elements of 4 bytes from 'from' to 'to', reversing their bytes.
+
+void ROOT::Internal::ByteSwapCopy32(void *to, const void *from, size_t n)
+{
+   static const SwapKernel_t kernel = SelectSwapKernel(4);
+   kernel(to, from, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy n elements of 8 bytes from 'from' to 'to', reversing their bytes.
+
+void ROOT::Internal::ByteSwapCopy64(void *to, const void *from, size_t n)
+{
+   static const SwapKernel_t kernel = SelectSwapKernel(8);
+   kernel(to, from, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Encode n floats as truncated floats with nbits of mantissa, 3 bytes each.
+
+void ROOT::Internal::PackTruncatedFloats(char *to, const Float_t *from, size_t n, Int_t nbits)
+{
+   static const PackKernel_t kernel = SelectPackKernel();
+   kernel(to, from, n, nbits);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decode n truncated floats with nbits of mantissa, 3 bytes each.
+
+void ROOT::Internal::UnpackTruncatedFloats(Float_t *to, const char *from, size_t n, Int_t nbits)
+{
+   static const UnpackKernel_t kernel = SelectUnpackKernel();
+   kernel(to, from, n, nbits);
+}
@@ -94,7 +94,7 @@ static void CallEndOfProcessCleanups()
 
 TApplication::TApplication() :
    fArgc(0), fArgv(0), fAppImp(0), fIsRunning(kFALSE), fReturnFromRun(kFALSE),
-   fNoLog(kFALSE), fNoLogo(kFALSE), fQuit(kFALSE), fUseMemstat(kFALSE),
+   fNoLog(kFALSE), fNoLogo(kFALSE), fQuit(kFALSE), fUseMemstat(kFALSE), fUseMemProfiler(kFALSE),
    fFiles(0), fIdleTimer(0), fSigHandler(0), fExitOnException(kDontExit),
    fAppRemote(0)
 {
@@ -118,7 +118,7 @@ TApplication::TApplication() :
 TApplication::TApplication(const char *appClassName, Int_t *argc, char **argv,
                            void * /*options*/, Int_t numOptions) :
    fArgc(0), fArgv(0), fAppImp(0), fIsRunning(kFALSE), fReturnFromRun(kFALSE),
-   fNoLog(kFALSE), fNoLogo(kFALSE), fQuit(kFALSE), fUseMemstat(kFALSE),
+   fNoLog(kFALSE), fNoLogo(kFALSE), fQuit(kFALSE), fUseMemstat(kFALSE), fUseMemProfiler(kFALSE),
    fFiles(0), fIdleTimer(0), fSigHandler(0), fExitOnException(kDontExit),
    fAppRemote(0)
 {
@@ -207,6 +207,13 @@ TApplication::TApplication(const char *appClassName, Int_t *argc, char **argv,
       }
    }
 
+   // activate TMemProfiler
+   if (!fUseMemstat && gEnv->GetValue("Root.MemProfile", kFALSE)) {
+      Int_t interval = gEnv->GetValue("Root.MemProfile.Interval", 524288);
+      Int_t depth    = gEnv->GetValue("Root.MemProfile.Depth", 16);
+      fUseMemProfiler = gROOT->ProcessLine(Form("TMemProfiler::Start(%d,%d);", interval, depth)) != 0;
+   }
+
    //Needs to be done last
    gApplication = this;
    gROOT->SetApplication(this);
@@ -230,6 +237,10 @@ TApplication::~TApplication()
       ProcessLine("TMemStat::Close()");
       fUseMemstat = kFALSE;
    }
+   if (fUseMemProfiler) {
+      ProcessLine("TMemProfiler::Close()");
+      fUseMemProfiler = kFALSE;
+   }
 
    // Reduce the risk of the files or sockets being closed after the
    // end of 'main' (or more exactly before the library start being
@@ -1244,6 +1255,10 @@ void TApplication::Terminate(Int_t status)
          ProcessLine("TMemStat::Close()");
          fUseMemstat = kFALSE;
       }
+      if (fUseMemProfiler) {
+         ProcessLine("TMemProfiler::Close()");
+         fUseMemProfiler = kFALSE;
+      }
 
       gSystem->Exit(status);
    }
@@ -236,8 +236,9 @@ void TDirectory::Browse(TBrowser *b)
 
 void TDirectory::BuildDirectory(TFile* /*motherFile*/, TDirectory* motherDir)
 {
-   fList       = new THashList(100,50);
-   fList->UseRWLock();
+   THashList *list = new THashList(100,50);
+   list->UseLocalLock();
+   fList       = list;
    fMother     = motherDir;
    SetBit(kCanDelete);
 
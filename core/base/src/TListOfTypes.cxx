@@ -104,6 +104,13 @@ TDataType *TListOfTypes::FindType(const char *name) const
    TDataType *result = static_cast<TDataType*>(THashTable::FindObject(name));
    if (!result) {
 
+      // In lazy mode (Root.LazyPCM), the PCM describing the typedef may not be loaded yet.
+      if (gInterpreter->LoadPendingPCMs(name)) {
+         result = static_cast<TDataType*>(THashTable::FindObject(name));
+         if (result)
+            return result;
+      }
+
       if (NameExistsElsewhere(name)) {
          return nullptr;
       }
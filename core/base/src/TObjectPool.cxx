@@ -0,0 +1,345 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TObjectPool
+\ingroup Base
+
+Thread-local pooled allocator for small objects.
+
+Workloads creating and deleting millions of small objects (TObjString,
+TLorentzVector, ...) spend much of their time in the global allocator, which
+also fragments the heap across threads. Classes can opt in to this pool by
+putting the macro R__USE_OBJECT_POOL in their body, next to ClassDef:
+~~~ {.cpp}
+class TMyHit : public TObject {
+   ...
+   ClassDef(TMyHit, 1)
+   R__USE_OBJECT_POOL
+};
+~~~
+Each thread owns a heap with one free list per size class (multiples of
+kGranularity bytes up to kMaxSize bytes). A free list is refilled by carving
+blocks out of kChunkSize arenas, aligned on their size so that the arena,
+and from it the owning heap and the size class, of any block is found by
+masking its address. Allocations and deallocations by the owning thread do
+not take any lock. A block deleted by another thread is pushed on a lock-free
+list of the owning heap, which the owner takes back in one go when its own
+free list is empty. When a thread exits its heap is kept, with its
+outstanding blocks, and handed over to the next new thread.
+
+The arenas are not given back to the system: the pool is meant for objects
+that are churned through, not for one-off peaks of memory usage. Objects
+larger than kMaxSize, e.g. of a derived class, are allocated through
+TStorage, as are arrays.
+
+GetStatistics() and PrintStatistics() report the number of allocations,
+deallocations, cross-thread deallocations and arenas per size class.
+*/
+
+#include "TObjectPool.h"
+#include "TObject.h"
+#include "TString.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+ClassImp(TObjectPool);
+
+namespace {
+
+struct TFreeBlock {
+   TFreeBlock *fNext;
+};
+
+struct TSizeClass {
+   // Owned by the thread using the heap
+   TFreeBlock *fFree = nullptr;                 // blocks ready to be reused
+   char *fBump = nullptr;                       // next block never used in the current arena
+   char *fBumpEnd = nullptr;                    // end of the current arena
+   std::atomic<Long64_t> fNAlloc{0};
+   std::atomic<Long64_t> fNLocalFree{0};
+   std::atomic<Long64_t> fNChunks{0};
+   // Written by the other threads, on its own cache line
+   alignas(64) std::atomic<TFreeBlock *> fRemote{nullptr}; // blocks freed by other threads
+   std::atomic<Long64_t> fNRemoteFree{0};
+};
+
+struct THeap {
+   TSizeClass fClasses[TObjectPool::kNSizeClasses];
+};
+
+// Header at the start of each arena
+struct TChunk {
+   THeap *fOwner;
+   Int_t fSizeClass;
+};
+
+const size_t kHeaderSize = 64;
+static_assert(sizeof(TChunk) <= kHeaderSize, "TChunk does not fit in the arena header");
+
+struct TRegistry {
+   std::mutex fMutex;
+   std::vector<THeap *> fHeaps;     // all the heaps ever created
+   std::vector<THeap *> fAbandoned; // heaps of the threads which exited
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// The registry is never deleted: objects can be deleted during the
+/// destruction of the static objects, in any order.
+
+TRegistry &GetRegistry()
+{
+   static TRegistry *registry = new TRegistry;
+   return *registry;
+}
+
+void *AlignedAlloc(size_t alignment, size_t size)
+{
+#ifdef _WIN32
+   void *ptr = _aligned_malloc(size, alignment);
+#else
+   void *ptr = nullptr;
+   if (posix_memalign(&ptr, alignment, size))
+      ptr = nullptr;
+#endif
+   if (!ptr)
+      throw std::bad_alloc();
+   return ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Increment a counter only ever written by one thread, without the cost of
+/// an atomic read-modify-write.
+
+inline void Increment(std::atomic<Long64_t> &counter)
+{
+   counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void AbandonHeap(THeap *heap);
+
+struct THeapGuard {
+   THeap *fHeap = nullptr;
+   ~THeapGuard();
+};
+
+thread_local THeap *tHeap = nullptr;
+thread_local bool tExiting = false;
+thread_local THeapGuard tHeapGuard;
+
+THeapGuard::~THeapGuard()
+{
+   tExiting = true;
+   tHeap = nullptr;
+   if (fHeap)
+      AbandonHeap(fHeap);
+}
+
+void AbandonHeap(THeap *heap)
+{
+   TRegistry &registry = GetRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   registry.fAbandoned.push_back(heap);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give the calling thread a heap, reusing the one of an exited thread if
+/// possible.
+
+THeap *AcquireHeap()
+{
+   THeap *heap = nullptr;
+   {
+      TRegistry &registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.fMutex);
+      if (!registry.fAbandoned.empty()) {
+         heap = registry.fAbandoned.back();
+         registry.fAbandoned.pop_back();
+      } else {
+         heap = new (AlignedAlloc(64, sizeof(THeap))) THeap;
+         registry.fHeaps.push_back(heap);
+      }
+   }
+   tHeap = heap;
+   // During the destruction of the thread the heap stays with it: it can still
+   // be freed into but is not reused by another thread.
+   if (!tExiting)
+      tHeapGuard.fHeap = heap;
+   return heap;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Slow path of the allocation, when the free list of the size class is
+/// empty: take back the blocks freed by other threads, else carve a new
+/// block out of the current arena, else reserve a new arena.
+
+TFreeBlock *Refill(THeap *heap, Int_t cls)
+{
+   TSizeClass &sc = heap->fClasses[cls];
+   if (TFreeBlock *remote = sc.fRemote.exchange(nullptr, std::memory_order_acquire)) {
+      sc.fFree = remote->fNext;
+      return remote;
+   }
+   const size_t blockSize = (cls + 1) * TObjectPool::kGranularity;
+   if (sc.fBump == sc.fBumpEnd) {
+      char *mem = static_cast<char *>(AlignedAlloc(TObjectPool::kChunkSize, TObjectPool::kChunkSize));
+      TChunk *chunk = reinterpret_cast<TChunk *>(mem);
+      chunk->fOwner = heap;
+      chunk->fSizeClass = cls;
+      sc.fBump = mem + kHeaderSize;
+      sc.fBumpEnd = sc.fBump + (TObjectPool::kChunkSize - kHeaderSize) / blockSize * blockSize;
+      Increment(sc.fNChunks);
+   }
+   TFreeBlock *block = reinterpret_cast<TFreeBlock *>(sc.fBump);
+   sc.fBump += blockSize;
+   return block;
+}
+
+} // unnamed namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate an object of size bytes from the heap of the calling thread.
+/// Like TStorage::ObjectAlloc(), the memory is filled with
+/// TStorage::kObjectAllocMemValue so that TObject knows it is on the heap.
+
+void *TObjectPool::ObjectAlloc(size_t size)
+{
+   if (size == 0 || size > kMaxSize)
+      return TStorage::ObjectAlloc(size);
+
+   const Int_t cls = (size - 1) / kGranularity;
+   THeap *heap = tHeap ? tHeap : AcquireHeap();
+   TSizeClass &sc = heap->fClasses[cls];
+   TFreeBlock *block = sc.fFree;
+   if (block)
+      sc.fFree = block->fNext;
+   else
+      block = Refill(heap, cls);
+   Increment(sc.fNAlloc);
+   memset(block, TStorage::kObjectAllocMemValue, size);
+   return block;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give back an object of size bytes allocated by ObjectAlloc(), from any
+/// thread. As TObject::operator delete(), only the destructor is run if the
+/// object was passed to TObject::SetDtorOnly().
+
+void TObjectPool::ObjectDealloc(void *ptr, size_t size)
+{
+   if (!ptr)
+      return;
+   if ((Long_t)ptr == TObject::GetDtorOnly()) {
+      TObject::SetDtorOnly(nullptr);
+      return;
+   }
+   if (size == 0 || size > kMaxSize) {
+      TStorage::ObjectDealloc(ptr);
+      return;
+   }
+
+   TChunk *chunk = reinterpret_cast<TChunk *>(reinterpret_cast<uintptr_t>(ptr) & ~uintptr_t(kChunkSize - 1));
+   TSizeClass &sc = chunk->fOwner->fClasses[chunk->fSizeClass];
+   TFreeBlock *block = static_cast<TFreeBlock *>(ptr);
+   if (chunk->fOwner == tHeap) {
+      block->fNext = sc.fFree;
+      sc.fFree = block;
+      Increment(sc.fNLocalFree);
+   } else {
+      TFreeBlock *head = sc.fRemote.load(std::memory_order_relaxed);
+      do {
+         block->fNext = head;
+      } while (!sc.fRemote.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+      sc.fNRemoteFree.fetch_add(1, std::memory_order_relaxed);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Counters of each size class, summed over the heaps of all the threads.
+/// The counters of the running threads are read on the fly, so the sums are
+/// only consistent when no pooled object is being created or deleted.
+
+std::vector<TObjectPool::SizeClassStat_t> TObjectPool::GetStatistics()
+{
+   std::vector<SizeClassStat_t> stats(kNSizeClasses);
+   for (Int_t cls = 0; cls < kNSizeClasses; ++cls)
+      stats[cls].fSize = (cls + 1) * kGranularity;
+
+   TRegistry &registry = GetRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   for (THeap *heap : registry.fHeaps) {
+      for (Int_t cls = 0; cls < kNSizeClasses; ++cls) {
+         const TSizeClass &sc = heap->fClasses[cls];
+         const Long64_t remote = sc.fNRemoteFree.load(std::memory_order_relaxed);
+         stats[cls].fNAlloc += sc.fNAlloc.load(std::memory_order_relaxed);
+         stats[cls].fNFree += sc.fNLocalFree.load(std::memory_order_relaxed) + remote;
+         stats[cls].fNRemoteFree += remote;
+         stats[cls].fNChunks += sc.fNChunks.load(std::memory_order_relaxed);
+      }
+   }
+   return stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Memory reserved by the pool: arenas and heaps.
+
+Long64_t TObjectPool::GetReservedBytes()
+{
+   Long64_t bytes = 0;
+   for (const auto &stat : GetStatistics())
+      bytes += stat.fNChunks * kChunkSize;
+   return bytes + GetNHeaps() * Long64_t(sizeof(THeap));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of heaps created so far, i.e. the maximum number of threads which
+/// used the pool at the same time.
+
+Int_t TObjectPool::GetNHeaps()
+{
+   TRegistry &registry = GetRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   return registry.fHeaps.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the statistics of the size classes in use.
+
+void TObjectPool::PrintStatistics()
+{
+   const auto stats = GetStatistics();
+   Printf("Object pool statistics");
+   Printf("%8s%14s%14s%14s%14s%8s", "size", "alloc", "free", "remote free", "in use", "arenas");
+   Printf("========================================================================");
+   SizeClassStat_t total;
+   for (const auto &stat : stats) {
+      if (!stat.fNChunks)
+         continue;
+      Printf("%8d%14lld%14lld%14lld%14lld%8lld", (Int_t)stat.fSize, stat.fNAlloc, stat.fNFree, stat.fNRemoteFree,
+             stat.fNAlloc - stat.fNFree, stat.fNChunks);
+      total.fNAlloc += stat.fNAlloc;
+      total.fNFree += stat.fNFree;
+      total.fNRemoteFree += stat.fNRemoteFree;
+      total.fNChunks += stat.fNChunks;
+   }
+   Printf("------------------------------------------------------------------------");
+   Printf("%8s%14lld%14lld%14lld%14lld%8lld", "Total:", total.fNAlloc, total.fNFree, total.fNRemoteFree,
+          total.fNAlloc - total.fNFree, total.fNChunks);
+   Printf("Reserved: %lld bytes in %d heaps", GetReservedBytes(), GetNHeaps());
+   Printf("========================================================================");
+}
@@ -612,6 +612,26 @@ namespace Internal {
       return ROOT::Internal::IsImplicitMTEnabledImpl();
    }
 
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Call func(i) for i in [0, n), in parallel on the pool of the implicit
+   /// multi-threading if it is enabled, sequentially otherwise. Meant for the
+   /// packages that cannot depend on libImt, e.g. TThreadedObject.
+   void Internal::ParallelFor(UInt_t n, const std::function<void(UInt_t)> &func)
+   {
+#ifdef R__USE_IMT
+      if (n > 1 && ROOT::IsImplicitMTEnabled()) {
+         using ParallelFor_t = void (*)(UInt_t, const std::function<void(UInt_t)> &);
+         static ParallelFor_t sym = (ParallelFor_t)Internal::GetSymInLibImt("ROOT_TImplicitMT_ParallelFor");
+         if (sym) {
+            sym(n, func);
+            return;
+         }
+      }
+#endif
+      for (UInt_t i = 0; i < n; ++i)
+         func(i);
+   }
+
    ////////////////////////////////////////////////////////////////////////////////
    /// Returns the size of the pool used for implicit multi-threading.
    UInt_t GetImplicitMTPoolSize()
@@ -777,7 +797,8 @@ TROOT::TROOT(const char *name, const char *title, VoidFuncPtr_t *initfunc)
    fGlobalFunctions = 0;
    // fList was created in TDirectory::Build but with different sizing.
    delete fList;
-   fList        = new THashList(1000,3); fList->UseRWLock();
+   THashList *list = new THashList(1000,3); list->UseLocalLock();
+   fList        = list;
    fClosedObjects = setNameLocked(new TList, "ClosedFiles");
    fFiles       = setNameLocked(new TList, "Files");
    fMappedFiles = setNameLocked(new TList, "MappedFiles");
@@ -2013,6 +2034,10 @@ void TROOT::InitSystem()
       { TUrl dummy("/dummy"); }
 #endif
       TObject::SetObjectStat(gEnv->GetValue("Root.ObjectStat", 0));
+
+      const char *lockProfile = gEnv->GetValue("Root.LockProfile", "");
+      if (lockProfile && *lockProfile)
+         ROOT::EnableLockProfiling(lockProfile);
    }
 }
 
@@ -2143,6 +2168,9 @@ void TROOT::InitInterpreter()
    // load the libraries for the classes concerned even-though the user is
    // *not* using them.
    TClass::ReadRules(); // Read the default customization rules ...
+
+   if (gEnv->GetValue("Root.StartupReport", 0))
+      fInterpreter->PrintStartupReport();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,14 @@ of local objects so it is exception safe.
 #include "TVirtualMutex.h"
 #include "TVirtualRWMutex.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+
 ClassImp(TVirtualMutex);
 ClassImp(TLockGuard);
 
@@ -46,4 +54,233 @@ TVirtualMutex *gGlobalMutex = 0;
 
 // From TVirtualRWMutex.h:
 ROOT::TVirtualRWMutex::State::~State() = default;
-ROOT::TVirtualRWMutex::StateDelta::~StateDelta() = default;
\ No newline at end of file
+ROOT::TVirtualRWMutex::StateDelta::~StateDelta() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+// Lock profiling
+
+namespace {
+
+/// Statistics of a lock call site, kept in the report once it is destroyed.
+struct LockSiteRecord_t {
+   std::string fFile;
+   int fLine;
+   std::string fMutex;
+   std::string fKind;
+   ULong64_t fCount;
+   ULong64_t fWaitNs;
+   ULong64_t fMaxWaitNs;
+   ULong64_t fHoldNs;
+   ULong64_t fMaxHoldNs;
+};
+
+std::mutex gLockSitesMutex; // protects the two lists below
+std::string gLockProfileFile;
+
+/// The registered lock call sites. The lists are never deleted: at exit, the
+/// sites of the other libraries may be destroyed after the statics of libCore.
+std::vector<ROOT::Internal::TLockSite *> &GetLockSites()
+{
+   static auto sites = new std::vector<ROOT::Internal::TLockSite *>;
+   return *sites;
+}
+
+/// The statistics of the destroyed call sites.
+std::vector<LockSiteRecord_t> &GetRetiredLockSites()
+{
+   static auto records = new std::vector<LockSiteRecord_t>;
+   return *records;
+}
+
+LockSiteRecord_t MakeRecord(const ROOT::Internal::TLockSite &site)
+{
+   return {site.GetFile(),   site.GetLine(),      site.GetMutex(),  site.GetKind(),
+           site.GetCount(),  site.GetWaitNs(),    site.GetMaxWaitNs(),
+           site.GetHoldNs(), site.GetMaxHoldNs()};
+}
+
+void WriteLockProfileAtExit()
+{
+   if (gLockProfileFile.empty())
+      return;
+   if (FILE *fp = fopen(gLockProfileFile.c_str(), "w")) {
+      std::string json = ROOT::GetLockProfile();
+      fwrite(json.data(), 1, json.size(), fp);
+      fclose(fp);
+   }
+}
+
+void AppendJSONString(std::string &out, const char *str)
+{
+   out += '"';
+   for (; str && *str; ++str) {
+      if (*str == '"' || *str == '\\')
+         out += '\\';
+      if ((unsigned char)*str >= 0x20)
+         out += *str;
+   }
+   out += '"';
+}
+
+void UpdateMax(std::atomic<ULong64_t> &max, ULong64_t value)
+{
+   ULong64_t prev = max.load(std::memory_order_relaxed);
+   while (prev < value && !max.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+   }
+}
+
+} // namespace
+
+std::atomic<bool> ROOT::Internal::gLockProfiling{false};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register a lock call site; called once per R__LOCKGUARD, R__READ_LOCKGUARD
+/// or R__WRITE_LOCKGUARD expansion, the first time it is reached. The strings
+/// are copied, they may belong to a library unloaded before the report.
+
+ROOT::Internal::TLockSite::TLockSite(const char *file, int line, const char *mutex, const char *kind)
+   : fFile(file ? file : ""), fLine(line), fMutex(mutex ? mutex : ""), fKind(kind ? kind : "")
+{
+   std::lock_guard<std::mutex> lock(gLockSitesMutex);
+   GetLockSites().push_back(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Unregister the call site, keeping its statistics for the report if it was
+/// reached while profiling.
+
+ROOT::Internal::TLockSite::~TLockSite()
+{
+   std::lock_guard<std::mutex> lock(gLockSitesMutex);
+   auto &sites = GetLockSites();
+   sites.erase(std::remove(sites.begin(), sites.end(), this), sites.end());
+   if (GetCount())
+      GetRetiredLockSites().push_back(MakeRecord(*this));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Account for one acquisition that waited waitNs and held the lock holdNs
+/// nanoseconds.
+
+void ROOT::Internal::TLockSite::Record(ULong64_t waitNs, ULong64_t holdNs)
+{
+   fCount.fetch_add(1, std::memory_order_relaxed);
+   fWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+   fHoldNs.fetch_add(holdNs, std::memory_order_relaxed);
+   UpdateMax(fMaxWaitNs, waitNs);
+   UpdateMax(fMaxHoldNs, holdNs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset the statistics of this call site.
+
+void ROOT::Internal::TLockSite::Reset()
+{
+   fCount = 0;
+   fWaitNs = 0;
+   fMaxWaitNs = 0;
+   fHoldNs = 0;
+   fMaxHoldNs = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a monotonic time stamp in nanoseconds.
+
+ULong64_t ROOT::Internal::TLockSite::Now()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start recording, for each call site of R__LOCKGUARD, R__READ_LOCKGUARD and
+/// R__WRITE_LOCKGUARD (and their variants), the number of acquisitions and the
+/// time spent waiting for and holding the lock. This covers ROOT::gCoreMutex,
+/// gInterpreterMutex, gROOTMutex and all the other locks taken through these
+/// macros. When the profiling is disabled, the cost of a lock guard is one
+/// relaxed atomic load.
+///
+/// If jsonfile is given, the report returned by GetLockProfile() is written
+/// to it at exit. The profiling can also be enabled with the rootrc variable
+/// Root.LockProfile, whose value is the name of the report.
+
+void ROOT::EnableLockProfiling(const char *jsonfile)
+{
+   if (jsonfile && *jsonfile) {
+      static bool registered = false;
+      gLockProfileFile = jsonfile;
+      if (!registered) {
+         registered = true;
+         atexit(WriteLockProfileAtExit);
+      }
+   }
+   Internal::gLockProfiling = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop recording the lock statistics; the ones collected so far are kept.
+
+void ROOT::DisableLockProfiling()
+{
+   Internal::gLockProfiling = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the lock statistics as a JSON document: one entry per call site
+/// that was reached while profiling, sorted by decreasing total wait time.
+/// Times are in nanoseconds.
+/// ~~~ {.json}
+/// {"sites": [
+///   {"file": "TClass.cxx", "line": 2911, "mutex": "ROOT::gCoreMutex", "kind": "write",
+///    "count": 1204, "wait_ns": 8390211, "max_wait_ns": 120450, "hold_ns": 1032977, "max_hold_ns": 50231},
+///   ...
+/// ]}
+/// ~~~
+
+std::string ROOT::GetLockProfile()
+{
+   std::vector<LockSiteRecord_t> sites;
+   {
+      std::lock_guard<std::mutex> lock(gLockSitesMutex);
+      for (auto site : GetLockSites()) {
+         if (site->GetCount())
+            sites.push_back(MakeRecord(*site));
+      }
+      const auto &retired = GetRetiredLockSites();
+      sites.insert(sites.end(), retired.begin(), retired.end());
+   }
+   std::sort(sites.begin(), sites.end(),
+             [](const LockSiteRecord_t &a, const LockSiteRecord_t &b) { return a.fWaitNs > b.fWaitNs; });
+
+   std::string json = "{\"sites\": [";
+   for (size_t i = 0; i < sites.size(); ++i) {
+      const auto &site = sites[i];
+      json += i ? ",\n  {" : "\n  {";
+      json += "\"file\": ";
+      AppendJSONString(json, site.fFile.c_str());
+      json += ", \"line\": " + std::to_string(site.fLine);
+      json += ", \"mutex\": ";
+      AppendJSONString(json, site.fMutex.c_str());
+      json += ", \"kind\": ";
+      AppendJSONString(json, site.fKind.c_str());
+      json += ", \"count\": " + std::to_string(site.fCount);
+      json += ", \"wait_ns\": " + std::to_string(site.fWaitNs);
+      json += ", \"max_wait_ns\": " + std::to_string(site.fMaxWaitNs);
+      json += ", \"hold_ns\": " + std::to_string(site.fHoldNs);
+      json += ", \"max_hold_ns\": " + std::to_string(site.fMaxHoldNs);
+      json += "}";
+   }
+   json += sites.empty() ? "]}\n" : "\n]}\n";
+   return json;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset the statistics of all the call sites.
+
+void ROOT::ResetLockProfile()
+{
+   std::lock_guard<std::mutex> lock(gLockSitesMutex);
+   for (auto site : GetLockSites())
+      site->Reset();
+   GetRetiredLockSites().clear();
+}
@@ -0,0 +1,122 @@
+#include "TObjectPool.h"
+#include "TObjString.h"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+TObjectPool::SizeClassStat_t GetStat(size_t size)
+{
+   return TObjectPool::GetStatistics()[(size - 1) / TObjectPool::kGranularity];
+}
+
+class TPooledHit : public TObject {
+public:
+   Double_t fX = 0;
+   R__USE_OBJECT_POOL
+};
+
+// Too large to be pooled
+class TBigPooledHit : public TPooledHit {
+public:
+   Double_t fData[64];
+};
+
+} // namespace
+
+TEST(TObjectPool, AllocDealloc)
+{
+   const auto before = GetStat(sizeof(TPooledHit));
+   std::vector<TPooledHit *> hits;
+   for (int i = 0; i < 10000; ++i) {
+      hits.push_back(new TPooledHit);
+      hits.back()->fX = i;
+   }
+   for (int i = 0; i < 10000; ++i) {
+      EXPECT_EQ(i, hits[i]->fX);
+      EXPECT_TRUE(hits[i]->IsOnHeap());
+   }
+   for (auto hit : hits)
+      delete hit;
+   const auto after = GetStat(sizeof(TPooledHit));
+   EXPECT_EQ(10000, after.fNAlloc - before.fNAlloc);
+   EXPECT_EQ(10000, after.fNFree - before.fNFree);
+   EXPECT_EQ(0, after.fNRemoteFree - before.fNRemoteFree);
+
+   // The freed blocks are reused
+   auto hit = new TPooledHit;
+   delete hit;
+   auto again = new TPooledHit;
+   EXPECT_EQ(hit, again);
+   delete again;
+
+   // and no arena is needed for a second round
+   for (auto &h : hits)
+      h = new TPooledHit;
+   for (auto h : hits)
+      delete h;
+   EXPECT_EQ(after.fNChunks, GetStat(sizeof(TPooledHit)).fNChunks);
+
+   TPooledHit onStack;
+   EXPECT_FALSE(onStack.IsOnHeap());
+}
+
+TEST(TObjectPool, LargeObjects)
+{
+   const auto before = TObjectPool::GetStatistics();
+   TPooledHit *big = new TBigPooledHit;
+   big->fX = 1;
+   delete big; // sized delete with the size of TBigPooledHit
+   const auto after = TObjectPool::GetStatistics();
+   for (size_t cls = 0; cls < before.size(); ++cls)
+      EXPECT_EQ(before[cls].fNAlloc, after[cls].fNAlloc);
+}
+
+TEST(TObjectPool, CrossThreadFree)
+{
+   const auto before = GetStat(sizeof(TObjString));
+   const int n = 5000;
+   std::vector<TObjString *> strings(n);
+   std::thread producer([&strings]() {
+      for (int i = 0; i < n; ++i)
+         strings[i] = new TObjString(TString::Format("%d", i));
+   });
+   producer.join();
+   for (int i = 0; i < n; ++i) {
+      EXPECT_EQ(TString::Format("%d", i), strings[i]->GetString());
+      delete strings[i];
+   }
+   const auto after = GetStat(sizeof(TObjString));
+   EXPECT_EQ(n, after.fNAlloc - before.fNAlloc);
+   EXPECT_EQ(n, after.fNRemoteFree - before.fNRemoteFree);
+
+   // A new thread takes over the heap of the exited one and reuses its blocks
+   const Long64_t nheaps = TObjectPool::GetNHeaps();
+   std::thread consumer([]() {
+      std::vector<TObjString *> local;
+      for (int i = 0; i < n; ++i)
+         local.push_back(new TObjString("x"));
+      for (auto str : local)
+         delete str;
+   });
+   consumer.join();
+   EXPECT_EQ(nheaps, TObjectPool::GetNHeaps());
+   EXPECT_EQ(after.fNChunks, GetStat(sizeof(TObjString)).fNChunks);
+}
+
+TEST(TObjectPool, DtorOnly)
+{
+   auto str = new TObjString("abc");
+   const auto before = GetStat(sizeof(TObjString));
+   TObject::SetDtorOnly(str);
+   delete str;
+   EXPECT_EQ(before.fNFree, GetStat(sizeof(TObjString)).fNFree);
+   EXPECT_EQ(0, TObject::GetDtorOnly());
+   // Construct it again in place, then release it for good
+   new (str) TObjString("def");
+   delete str;
+   EXPECT_EQ(before.fNFree + 1, GetStat(sizeof(TObjString)).fNFree);
+}
@@ -31,6 +31,7 @@
 #include "TVirtualRWMutex.h"
 
 #include <assert.h>
+#include <mutex>
 
 class TClass;
 class TObjectTable;
@@ -141,7 +142,8 @@ protected:
    enum EStatusBits {
       kIsOwner   = BIT(14),
       // BIT(15) is used by TClonesArray and TMap
-      kUseRWLock = BIT(16)
+      kUseRWLock = BIT(16),
+      kUseLocalLock = BIT(17)
    };
 
    TString   fName;               //name of the collection
@@ -208,6 +210,8 @@ public:
    virtual Int_t      Write(const char *name=0, Int_t option=0, Int_t bufsize=0) const;
 
    R__ALWAYS_INLINE Bool_t IsUsingRWLock() const { return TestBit(TCollection::kUseRWLock); }
+   R__ALWAYS_INLINE Bool_t IsUsingLocalLock() const { return TestBit(TCollection::kUseLocalLock); }
+   virtual std::recursive_mutex *GetLocalLock() const { return nullptr; }
 
    static TCollection  *GetCurrentCollection();
    static void          StartGarbageCollection();
@@ -419,16 +423,120 @@ public:
    ROOT::Internal::TRangeDynCastIterator<T> end() const { return fCollection.end(); }
 };
 
+namespace ROOT {
+namespace Internal {
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TCollectionLockGuard                                                 //
+//                                                                      //
+// Lock guard of the collections using a RW lock (see UseRWLock()).     //
+// For the collections that also have their own lock (see               //
+// THashList::UseLocalLock()), the reads and the insertions and         //
+// removals that do not call out to other objects (kLocalWrite) only    //
+// take the global lock for reading and serialize on the lock of the    //
+// collection, so that threads filling different collections do not    //
+// contend. The other writes still take the global lock for writing.    //
+// kLocal takes only the lock of the collection, if it has one: it is   //
+// for the callers already holding the global lock for reading, e.g.    //
+// RecursiveRemove(), which must not hold it while calling out.         //
+// The lock of a collection is never held while calling out to the      //
+// contained objects (Hash(), IsEqual(), GetName(), ...): they may need //
+// the global lock for writing (e.g. TClass::SetRuntimeProperties()),   //
+// which another thread holding it for reading and waiting for the lock //
+// of the collection would prevent. The reads calling out (kCallOut)    //
+// take the global lock for writing instead when the collection has its //
+// own lock.                                                            //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+class TCollectionLockGuard {
+public:
+   enum EAccess { kRead, kWrite, kLocalWrite, kLocal, kCallOut };
+
+private:
+   TVirtualRWMutex *fMutex = nullptr;
+   TVirtualRWMutex::Hint_t *fHint = nullptr;
+   std::recursive_mutex *fLocalLock = nullptr;
+   bool fWrite = false;
+   TLockProbe fProbe; //! Profiling of the acquisition
+
+   TCollectionLockGuard(const TCollectionLockGuard&) = delete;
+   TCollectionLockGuard& operator=(const TCollectionLockGuard&) = delete;
+
+public:
+   TCollectionLockGuard(const TCollection *collection, TVirtualRWMutex *mutex, EAccess access,
+                        TLockSite *site = nullptr)
+   {
+      if (!mutex || !collection->IsUsingRWLock())
+         return;
+      if (access == kLocal) {
+         if (collection->IsUsingLocalLock()) {
+            fProbe.Start(site);
+            fLocalLock = collection->GetLocalLock();
+            fLocalLock->lock();
+            fProbe.Acquired();
+         }
+         return;
+      }
+      if (access == kCallOut)
+         access = collection->IsUsingLocalLock() ? kWrite : kRead;
+      fMutex = mutex;
+      fProbe.Start(site);
+      if (access != kWrite && collection->IsUsingLocalLock()) {
+         fHint = fMutex->ReadLock();
+         fLocalLock = collection->GetLocalLock();
+         fLocalLock->lock();
+      } else if (access == kRead) {
+         fHint = fMutex->ReadLock();
+      } else {
+         fWrite = true;
+         fHint = fMutex->WriteLock();
+      }
+      fProbe.Acquired();
+   }
+
+   ~TCollectionLockGuard()
+   {
+      if (fLocalLock)
+         fLocalLock->unlock();
+      if (fMutex) {
+         if (fWrite)
+            fMutex->WriteUnLock(fHint);
+         else
+            fMutex->ReadUnLock(fHint);
+      }
+      fProbe.Released();
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
 // Zero overhead macros in case not compiled with thread support
 #if defined (_REENTRANT) || defined (WIN32)
 
 #define R__COLL_COND_MUTEX(mutex) this->IsUsingRWLock() ? mutex : nullptr
 
-#define R__COLLECTION_READ_LOCKGUARD(mutex) ::ROOT::TReadLockGuard _R__UNIQUE_(R__readguard)(R__COLL_COND_MUTEX(mutex))
-#define R__COLLECTION_READ_LOCKGUARD_NAMED(name,mutex) ::ROOT::TReadLockGuard _NAME2_(R__readguard,name)(R__COLL_COND_MUTEX(mutex))
+#define R__COLLECTION_LOCKGUARD_IMPL(name,mutex,access,kind) \
+   R__LOCKSITE(mutex, kind);                                   \
+   ::ROOT::Internal::TCollectionLockGuard name(this, mutex, ::ROOT::Internal::TCollectionLockGuard::access, \
+                                               &_R__UNIQUE_(R__locksite))
+
+#define R__COLLECTION_READ_LOCKGUARD(mutex) R__COLLECTION_LOCKGUARD_IMPL(_R__UNIQUE_(R__readguard),mutex,kRead,"read")
+#define R__COLLECTION_READ_LOCKGUARD_NAMED(name,mutex) R__COLLECTION_LOCKGUARD_IMPL(_NAME2_(R__readguard,name),mutex,kRead,"read")
 
-#define R__COLLECTION_WRITE_LOCKGUARD(mutex) ::ROOT::TWriteLockGuard _R__UNIQUE_(R__readguard)(R__COLL_COND_MUTEX(mutex))
-#define R__COLLECTION_WRITE_LOCKGUARD_NAMED(name,mutex) ::ROOT::TWriteLockGuard _NAME2_(R__readguard,name)(R__COLL_COND_MUTEX(mutex))
+#define R__COLLECTION_WRITE_LOCKGUARD(mutex) R__COLLECTION_LOCKGUARD_IMPL(_R__UNIQUE_(R__readguard),mutex,kWrite,"write")
+#define R__COLLECTION_WRITE_LOCKGUARD_NAMED(name,mutex) R__COLLECTION_LOCKGUARD_IMPL(_NAME2_(R__readguard,name),mutex,kWrite,"write")
+
+// For the insertions and removals that do not call out to the contained objects.
+#define R__COLLECTION_LOCAL_WRITE_LOCKGUARD(mutex) R__COLLECTION_LOCKGUARD_IMPL(_R__UNIQUE_(R__readguard),mutex,kLocalWrite,"local write")
+
+// For the accesses to the links under a lock of mutex already held for reading.
+#define R__COLLECTION_LOCAL_LOCKGUARD(mutex) R__COLLECTION_LOCKGUARD_IMPL(_R__UNIQUE_(R__readguard),mutex,kLocal,"local")
+
+// For the reads that call out to the contained objects.
+#define R__COLLECTION_CALLOUT_LOCKGUARD(mutex) R__COLLECTION_LOCKGUARD_IMPL(_R__UNIQUE_(R__readguard),mutex,kCallOut,"callout")
 
 #else
 
@@ -438,6 +546,10 @@ public:
 #define R__COLLECTION_WRITE_LOCKGUARD(mutex) (void)mutex
 #define R__COLLECTION_WRITE_LOCKGUARD_NAMED(name,mutex) (void)mutex
 
+#define R__COLLECTION_LOCAL_WRITE_LOCKGUARD(mutex) (void)mutex
+#define R__COLLECTION_LOCAL_LOCKGUARD(mutex) (void)mutex
+#define R__COLLECTION_CALLOUT_LOCKGUARD(mutex) (void)mutex
+
 #endif
 
 //---- R__FOR_EACH macro -------------------------------------------------------
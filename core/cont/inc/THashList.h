@@ -28,6 +28,9 @@
 
 #include "TList.h"
 
+#include <memory>
+#include <vector>
+
 class THashTable;
 
 
@@ -35,11 +38,15 @@ class THashList : public TList {
 
 protected:
    THashTable   *fTable;    //Hashtable used for quick lookup of objects
+   std::unique_ptr<std::recursive_mutex> fLocalLock; //! Lock of the lookups, insertions and removals, see UseLocalLock()
 
 private:
    THashList(const THashList&);              // not implemented
    THashList& operator=(const THashList&);   // not implemented
 
+   TObject   *FindInTable(const TObject *obj) const;
+   void       GetCandidates(ULong_t hash, std::vector<TObject *> &candidates) const;
+
 public:
    THashList(Int_t capacity=TCollection::kInitHashTableCapacity, Int_t rehash=0);
    THashList(TObject *parent, Int_t capacity=TCollection::kInitHashTableCapacity, Int_t rehash=0);
@@ -68,6 +75,8 @@ public:
    TObject   *Remove(TObject *obj);
    TObject   *Remove(TObjLink *lnk);
    bool       UseRWLock();
+   bool       UseLocalLock();
+   std::recursive_mutex *GetLocalLock() const { return fLocalLock.get(); }
 
    ClassDef(THashList,0)  //Doubly linked list with hashtable for lookup
 };
@@ -35,6 +35,7 @@ class THashTableIter;
 class THashTable : public TCollection {
 
 friend class  THashTableIter;
+friend class  THashList;
 
 private:
    TList     **fCont;          //Hash table (table of lists)
@@ -49,6 +50,11 @@ private:
 
    void        AddImpl(Int_t slot, TObject *object);
 
+   // For THashList, which computes the hash values outside of its lock.
+   Int_t       AddWithHash(TObject *obj, ULong_t hash);
+   TObject    *RemoveIdentical(TObject *obj, ULong_t hash);
+   const TList *GetBucket(ULong_t hash) const { return fCont[hash % fSize]; }
+
    THashTable(const THashTable&);             // not implemented
    THashTable& operator=(const THashTable&);  // not implemented
 
@@ -634,6 +634,9 @@ TProtoClass *TClassTable::GetProto(const char *cname)
    }
 
    TClassRec *r = FindElement(cname);
+   // In lazy mode, the PCM describing the class may not be loaded yet.
+   if ((!r || !r->fProto) && gCling && gCling->LoadPendingPCMs(cname))
+      r = FindElement(cname);
    if (r) return r->fProto;
    return 0;
 }
@@ -655,6 +658,9 @@ TProtoClass *TClassTable::GetProtoNorm(const char *cname)
    }
 
    TClassRec *r = FindElementImpl(cname,kFALSE);
+   // In lazy mode, the PCM describing the class may not be loaded yet.
+   if ((!r || !r->fProto) && gCling && gCling->LoadPendingPCMs(cname))
+      r = FindElementImpl(cname,kFALSE);
    if (r) return r->fProto;
    return 0;
 }
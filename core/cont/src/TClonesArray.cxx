@@ -154,18 +154,21 @@ bool R__SetClonesArrayTFormulaUpdater(Updater_t func) {
 /// Internal Utility routine to correctly release the memory for an object
 static inline void R__ReleaseMemory(TClass *cl, TObject *obj)
 {
-   if (obj && obj->TestBit(TObject::kNotDeleted)) {
-      // -- The TObject destructor has not been called.
-      cl->Destructor(obj);
-   } else {
-      // -- The TObject destructor was called, just free memory.
-      //
-      // remove any possible entries from the ObjectTable
-      if (TObject::GetObjectStat() && gObjectTable) {
-         gObjectTable->RemoveQuietly(obj);
-      }
-      ::operator delete(obj);
+   if (!obj)
+      return;
+   if (obj->TestBit(TObject::kNotDeleted)) {
+      // -- The TObject destructor has not been called. Only call it: the memory
+      // comes from TStorage::ObjectAlloc, not from the operator new of the class
+      // (which may be pooled, see TObjectPool).
+      cl->Destructor(obj, kTRUE);
+   }
+   // -- The TObject destructor was called, just free memory.
+   //
+   // remove any possible entries from the ObjectTable
+   if (TObject::GetObjectStat() && gObjectTable) {
+      gObjectTable->RemoveQuietly(obj);
    }
+   ::operator delete(obj);
 }
 
 
@@ -22,6 +22,9 @@ can override Hash() as it sees fit.
 #include "THashList.h"
 #include "THashTable.h"
 #include "TClass.h"
+#include "TVirtualRWMutex.h"
+
+#include <cstring>
 
 
 ClassImp(THashList);
@@ -68,10 +71,17 @@ THashList::~THashList()
 
 void THashList::AddFirst(TObject *obj)
 {
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
-
-   TList::AddFirst(obj);
-   fTable->Add(obj);
+   // Hash outside of the lock of the list, see UseLocalLock().
+   const ULong_t hash = obj ? obj->CheckedHash() : 0;
+   Int_t rehash;
+   {
+      R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+
+      TList::AddFirst(obj);
+      rehash = fTable->AddWithHash(obj, hash);
+   }
+   if (rehash)
+      Rehash(rehash);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -83,10 +93,17 @@ void THashList::AddFirst(TObject *obj)
 
 void THashList::AddFirst(TObject *obj, Option_t *opt)
 {
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
-
-   TList::AddFirst(obj, opt);
-   fTable->Add(obj);
+   // Hash outside of the lock of the list, see UseLocalLock().
+   const ULong_t hash = obj ? obj->CheckedHash() : 0;
+   Int_t rehash;
+   {
+      R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+
+      TList::AddFirst(obj, opt);
+      rehash = fTable->AddWithHash(obj, hash);
+   }
+   if (rehash)
+      Rehash(rehash);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -94,10 +111,17 @@ void THashList::AddFirst(TObject *obj, Option_t *opt)
 
 void THashList::AddLast(TObject *obj)
 {
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
-
-   TList::AddLast(obj);
-   fTable->Add(obj);
+   // Hash outside of the lock of the list, see UseLocalLock().
+   const ULong_t hash = obj ? obj->CheckedHash() : 0;
+   Int_t rehash;
+   {
+      R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+
+      TList::AddLast(obj);
+      rehash = fTable->AddWithHash(obj, hash);
+   }
+   if (rehash)
+      Rehash(rehash);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -109,10 +133,17 @@ void THashList::AddLast(TObject *obj)
 
 void THashList::AddLast(TObject *obj, Option_t *opt)
 {
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
-
-   TList::AddLast(obj, opt);
-   fTable->Add(obj);
+   // Hash outside of the lock of the list, see UseLocalLock().
+   const ULong_t hash = obj ? obj->CheckedHash() : 0;
+   Int_t rehash;
+   {
+      R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+
+      TList::AddLast(obj, opt);
+      rehash = fTable->AddWithHash(obj, hash);
+   }
+   if (rehash)
+      Rehash(rehash);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -261,9 +292,24 @@ void THashList::Delete(Option_t *option)
 
 TObject *THashList::FindObject(const char *name) const
 {
-   R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
+   if (!IsUsingLocalLock()) {
+      R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
-   return fTable->FindObject(name);
+      return fTable->FindObject(name);
+   }
+
+   if (!name) return nullptr;
+
+   // Compare the names outside of the lock of the list, see UseLocalLock().
+   R__READ_LOCKGUARD(ROOT::gCoreMutex);
+   std::vector<TObject *> candidates;
+   GetCandidates(::Hash(name), candidates);
+   for (TObject *obj : candidates) {
+      const char *objname = obj->GetName();
+      if (objname && strcmp(name, objname) == 0)
+         return obj;
+   }
+   return nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -271,9 +317,23 @@ TObject *THashList::FindObject(const char *name) const
 
 TObject *THashList::FindObject(const TObject *obj) const
 {
-   R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
+   if (!IsUsingLocalLock()) {
+      R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
+
+      return fTable->FindObject(obj);
+   }
+
+   if (!obj) return nullptr;
 
-   return fTable->FindObject(obj);
+   // Compare the objects outside of the lock of the list, see UseLocalLock().
+   R__READ_LOCKGUARD(ROOT::gCoreMutex);
+   std::vector<TObject *> candidates;
+   GetCandidates(obj->Hash(), candidates);
+   for (TObject *ob : candidates) {
+      if (ob->IsEqual(obj))
+         return ob;
+   }
+   return nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -325,7 +385,7 @@ void THashList::RecursiveRemove(TObject *obj)
       if (object)
          fTable->RemoveSlow(object);
 
-   } else if (fTable->FindObject(obj)) {
+   } else if (FindInTable(obj)) {
       R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
       // Remove obj in the list itself
@@ -345,11 +405,22 @@ void THashList::RecursiveRemove(TObject *obj)
    // another thread can modify the list; thanks to the shared_pointer
    // forward-and-backward links, our view of the list is still intact
    // but might contains node will nullptr payload)
-   auto lnk  = fFirst;
+   // The insertions and removals do not take the write lock when the list
+   // has its own lock: the links are read under it, but it is not held
+   // while calling out to the objects.
+   decltype(fFirst) lnk;
+   {
+      R__COLLECTION_LOCAL_LOCKGUARD(ROOT::gCoreMutex);
+      lnk = fFirst;
+   }
    decltype(lnk) next;
    while (lnk.get()) {
-      next = lnk->NextSP();
-      TObject *ob = lnk->GetObject();
+      TObject *ob;
+      {
+         R__COLLECTION_LOCAL_LOCKGUARD(ROOT::gCoreMutex);
+         next = lnk->NextSP();
+         ob = lnk->GetObject();
+      }
       if (ob && ob->TestBit(kNotDeleted)) {
          ob->RecursiveRemove(obj);
       }
@@ -377,10 +448,34 @@ void THashList::Rehash(Int_t newCapacity)
 
 TObject *THashList::Remove(TObject *obj)
 {
+   if (!obj) return 0;
+
+   if (IsUsingLocalLock()) {
+      // Remove obj itself without calling out to the contained objects under
+      // the lock of the list, see UseLocalLock().
+      const ULong_t hash = obj->Hash();
+      {
+         R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+         for (TObjLink *lnk = FirstLink(); lnk; lnk = lnk->Next()) {
+            if (lnk->GetObject() == obj) {
+               TList::Remove(lnk);
+               fTable->RemoveIdentical(obj, hash);
+               return obj;
+            }
+         }
+      }
+      // Otherwise look for an object equal to obj, excluding all the other
+      // accesses to the list.
+      R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+      if (!fTable->FindObject(obj)) return 0;
+      TList::Remove(obj);
+      return fTable->Remove(obj);
+   }
+
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
    if (!obj || !fTable->FindObject(obj)) return 0;
 
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
    TList::Remove(obj);
    return fTable->Remove(obj);
 }
@@ -392,7 +487,18 @@ TObject *THashList::Remove(TObjLink *lnk)
 {
    if (!lnk) return 0;
 
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   if (IsUsingLocalLock()) {
+      // Hash outside of the lock of the list, see UseLocalLock().
+      TObject *obj = lnk->GetObject();
+      const ULong_t hash = obj ? obj->Hash() : 0;
+
+      R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+      if (lnk->GetObject() != obj) return 0; // Removed by another thread.
+      TList::Remove(lnk);
+      return obj ? fTable->RemoveIdentical(obj, hash) : nullptr;
+   }
+
+   R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
    TObject *obj = lnk->GetObject();
 
    TList::Remove(lnk);
@@ -408,6 +514,70 @@ TObject *THashList::Remove(TObjLink *lnk)
 
 bool THashList::UseRWLock()
 {
-   fTable->UseRWLock();
+   if (!IsUsingLocalLock())
+      fTable->UseRWLock();
+   return TCollection::UseRWLock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set this collection to use a RW lock upon access (see UseRWLock()) and
+/// its own lock. The lookups, insertions and removals then take
+/// ROOT::gCoreMutex only for reading and serialize on the lock of this
+/// list, so that threads filling different lists do not contend. The other
+/// operations (Clear(), Delete(), AddAt(), ...) still take ROOT::gCoreMutex
+/// for writing.
+///
+/// The lock of the list is never held while calling out to the contained
+/// objects: Hash() and CheckedHash() may need ROOT::gCoreMutex for writing
+/// (e.g. for the first object of a class, see TClass::SetRuntimeProperties()),
+/// which another thread holding it for reading and waiting for the lock of
+/// the list would prevent. The hash values are thus computed before taking
+/// the lock, the removals look for the object itself (falling back to an
+/// IsEqual() lookup under the write lock) and the lookups compare the
+/// candidates of the bucket outside of the lock.
+/// Must be called before the list is shared between threads.
+/// Return the previous state of the RW lock usage.
+
+bool THashList::UseLocalLock()
+{
+   if (!fLocalLock)
+      fLocalLock.reset(new std::recursive_mutex);
+   SetBit(TCollection::kUseLocalLock);
+   // The hash table is only accessed under the locks of the list.
+   fTable->ResetBit(TCollection::kUseRWLock);
    return TCollection::UseRWLock();
-}
\ No newline at end of file
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Look up obj in the hash table. RecursiveRemove() relies on the caller
+/// holding ROOT::gCoreMutex, which does not exclude the insertions when the
+/// list uses its own lock: obj itself is then looked up under the lock of
+/// the list, without calling out to the contained objects.
+
+TObject *THashList::FindInTable(const TObject *obj) const
+{
+   if (!IsUsingLocalLock())
+      return fTable->FindObject(obj);
+   const ULong_t hash = obj->Hash();
+   std::lock_guard<std::recursive_mutex> lock(*fLocalLock);
+   if (const TList *bucket = fTable->GetBucket(hash)) {
+      for (TObjLink *lnk = bucket->FirstLink(); lnk; lnk = lnk->Next())
+         if (lnk->GetObject() == obj)
+            return lnk->GetObject();
+   }
+   return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the objects of the hash table's bucket of the given hash value into
+/// candidates, under the lock of the list.
+
+void THashList::GetCandidates(ULong_t hash, std::vector<TObject *> &candidates) const
+{
+   std::lock_guard<std::recursive_mutex> lock(*fLocalLock);
+   if (const TList *bucket = fTable->GetBucket(hash)) {
+      candidates.reserve(bucket->GetSize());
+      for (TObjLink *lnk = bucket->FirstLink(); lnk; lnk = lnk->Next())
+         candidates.push_back(lnk->GetObject());
+   }
+}
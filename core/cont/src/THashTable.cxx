@@ -103,6 +103,22 @@ void THashTable::Add(TObject *obj)
       Rehash(fEntries);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add object to the hash table given the value returned by its CheckedHash()
+/// function. Unlike Add(), does not rehash the table: returns the new capacity
+/// to pass to Rehash() when needed, 0 otherwise. The caller holds the locks.
+
+Int_t THashTable::AddWithHash(TObject *obj, ULong_t hash)
+{
+   if (IsArgNull("Add", obj)) return 0;
+
+   AddImpl(Int_t(hash % fSize), obj);
+
+   if (fRehashLevel && AverageCollisions() > fRehashLevel)
+      return fEntries;
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add object to the hash table. Its position in the table will be
 /// determined by the value returned by its Hash() function.
@@ -433,6 +449,30 @@ TObject *THashTable::Remove(TObject *obj)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Remove obj itself, not an object equal to it, from the hashtable given
+/// the value returned by its Hash() function. Does not call any function
+/// of the contained objects. The caller holds the locks.
+
+TObject *THashTable::RemoveIdentical(TObject *obj, ULong_t hash)
+{
+   Int_t slot = Int_t(hash % fSize);
+   if (!fCont[slot]) return 0;
+
+   for (TObjLink *lnk = fCont[slot]->FirstLink(); lnk; lnk = lnk->Next()) {
+      if (lnk->GetObject() == obj) {
+         fCont[slot]->Remove(lnk);
+         fEntries--;
+         if (fCont[slot]->GetSize() == 0) {
+            SafeDelete(fCont[slot]);
+            fUsedSlots--;
+         }
+         return obj;
+      }
+   }
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Remove object from the hashtable without using the hash value.
 
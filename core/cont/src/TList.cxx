@@ -100,7 +100,7 @@ void TList::AddFirst(TObject *obj)
 
    if (IsArgNull("AddFirst", obj)) return;
 
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
    if (!fFirst) {
       fFirst = NewLink(obj);
@@ -128,7 +128,7 @@ void TList::AddFirst(TObject *obj, Option_t *opt)
 
    if (IsArgNull("AddFirst", obj)) return;
 
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
    if (!fFirst) {
       fFirst = NewOptLink(obj, opt);
@@ -152,7 +152,7 @@ void TList::AddLast(TObject *obj)
 
    if (IsArgNull("AddLast", obj)) return;
 
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
    if (!fFirst) {
       fFirst = NewLink(obj);
@@ -176,7 +176,7 @@ void TList::AddLast(TObject *obj, Option_t *opt)
 
    if (IsArgNull("AddLast", obj)) return;
 
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
    if (!fFirst) {
       fFirst = NewOptLink(obj, opt);
@@ -579,7 +579,7 @@ TObject *TList::FindObject(const char *name) const
    if (!name)
       return nullptr;
 
-   R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
+   R__COLLECTION_CALLOUT_LOCKGUARD(ROOT::gCoreMutex);
 
    for (TObjLink *lnk = FirstLink(); lnk != nullptr; lnk = lnk->Next()) {
       if (TObject *obj = lnk->GetObject()) {
@@ -606,7 +606,7 @@ TObject *TList::FindObject(const TObject *obj) const
    if (!obj)
       return nullptr;
 
-   R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
+   R__COLLECTION_CALLOUT_LOCKGUARD(ROOT::gCoreMutex);
 
    TObjLink *lnk = FirstLink();
 
@@ -629,7 +629,7 @@ TObjLink *TList::FindLink(const TObject *obj, Int_t &idx) const
    if (!obj)
       return nullptr;
 
-   R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
+   R__COLLECTION_CALLOUT_LOCKGUARD(ROOT::gCoreMutex);
 
    if (!fFirst) return 0;
 
@@ -672,7 +672,7 @@ TObject **TList::GetObjectRef(const TObject *obj) const
    if (!obj)
    return nullptr;
 
-   R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
+   R__COLLECTION_CALLOUT_LOCKGUARD(ROOT::gCoreMutex);
 
    TObjLink *lnk = FirstLink();
 
@@ -729,7 +729,7 @@ TIterator *TList::MakeIterator(Bool_t dir) const
 
 TList::TObjLinkPtr_t TList::NewLink(TObject *obj, const TObjLinkPtr_t &prev)
 {
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
    R__COLLECTION_WRITE_GUARD();
 
    auto newlink = std::make_shared<TObjLink>(obj);
@@ -744,7 +744,7 @@ TList::TObjLinkPtr_t TList::NewLink(TObject *obj, const TObjLinkPtr_t &prev)
 
 TList::TObjLinkPtr_t TList::NewOptLink(TObject *obj, Option_t *opt, const TObjLinkPtr_t &prev)
 {
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
    R__COLLECTION_WRITE_GUARD();
 
    auto newlink = std::make_shared<TObjOptLink>(obj, opt);
@@ -764,50 +764,69 @@ void TList::RecursiveRemove(TObject *obj)
 
    if (!obj) return;
 
+   // The insertions and removals do not take the write lock when the list
+   // has its own lock (see THashList::UseLocalLock()): the links are read
+   // and modified under it, but it is not held while calling out to the
+   // objects.
+
    // When fCache is set and has no previous and next node, it represents
    // the node being cleared and/or deleted.
    {
-      auto cached = fCache.lock();
-      if (cached && cached->fNext.get() == nullptr && cached->fPrev.lock().get() == nullptr) {
-         TObject *ob = cached->GetObject();
-         if (ob && ob->TestBit(kNotDeleted)) {
-            ob->RecursiveRemove(obj);
-         }
+      TObject *ob = nullptr;
+      {
+         R__COLLECTION_LOCAL_LOCKGUARD(ROOT::gCoreMutex);
+         auto cached = fCache.lock();
+         if (cached && cached->fNext.get() == nullptr && cached->fPrev.lock().get() == nullptr)
+            ob = cached->GetObject();
+      }
+      if (ob && ob->TestBit(kNotDeleted)) {
+         ob->RecursiveRemove(obj);
       }
    }
 
-   if (!fFirst.get())
-      return;
-
-   auto lnk  = fFirst;
+   decltype(fFirst) lnk;
+   {
+      R__COLLECTION_LOCAL_LOCKGUARD(ROOT::gCoreMutex);
+      lnk = fFirst;
+   }
    decltype(lnk) next;
    while (lnk.get()) {
-      next = lnk->fNext;
-      TObject *ob = lnk->GetObject();
+      TObject *ob;
+      {
+         R__COLLECTION_LOCAL_LOCKGUARD(ROOT::gCoreMutex);
+         next = lnk->fNext;
+         ob = lnk->GetObject();
+      }
       if (ob && ob->TestBit(kNotDeleted)) {
          if (ob->IsEqual(obj)) {
-            lnk->SetObject(nullptr);
-            if (lnk == fFirst) {
-               fFirst = next;
-               if (lnk == fLast)
-                  fLast = fFirst;
-               else
-                  fFirst->fPrev.reset();
-               // DeleteLink(lnk);
-            } else if (lnk == fLast) {
-               fLast = lnk->fPrev.lock();
-               fLast->fNext.reset();
-               // DeleteLink(lnk);
-            } else {
-               lnk->Prev()->fNext = next;
-               lnk->Next()->fPrev = lnk->fPrev;
-               // DeleteLink(lnk);
+            R__COLLECTION_LOCAL_LOCKGUARD(ROOT::gCoreMutex);
+            // Unless another thread removed it in the meantime.
+            if (lnk->GetObject() == ob) {
+               next = lnk->fNext;
+               lnk->SetObject(nullptr);
+               if (lnk == fFirst) {
+                  fFirst = next;
+                  if (lnk == fLast)
+                     fLast = fFirst;
+                  else
+                     fFirst->fPrev.reset();
+                  // DeleteLink(lnk);
+               } else if (lnk == fLast) {
+                  fLast = lnk->fPrev.lock();
+                  fLast->fNext.reset();
+                  // DeleteLink(lnk);
+               } else {
+                  lnk->Prev()->fNext = next;
+                  lnk->Next()->fPrev = lnk->fPrev;
+                  // DeleteLink(lnk);
+               }
+               fSize--;
+               fCache.reset();
+               Changed();
             }
-            fSize--;
-            fCache.reset();
-            Changed();
-         } else
+         } else {
             ob->RecursiveRemove(obj);
+         }
       }
       lnk = next;
    }
@@ -822,6 +841,10 @@ TObject *TList::Remove(TObject *obj)
 
    if (!obj) return 0;
 
+   // The link must not be removed by another thread between the lookup
+   // and the removal.
+   R__COLLECTION_CALLOUT_LOCKGUARD(ROOT::gCoreMutex);
+
    Int_t    idx;
    TObjLink *lnk = FindLink(obj, idx);
 
@@ -830,7 +853,7 @@ TObject *TList::Remove(TObject *obj)
    // return object found, which may be (pointer wise) different than the
    // input object (depending on what IsEqual() is doing)
 
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
    TObject *ob = lnk->GetObject();
    lnk->SetObject(nullptr);
@@ -870,7 +893,7 @@ TObject *TList::Remove(TObjLink *lnk)
 
    if (!lnk) return 0;
 
-   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   R__COLLECTION_LOCAL_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
    TObject *obj = lnk->GetObject();
    lnk->SetObject(nullptr);
@@ -0,0 +1,321 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TParallelAlgorithms
+#define ROOT_TParallelAlgorithms
+
+#include "RConfigure.h"
+
+// exclude in case ROOT does not have IMT support
+#ifndef R__USE_IMT
+// No need to error out for dictionaries.
+# if !defined(__ROOTCLING__) && !defined(G__DICTIONARY)
+#  error "Cannot use ROOT::Parallel algorithms without defining R__USE_IMT."
+# endif
+#else
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////
+///
+/// \namespace ROOT::Parallel
+/// \ingroup Parallelism
+/// \brief Parallel versions of the STL algorithms, run on the ROOT thread pool.
+///
+/// The algorithms run on the implicit multi-threading pool if it is enabled,
+/// otherwise on a pool with as many threads as cores, like
+/// ROOT::TThreadExecutor. They are isolated from the outer tasks in the same
+/// way (see TThreadExecutor.cxx). Short ranges are processed sequentially.
+///
+/// * For(begin, end, func, grainSize): func(i) for each i in [begin, end)
+/// * ForRange(begin, end, func, grainSize): func(b, e) on sub-ranges of [begin, end)
+///   of at least grainSize indices, e.g. to keep per thread accumulators
+/// * Sort, StableSort: like std::sort and std::stable_sort
+/// * InclusiveScan, ExclusiveScan: prefix sums, like std::partial_sum; op must be associative
+/// * Partition: like std::stable_partition
+///
+/// The iterators must be random access iterators.
+///
+/// #### Example:
+/// ~~~{.cpp}
+/// std::vector<double> v = ...;
+/// ROOT::Parallel::Sort(v.begin(), v.end());
+/// std::vector<Long64_t> offsets(sizes.size());
+/// ROOT::Parallel::ExclusiveScan(sizes.begin(), sizes.end(), offsets.begin(), 0LL);
+/// ~~~
+///
+//////////////////////////////////////////////////////////////////////////
+
+namespace ROOT {
+namespace Internal {
+void ParallelForRange(std::size_t begin, std::size_t end, std::size_t grainSize,
+                      const std::function<void(std::size_t, std::size_t)> &func);
+unsigned GetParallelAlgorithmsPoolSize();
+} // namespace Internal
+
+namespace Parallel {
+
+namespace Detail {
+/// Ranges shorter than this are sorted, scanned or partitioned sequentially.
+const std::size_t kMinChunkSize = 1 << 14;
+
+/// Boundaries of the chunks in which n elements are split: about four per
+/// thread of the pool, each of at least kMinChunkSize elements.
+inline std::vector<std::size_t> Chunks(std::size_t n)
+{
+   std::size_t nChunks = std::min<std::size_t>(4 * ROOT::Internal::GetParallelAlgorithmsPoolSize(), n / kMinChunkSize);
+   nChunks = std::max<std::size_t>(nChunks, 1);
+   std::vector<std::size_t> bounds(nChunks + 1);
+   for (std::size_t i = 0; i <= nChunks; ++i)
+      bounds[i] = n * i / nChunks;
+   return bounds;
+}
+
+/// Combine the adjacent chunks as a binary tree: at each level, chunk i
+/// absorbs chunk i + step for all the i multiple of 2 * step, in parallel.
+/// combine(lo, mid, hi) is called with the chunk indices.
+template <class COMBINE>
+void TreeCombine(std::size_t nChunks, COMBINE combine)
+{
+   for (std::size_t step = 1; step < nChunks; step *= 2) {
+      ROOT::Internal::ParallelForRange(0, (nChunks + step - 1) / (2 * step), 1,
+                                       [&combine, step, nChunks](std::size_t b, std::size_t e) {
+                                          for (std::size_t k = b; k < e; ++k) {
+                                             const std::size_t lo = 2 * step * k;
+                                             combine(lo, lo + step, std::min(lo + 2 * step, nChunks));
+                                          }
+                                       });
+   }
+}
+
+/// Sort the chunks with sortChunk in parallel, then merge them pairwise.
+template <class RandomIt, class Compare, class SORT>
+void MergeSort(RandomIt first, RandomIt last, Compare comp, SORT sortChunk)
+{
+   const auto bounds = Chunks(last - first);
+   const std::size_t nChunks = bounds.size() - 1;
+   if (nChunks < 2) {
+      sortChunk(first, last);
+      return;
+   }
+   ROOT::Internal::ParallelForRange(0, nChunks, 1, [&](std::size_t b, std::size_t e) {
+      for (std::size_t i = b; i < e; ++i)
+         sortChunk(first + bounds[i], first + bounds[i + 1]);
+   });
+   TreeCombine(nChunks, [&](std::size_t lo, std::size_t mid, std::size_t hi) {
+      std::inplace_merge(first + bounds[lo], first + bounds[mid], first + bounds[hi], comp);
+   });
+}
+} // namespace Detail
+
+//////////////////////////////////////////////////////////////////////////
+/// Call func(b, e) on sub-ranges [b, e) covering [begin, end), in parallel.
+/// The sub-ranges have at least grainSize indices, except when [begin, end)
+/// is shorter, in which case func(begin, end) is called in this thread.
+template <class F>
+void ForRange(std::size_t begin, std::size_t end, F func, std::size_t grainSize = 1)
+{
+   if (begin >= end)
+      return;
+   if (end - begin <= grainSize) {
+      func(begin, end);
+      return;
+   }
+   ROOT::Internal::ParallelForRange(begin, end, grainSize, func);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Call func(i) for each i in [begin, end), in parallel. Each task processes
+/// at least grainSize consecutive indices: for cheap functions a grain size
+/// of a few thousands avoids paying the scheduling cost for every index.
+template <class F>
+void For(std::size_t begin, std::size_t end, F func, std::size_t grainSize = 1)
+{
+   ForRange(begin, end,
+            [&func](std::size_t b, std::size_t e) {
+               for (std::size_t i = b; i < e; ++i)
+                  func(i);
+            },
+            grainSize);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Sort [first, last) according to comp, in parallel: chunks are sorted by
+/// the threads of the pool and then merged pairwise.
+template <class RandomIt, class Compare>
+void Sort(RandomIt first, RandomIt last, Compare comp)
+{
+   Detail::MergeSort(first, last, comp, [&comp](RandomIt b, RandomIt e) { std::sort(b, e, comp); });
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Sort [first, last) in increasing order, in parallel.
+template <class RandomIt>
+void Sort(RandomIt first, RandomIt last)
+{
+   Sort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Sort [first, last) according to comp, in parallel, keeping the order of
+/// the equivalent elements.
+template <class RandomIt, class Compare>
+void StableSort(RandomIt first, RandomIt last, Compare comp)
+{
+   Detail::MergeSort(first, last, comp, [&comp](RandomIt b, RandomIt e) { std::stable_sort(b, e, comp); });
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Sort [first, last) in increasing order, in parallel, keeping the order
+/// of the equivalent elements.
+template <class RandomIt>
+void StableSort(RandomIt first, RandomIt last)
+{
+   StableSort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Write to d_first + i the sum with op of the elements first to first + i
+/// included, in parallel. op must be associative. The input and the output
+/// may be the same range. Return the end of the output range.
+template <class RandomIt, class OutRandomIt, class BinaryOp>
+OutRandomIt InclusiveScan(RandomIt first, RandomIt last, OutRandomIt d_first, BinaryOp op)
+{
+   using T = typename std::iterator_traits<RandomIt>::value_type;
+   const auto bounds = Detail::Chunks(last - first);
+   const std::size_t nChunks = bounds.size() - 1;
+   if (nChunks < 2)
+      return std::partial_sum(first, last, d_first, op);
+
+   // Sum of each chunk, then of all the chunks preceding each chunk
+   std::vector<T> offsets(nChunks);
+   ROOT::Internal::ParallelForRange(1, nChunks, 1, [&](std::size_t b, std::size_t e) {
+      for (std::size_t i = b; i < e; ++i) {
+         auto it = first + bounds[i - 1];
+         T sum = *it;
+         for (++it; it != first + bounds[i]; ++it)
+            sum = op(sum, *it);
+         offsets[i] = sum;
+      }
+   });
+   for (std::size_t i = 2; i < nChunks; ++i)
+      offsets[i] = op(offsets[i - 1], offsets[i]);
+
+   ROOT::Internal::ParallelForRange(0, nChunks, 1, [&](std::size_t b, std::size_t e) {
+      for (std::size_t i = b; i < e; ++i) {
+         auto it = first + bounds[i];
+         auto out = d_first + bounds[i];
+         T sum = i ? op(offsets[i], *it) : *it;
+         *out = sum;
+         for (++it, ++out; it != first + bounds[i + 1]; ++it, ++out) {
+            sum = op(sum, *it);
+            *out = sum;
+         }
+      }
+   });
+   return d_first + (last - first);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Inclusive prefix sum of [first, last) with operator+.
+template <class RandomIt, class OutRandomIt>
+OutRandomIt InclusiveScan(RandomIt first, RandomIt last, OutRandomIt d_first)
+{
+   return InclusiveScan(first, last, d_first, std::plus<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Write to d_first + i the sum with op of init and of the elements first
+/// to first + i excluded, in parallel. op must be associative. The input
+/// and the output may be the same range. Return the end of the output range.
+template <class RandomIt, class OutRandomIt, class T, class BinaryOp>
+OutRandomIt ExclusiveScan(RandomIt first, RandomIt last, OutRandomIt d_first, T init, BinaryOp op)
+{
+   const auto bounds = Detail::Chunks(last - first);
+   const std::size_t nChunks = bounds.size() - 1;
+
+   // Sum of each chunk, then of init and all the chunks preceding each chunk
+   std::vector<T> offsets(nChunks, init);
+   if (nChunks > 1) {
+      ROOT::Internal::ParallelForRange(1, nChunks, 1, [&](std::size_t b, std::size_t e) {
+         for (std::size_t i = b; i < e; ++i) {
+            auto it = first + bounds[i - 1];
+            T sum = *it;
+            for (++it; it != first + bounds[i]; ++it)
+               sum = op(sum, *it);
+            offsets[i] = sum;
+         }
+      });
+      for (std::size_t i = 1; i < nChunks; ++i)
+         offsets[i] = op(offsets[i - 1], offsets[i]);
+   }
+
+   auto scanChunk = [&](std::size_t b, std::size_t e) {
+      for (std::size_t i = b; i < e; ++i) {
+         T sum = offsets[i];
+         auto out = d_first + bounds[i];
+         for (auto it = first + bounds[i]; it != first + bounds[i + 1]; ++it, ++out) {
+            T value = *it;
+            *out = sum;
+            sum = op(sum, value);
+         }
+      }
+   };
+   if (nChunks > 1)
+      ROOT::Internal::ParallelForRange(0, nChunks, 1, scanChunk);
+   else
+      scanChunk(0, nChunks);
+   return d_first + (last - first);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Exclusive prefix sum of [first, last) with operator+, starting from init.
+template <class RandomIt, class OutRandomIt, class T>
+OutRandomIt ExclusiveScan(RandomIt first, RandomIt last, OutRandomIt d_first, T init)
+{
+   return ExclusiveScan(first, last, d_first, init, std::plus<T>());
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Move the elements of [first, last) for which pred is true before the
+/// others, keeping their relative order, in parallel: the chunks are
+/// partitioned by the threads of the pool and then combined pairwise.
+/// Return an iterator to the first element for which pred is false.
+template <class RandomIt, class UnaryPredicate>
+RandomIt Partition(RandomIt first, RandomIt last, UnaryPredicate pred)
+{
+   const auto bounds = Detail::Chunks(last - first);
+   const std::size_t nChunks = bounds.size() - 1;
+   if (nChunks < 2)
+      return std::stable_partition(first, last, pred);
+
+   // Partition point of each chunk, then of each group of chunks combined so far
+   std::vector<RandomIt> points(nChunks);
+   ROOT::Internal::ParallelForRange(0, nChunks, 1, [&](std::size_t b, std::size_t e) {
+      for (std::size_t i = b; i < e; ++i)
+         points[i] = std::stable_partition(first + bounds[i], first + bounds[i + 1], pred);
+   });
+   Detail::TreeCombine(nChunks, [&](std::size_t lo, std::size_t mid, std::size_t) {
+      // [true lo][false lo][true mid][false mid] -> [true lo][true mid][false lo][false mid]
+      points[lo] = std::rotate(points[lo], first + bounds[mid], points[mid]);
+   });
+   return points[0];
+}
+
+} // namespace Parallel
+} // namespace ROOT
+
+#endif // R__USE_IMT
+#endif
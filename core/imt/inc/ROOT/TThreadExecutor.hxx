@@ -29,6 +29,7 @@
 #include <functional>
 #include <memory>
 #include <numeric>
+#include <type_traits>
 
 namespace ROOT {
 
@@ -102,6 +103,12 @@ namespace ROOT {
       void   ParallelFor(unsigned start, unsigned end, unsigned step, const std::function<void(unsigned int i)> &f);
       double ParallelReduce(const std::vector<double> &objs, const std::function<double(double a, double b)> &redfunc);
       float  ParallelReduce(const std::vector<float> &objs, const std::function<float(float a, float b)> &redfunc);
+      template<class T, class BINARYOP>
+      T ParallelReduce(const std::vector<T> &objs, BINARYOP redfunc, std::true_type /*isDoubleOrFloat*/);
+      template<class T, class BINARYOP>
+      T ParallelReduce(const std::vector<T> &objs, BINARYOP redfunc, std::false_type /*isDoubleOrFloat*/);
+      template<class T, class BINARYOP>
+      T ParallelTreeReduce(const std::vector<T> &objs, BINARYOP redfunc);
       template<class T, class R>
       auto SeqReduce(const std::vector<T> &objs, R redfunc) -> decltype(redfunc(objs));
 
@@ -443,7 +450,45 @@ namespace ROOT {
    {
       // check we can apply reduce to objs
       static_assert(std::is_same<decltype(redfunc(objs.front(), objs.front())), T>::value, "redfunc does not have the correct signature");
-      return ParallelReduce(objs, redfunc);
+      return ParallelReduce(objs, redfunc,
+                            std::integral_constant<bool, std::is_same<T, double>::value || std::is_same<T, float>::value>());
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// Reduce doubles or floats with tbb::parallel_reduce.
+   template<class T, class BINARYOP>
+   T TThreadExecutor::ParallelReduce(const std::vector<T> &objs, BINARYOP redfunc, std::true_type)
+   {
+      return ParallelReduce(objs, std::function<T(T, T)>(redfunc));
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// Reduce any other type, e.g. pointers to histograms, with ParallelTreeReduce.
+   template<class T, class BINARYOP>
+   T TThreadExecutor::ParallelReduce(const std::vector<T> &objs, BINARYOP redfunc, std::false_type)
+   {
+      return ParallelTreeReduce(objs, redfunc);
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// Reduce objs as a binary tree: at each level, the partial results i and
+   /// i + step are combined in parallel for all the i multiple of 2 * step.
+   /// The order of the operands is preserved, so redfunc must be associative
+   /// but needs not be commutative.
+   template<class T, class BINARYOP>
+   T TThreadExecutor::ParallelTreeReduce(const std::vector<T> &objs, BINARYOP redfunc)
+   {
+      if (objs.empty())
+         return T{};
+      std::vector<T> partials(objs);
+      const auto n = partials.size();
+      for (size_t step = 1; step < n; step *= 2) {
+         const unsigned nPairs = (n + step - 1) / (2 * step);
+         ParallelFor(0U, nPairs, 1, [&partials, &redfunc, step](unsigned k) {
+            partials[2 * step * k] = redfunc(partials[2 * step * k], partials[2 * step * k + step]);
+         });
+      }
+      return partials[0];
    }
 
    //////////////////////////////////////////////////////////////////////////
@@ -21,7 +21,9 @@
 #include "TError.h"
 #include "TThread.h"
 #include "ROOT/TPoolManager.hxx"
+#include "tbb/tbb.h"
 #include <atomic>
+#include <functional>
 
 static std::shared_ptr<ROOT::Internal::TPoolManager> &R__GetPoolManagerMT()
 {
@@ -105,3 +107,8 @@ extern "C" bool ROOT_TImplicitMT_IsParTreeProcessingEnabled()
 {
    return GetParTreeProcessingCount() > 0;
 };
+
+extern "C" void ROOT_TImplicitMT_ParallelFor(UInt_t n, const std::function<void(UInt_t)> &func)
+{
+   tbb::this_task_arena::isolate([&] { tbb::parallel_for(0u, n, [&](UInt_t i) { func(i); }); });
+}
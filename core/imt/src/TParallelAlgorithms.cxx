@@ -0,0 +1,57 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TParallelAlgorithms.hxx"
+#include "ROOT/TPoolManager.hxx"
+
+#if !defined(_MSC_VER)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#endif
+#include "tbb/tbb.h"
+#if !defined(_MSC_VER)
+#pragma GCC diagnostic pop
+#endif
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call func(b, e) on sub-ranges of [begin, end) of at least grainSize
+/// indices, in parallel on the ROOT thread pool and isolated from the outer
+/// tasks, like TThreadExecutor::ParallelFor. This is the building block of the
+/// algorithms of ROOT::Parallel.
+
+void ParallelForRange(std::size_t begin, std::size_t end, std::size_t grainSize,
+                      const std::function<void(std::size_t, std::size_t)> &func)
+{
+   // Use the implicit multi-threading pool if there is one, otherwise keep a
+   // default one alive for the duration of the call.
+   auto sched = GetPoolManager(0);
+   using BRange_t = tbb::blocked_range<std::size_t>;
+   tbb::this_task_arena::isolate([&] {
+      tbb::parallel_for(BRange_t(begin, end, grainSize ? grainSize : 1),
+                        [&func](const BRange_t &range) { func(range.begin(), range.end()); });
+   });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of threads the algorithms of ROOT::Parallel run on: the size of the
+/// implicit multi-threading pool if it is enabled, else the number of cores.
+
+unsigned GetParallelAlgorithmsPoolSize()
+{
+   if (auto size = TPoolManager::GetPoolSize())
+      return size;
+   return tbb::task_scheduler_init::default_num_threads();
+}
+
+} // namespace Internal
+} // namespace ROOT
@@ -0,0 +1,118 @@
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TParallelAlgorithms.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Large enough to be split in several chunks
+const std::size_t kN = 200000;
+
+std::vector<int> RandomInts(std::size_t n, int max)
+{
+   std::mt19937 gen(42);
+   std::uniform_int_distribution<int> dist(0, max);
+   std::vector<int> v(n);
+   for (auto &x : v)
+      x = dist(gen);
+   return v;
+}
+
+TEST(TParallelAlgorithms, For)
+{
+   std::vector<std::atomic<int>> counts(kN);
+   for (auto &c : counts)
+      c = 0;
+   ROOT::Parallel::For(0, kN, [&](std::size_t i) { ++counts[i]; }, 1000);
+   for (std::size_t i = 0; i < kN; ++i)
+      EXPECT_EQ(1, counts[i].load());
+
+   std::atomic<std::size_t> total(0);
+   ROOT::Parallel::ForRange(10, kN, [&](std::size_t b, std::size_t e) {
+      EXPECT_LE(b, e);
+      total += e - b;
+   });
+   EXPECT_EQ(kN - 10, total.load());
+}
+
+TEST(TParallelAlgorithms, Sort)
+{
+   auto v = RandomInts(kN, 1000000);
+   auto expected = v;
+   std::sort(expected.begin(), expected.end());
+   ROOT::Parallel::Sort(v.begin(), v.end());
+   EXPECT_EQ(expected, v);
+
+   ROOT::Parallel::Sort(v.begin(), v.end(), [](int a, int b) { return a > b; });
+   std::reverse(expected.begin(), expected.end());
+   EXPECT_EQ(expected, v);
+}
+
+TEST(TParallelAlgorithms, StableSort)
+{
+   // Many equal keys: the original positions must stay in order
+   auto keys = RandomInts(kN, 100);
+   std::vector<std::pair<int, std::size_t>> v(kN);
+   for (std::size_t i = 0; i < kN; ++i)
+      v[i] = {keys[i], i};
+   auto byKey = [](const std::pair<int, std::size_t> &a, const std::pair<int, std::size_t> &b) {
+      return a.first < b.first;
+   };
+   auto expected = v;
+   std::stable_sort(expected.begin(), expected.end(), byKey);
+   ROOT::Parallel::StableSort(v.begin(), v.end(), byKey);
+   EXPECT_EQ(expected, v);
+}
+
+TEST(TParallelAlgorithms, Scan)
+{
+   auto v = RandomInts(kN, 10);
+   std::vector<long long> expected(kN), out(kN);
+   std::partial_sum(v.begin(), v.end(), expected.begin(), std::plus<long long>());
+   ROOT::Parallel::InclusiveScan(v.begin(), v.end(), out.begin(), std::plus<long long>());
+   EXPECT_EQ(expected, out);
+
+   ROOT::Parallel::ExclusiveScan(v.begin(), v.end(), out.begin(), 5LL);
+   EXPECT_EQ(5, out[0]);
+   for (std::size_t i = 1; i < kN; ++i)
+      EXPECT_EQ(expected[i - 1] + 5, out[i]);
+
+   // In place
+   std::vector<int> w(kN, 1);
+   ROOT::Parallel::InclusiveScan(w.begin(), w.end(), w.begin());
+   EXPECT_EQ(int(kN), w.back());
+
+   std::vector<int> empty;
+   EXPECT_EQ(out.begin(), ROOT::Parallel::ExclusiveScan(empty.begin(), empty.end(), out.begin(), 0));
+}
+
+TEST(TParallelAlgorithms, Partition)
+{
+   auto v = RandomInts(kN, 1000);
+   auto isEven = [](int x) { return x % 2 == 0; };
+   auto expected = v;
+   auto expectedPoint = std::stable_partition(expected.begin(), expected.end(), isEven);
+   auto point = ROOT::Parallel::Partition(v.begin(), v.end(), isEven);
+   EXPECT_EQ(expectedPoint - expected.begin(), point - v.begin());
+   EXPECT_EQ(expected, v);
+}
+
+TEST(TParallelAlgorithms, ImplicitMTPool)
+{
+   ROOT::EnableImplicitMT(2);
+   auto v = RandomInts(kN, 1000000);
+   auto expected = v;
+   std::sort(expected.begin(), expected.end());
+   ROOT::Parallel::Sort(v.begin(), v.end());
+   EXPECT_EQ(expected, v);
+   ROOT::DisableImplicitMT();
+}
+
+#endif
@@ -66,6 +66,7 @@ namespace ROOT {
    }
    namespace Internal {
       class TCheckHashRecursiveRemoveConsistency;
+      template <typename T> class TLockFreeLookup;
    }
 }
 
@@ -242,6 +243,8 @@ private:
    EState             fState;           //!Current 'state' of the class (Emulated,Interpreted,Loaded)
    mutable std::atomic<TVirtualStreamerInfo*>  fCurrentInfo;     //!cached current streamer info.
    mutable std::atomic<TVirtualStreamerInfo*>  fLastReadInfo;    //!cached streamer info used in the last read.
+   mutable std::atomic<ROOT::Internal::TLockFreeLookup<TVirtualStreamerInfo>*> fInfoLookup{nullptr}; //!lock-free version/checksum to compiled streamer info map.
+   std::atomic<Bool_t> fInClassLookup{kFALSE}; //!Whether this class was registered in the lock-free name lookup.
    TVirtualRefProxy  *fRefProxy;        //!Pointer to reference proxy if this class represents a reference
    ROOT::Detail::TSchemaRuleSet *fSchemaRules;  //! Schema evolution rules
 
@@ -253,6 +256,10 @@ private:
 #endif
 
    Bool_t             CanSplitBaseAllow();
+   static TClass     *GetClassImpl(const char *name, Bool_t load, Bool_t silent);
+   static TClass     *GetClassImpl(const std::type_info &typeinfo, Bool_t load);
+   ROOT::Internal::TLockFreeLookup<TVirtualStreamerInfo> *GetInfoLookup() const;
+   void               ClearInfoLookup() const;
    TListOfFunctions  *GetMethodList();
    TMethod           *GetClassMethod(Long_t faddr);
    TMethod           *FindClassOrBaseMethodWithId(DeclId_t faddr);
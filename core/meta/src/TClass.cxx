@@ -118,6 +118,7 @@ In order to access the name of a class within the ROOT type system, the method T
 #include "TClonesArray.h"
 #include "TRef.h"
 #include "TRefArray.h"
+#include "TLockFreeLookup.h"
 
 using namespace std;
 
@@ -140,6 +141,31 @@ namespace {
    };
 }
 
+namespace {
+
+   using ClassLookup_t = ROOT::Internal::TLockFreeLookup<TClass>;
+
+   // Lock-free caches of the loaded TClass objects, by requested name and by
+   // typeid name, consulted before taking gCoreMutex in TClass::GetClass.
+   // They are never deleted, as TClass destructors running at exit may still
+   // unregister from them.
+   ClassLookup_t &GetNameLookup()
+   {
+      static ClassLookup_t *lookup = new ClassLookup_t(1024);
+      return *lookup;
+   }
+
+   ClassLookup_t &GetTypeidLookup()
+   {
+      static ClassLookup_t *lookup = new ClassLookup_t(1024);
+      return *lookup;
+   }
+
+   // Keys of the streamer info lookup of a TClass.
+   ULong64_t VersionKey(Int_t version) { return (1ull << 32) | (UInt_t)version; }
+   ULong64_t CheckSumKey(UInt_t checksum) { return (2ull << 32) | checksum; }
+}
+
 std::atomic<Int_t> TClass::fgClassCount;
 
 // Implementation of the TDeclNameRegistry
@@ -1298,6 +1324,7 @@ void TClass::ForceReload (TClass* oldcl)
       fStreamerInfo->AddAtAndExpand(info,info->GetClassVersion());
    }
    oldcl->fStreamerInfo->Clear();
+   oldcl->ClearInfoLookup();
 
    oldcl->ReplaceWith(this);
    delete oldcl;
@@ -1373,6 +1400,7 @@ void TClass::Init(const char *name, Version_t cversion,
          fStreamerInfo->AddAtAndExpand(info,info->GetClassVersion());
       }
       oldcl->fStreamerInfo->Clear();
+      oldcl->ClearInfoLookup();
       // The code diverges here from ForceReload.
 
       // Move the Schema Rules too.
@@ -1627,6 +1655,12 @@ TClass::~TClass()
       fRealData->Delete();
    delete fRealData;  fRealData=0;
 
+   if (fInClassLookup) {
+      GetNameLookup().Remove(this);
+      GetTypeidLookup().Remove(this);
+   }
+   delete fInfoLookup.load(); fInfoLookup = nullptr;
+
    if (fStreamerInfo)
       fStreamerInfo->Delete();
    delete fStreamerInfo; fStreamerInfo = nullptr;
@@ -2888,17 +2922,39 @@ TVirtualIsAProxy* TClass::GetIsAProxy() const
 /// If silent is 'true', do not warn about missing dictionary for the class.
 /// (typically used for class that are used only for transient members)
 /// Returns 0 in case class is not found.
+///
+/// Once a class with a dictionary has been found under a given name (normalized
+/// or not), the following lookups of that name take no lock.
 
 TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
 {
    if (!name || !name[0]) return 0;
 
-   if (strstr(name, "(anonymous)")) return 0;
    if (strncmp(name,"class ",6)==0) name += 6;
    if (strncmp(name,"struct ",7)==0) name += 7;
 
    if (!gROOT->GetListOfClasses())  return 0;
 
+   const ULong64_t hash = ClassLookup_t::Hash(name);
+   if (TClass *cl = GetNameLookup().Find(hash, name))
+      return cl;
+
+   TClass *cl = GetClassImpl(name, load, silent);
+   if (cl && cl->IsLoaded() && !cl->TestBit(kUnloading)) {
+      cl->fInClassLookup = kTRUE;
+      GetNameLookup().Insert(hash, name, cl);
+   }
+   return cl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of GetClass(const char*, Bool_t, Bool_t), without the
+/// lock-free lookup of the already loaded classes.
+
+TClass *TClass::GetClassImpl(const char *name, Bool_t load, Bool_t silent)
+{
+   if (strstr(name, "(anonymous)")) return 0;
+
    // FindObject will take the read lock before actually getting the
    // TClass pointer so we will need not get a partially initialized
    // object.
@@ -3113,6 +3169,25 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    if (!gROOT->GetListOfClasses())
       return 0;
 
+   const char *name = typeinfo.name();
+   const ULong64_t hash = ClassLookup_t::Hash(name);
+   if (TClass *cl = GetTypeidLookup().Find(hash, name))
+      return cl;
+
+   TClass *cl = GetClassImpl(typeinfo, load);
+   if (cl && cl->IsLoaded() && !cl->TestBit(kUnloading)) {
+      cl->fInClassLookup = kTRUE;
+      GetTypeidLookup().Insert(hash, name, cl);
+   }
+   return cl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of GetClass(const std::type_info&, Bool_t, Bool_t), without
+/// the lock-free lookup of the already loaded classes.
+
+TClass *TClass::GetClassImpl(const std::type_info& typeinfo, Bool_t load)
+{
    //protect access to TROOT::GetIdMap
    R__READ_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -4483,6 +4558,13 @@ TVirtualStreamerInfo* TClass::GetStreamerInfo(Int_t version /* = 0 */) const
    if (sinfo && sinfo->GetClassVersion() == version)
       return sinfo;
 
+   // Otherwise look for another version that was already built and compiled,
+   // which is common when reading files written with several class versions.
+   if (auto lookup = fInfoLookup.load(std::memory_order_acquire)) {
+      if ((sinfo = lookup->Find(VersionKey(version))))
+         return sinfo;
+   }
+
    // Note that the access to fClassVersion above is technically not thread-safe with a low probably of problems.
    // fClassVersion is not an atomic and is modified TClass::SetClassVersion (called from RootClassVersion via
    // ROOT::ResetClassVersion) and is 'somewhat' protected by the atomic fVersionUsed.
@@ -4547,12 +4629,40 @@ TVirtualStreamerInfo* TClass::GetStreamerInfo(Int_t version /* = 0 */) const
       fCurrentInfo = sinfo;
 
    // If the compilation succeeded, remember this StreamerInfo.
-   if (sinfo->IsCompiled())
+   if (sinfo->IsCompiled()) {
       fLastReadInfo = sinfo;
+      if (sinfo->GetClassVersion() == version)
+         GetInfoLookup()->Insert(VersionKey(version), nullptr, sinfo);
+   }
 
    return sinfo;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the lock-free lookup of the compiled TVirtualStreamerInfo by version
+/// and by checksum, creating it if needed. Must be called with
+/// gInterpreterMutex held.
+
+ROOT::Internal::TLockFreeLookup<TVirtualStreamerInfo> *TClass::GetInfoLookup() const
+{
+   auto lookup = fInfoLookup.load(std::memory_order_acquire);
+   if (!lookup) {
+      lookup = new ROOT::Internal::TLockFreeLookup<TVirtualStreamerInfo>(8);
+      fInfoLookup.store(lookup, std::memory_order_release);
+   }
+   return lookup;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Invalidate the lock-free lookup of the streamer infos, to be called when
+/// one of them is removed from or replaced in fStreamerInfo.
+
+void TClass::ClearInfoLookup() const
+{
+   if (auto lookup = fInfoLookup.load(std::memory_order_acquire))
+      lookup->Clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// For the case where the requestor class is emulated and this class is abstract,
 /// returns a pointer to the TVirtualStreamerInfo object for version with an emulated
@@ -6047,6 +6157,12 @@ void TClass::SetUnloaded()
    }
    SetBit(kUnloading);
 
+   if (fInClassLookup) {
+      GetNameLookup().Remove(this);
+      GetTypeidLookup().Remove(this);
+      fInClassLookup = kFALSE;
+   }
+
    //R__ASSERT(fState == kLoaded);
    if (fState != kLoaded) {
       Fatal("SetUnloaded","The TClass for %s is being unloaded when in state %d\n",
@@ -6762,6 +6878,11 @@ TVirtualStreamerInfo *TClass::FindStreamerInfo(UInt_t checksum) const
    } else {
       if (fCheckSum == checksum) return GetStreamerInfo();
 
+      if (auto lookup = fInfoLookup.load(std::memory_order_acquire)) {
+         if (TVirtualStreamerInfo *info = lookup->Find(CheckSumKey(checksum)))
+            return info;
+      }
+
       R__LOCKGUARD(gInterpreterMutex);
       Int_t ninfos = fStreamerInfo->GetEntriesFast()-1;
       for (Int_t i=-1;i<ninfos;++i) {
@@ -6771,7 +6892,10 @@ TVirtualStreamerInfo *TClass::FindStreamerInfo(UInt_t checksum) const
          if (info && info->GetCheckSum() == checksum) {
             // R__ASSERT(i==info->GetClassVersion() || (i==-1&&info->GetClassVersion()==1));
             info->BuildOld();
-            if (info->IsCompiled()) fLastReadInfo = info;
+            if (info->IsCompiled()) {
+               fLastReadInfo = info;
+               GetInfoLookup()->Insert(CheckSumKey(checksum), nullptr, info);
+            }
             return info;
          }
       }
@@ -7006,6 +7130,7 @@ void TClass::RegisterStreamerInfo(TVirtualStreamerInfo *info)
          Error("RegisterStreamerInfo",
                "Register StreamerInfo for %s on non-empty slot (%d).",
                GetName(),slot);
+         ClearInfoLookup();
       }
       fStreamerInfo->AddAtAndExpand(info, slot);
       if (fState <= kForwardDeclared) {
@@ -7025,6 +7150,7 @@ void TClass::RemoveStreamerInfo(Int_t slot)
       R__LOCKGUARD(gInterpreterMutex);
       TVirtualStreamerInfo *info = (TVirtualStreamerInfo*)fStreamerInfo->At(slot);
       fStreamerInfo->RemoveAt(fClassVersion);
+      ClearInfoLookup();
       delete info;
       if (fState == kEmulated && fStreamerInfo->GetEntries() == 0) {
          fState = kForwardDeclared;
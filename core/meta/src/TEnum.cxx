@@ -173,6 +173,8 @@ TEnum *TEnum::GetEnum(const std::type_info &ti, ESearchAction sa)
 /// as such, but rather as THashList objects. This prevents any flow of information
 /// from the interpreter into the ROOT's typesystem: a snapshot of the typesystem
 /// status is taken.
+/// If the PCMs of the dictionaries are loaded lazily (Root.LazyPCM), the PCM
+/// describing the enumerator is loaded before the typesystem is searched.
 
 TEnum *TEnum::GetEnum(const char *enumName, ESearchAction sa)
 {
@@ -261,6 +263,9 @@ TEnum *TEnum::GetEnum(const char *enumName, ESearchAction sa)
       scopeName[scopeNameSize] = '\0';
       // Three levels of search
       theEnum = searchEnum(scopeName, enName, kNone);
+      // In lazy mode (Root.LazyPCM), the PCM describing the enum may not be loaded yet.
+      if (!theEnum && gInterpreter->LoadPendingPCMs(enumName))
+         theEnum = searchEnum(scopeName, enName, kNone);
       if (!theEnum && (sa & kAutoload)) {
          const auto libsLoaded = gInterpreter->AutoLoad(scopeName);
          // It could be an enum in a scope which is not selected
@@ -281,6 +286,8 @@ TEnum *TEnum::GetEnum(const char *enumName, ESearchAction sa)
    } else {
       // We don't have any scope: this is a global enum
       theEnum = findEnumInList(gROOT->GetListOfEnums(), enumName, kNone);
+      if (!theEnum && gInterpreter->LoadPendingPCMs(enumName))
+         theEnum = findEnumInList(gROOT->GetListOfEnums(), enumName, kNone);
       if (!theEnum && (sa & kAutoload)) {
          gInterpreter->AutoLoad(enumName);
          theEnum = findEnumInList(gROOT->GetListOfEnums(), enumName, kAutoload);
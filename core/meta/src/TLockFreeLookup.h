@@ -0,0 +1,201 @@
+// @(#)root/meta:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TLockFreeLookup
+#define ROOT_TLockFreeLookup
+
+#include "RtypesCore.h"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TLockFreeLookup                                                      //
+//                                                                      //
+// Insert-only open addressing hash table mapping a 64 bits key, and    //
+// optionally a string, to a pointer. Find() takes no lock: it is meant //
+// for the lookups of already resolved entities (name -> TClass,        //
+// version or checksum -> TStreamerInfo) done on every read.            //
+//                                                                      //
+// Writers are serialized by an internal mutex. A slot is published by  //
+// storing its key last, with release semantics, so that a reader that  //
+// sees the key also sees the name and the value. When the table grows, //
+// the new one is published atomically and the old ones are kept until  //
+// the destruction of the lookup, as readers may still be probing them. //
+// Entries are invalidated by setting their value to nullptr.           //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+namespace ROOT {
+namespace Internal {
+
+template <typename T>
+class TLockFreeLookup {
+private:
+   struct Slot_t {
+      std::atomic<ULong64_t> fKey{0};       // 0 for an empty slot
+      std::atomic<const char *> fName{nullptr};
+      std::atomic<T *> fValue{nullptr};
+   };
+
+   struct Table_t {
+      size_t fMask;                         // number of slots - 1
+      size_t fUsed = 0;                     // number of keys, only accessed by the writers
+      std::unique_ptr<Slot_t[]> fSlots;
+      Table_t(size_t size) : fMask(size - 1), fSlots(new Slot_t[size]) {}
+   };
+
+   std::atomic<Table_t *> fTable;                     // current table
+   std::vector<std::unique_ptr<Table_t>> fTables;     // all the tables ever published
+   std::vector<std::unique_ptr<char[]>> fNames;       // storage of the string keys
+   std::mutex fWriteMutex;                            // serializes the writers
+
+   static ULong64_t Fix(ULong64_t key) { return key ? key : 1; }
+
+   static bool Match(const Slot_t &slot, const char *name)
+   {
+      const char *slotName = slot.fName.load(std::memory_order_relaxed);
+      return name ? (slotName && !strcmp(slotName, name)) : !slotName;
+   }
+
+   // Store key/name/value in table, which must have a free slot.
+   static void Store(Table_t &table, ULong64_t key, const char *name, T *value)
+   {
+      for (size_t i = key & table.fMask;; i = (i + 1) & table.fMask) {
+         Slot_t &slot = table.fSlots[i];
+         ULong64_t slotKey = slot.fKey.load(std::memory_order_relaxed);
+         if (slotKey == key && Match(slot, name)) {
+            slot.fValue.store(value, std::memory_order_release);
+            return;
+         }
+         if (!slotKey) {
+            slot.fName.store(name, std::memory_order_relaxed);
+            slot.fValue.store(value, std::memory_order_relaxed);
+            slot.fKey.store(key, std::memory_order_release);
+            ++table.fUsed;
+            return;
+         }
+      }
+   }
+
+public:
+   TLockFreeLookup(size_t size = 64)
+   {
+      size_t n = 8;
+      while (n < size)
+         n *= 2;
+      fTables.emplace_back(new Table_t(n));
+      fTable = fTables.back().get();
+   }
+
+   TLockFreeLookup(const TLockFreeLookup &) = delete;
+   TLockFreeLookup &operator=(const TLockFreeLookup &) = delete;
+
+   /// Hash of a string key, to be passed along with the string.
+   static ULong64_t Hash(const char *name)
+   {
+      // FNV-1a
+      ULong64_t h = 14695981039346656037ull;
+      for (; *name; ++name)
+         h = (h ^ (UChar_t)*name) * 1099511628211ull;
+      return h;
+   }
+
+   /// Return the value stored for key (and name if not null), or nullptr.
+   /// Takes no lock.
+   T *Find(ULong64_t key, const char *name = nullptr) const
+   {
+      key = Fix(key);
+      const Table_t *table = fTable.load(std::memory_order_acquire);
+      for (size_t i = key & table->fMask;; i = (i + 1) & table->fMask) {
+         const Slot_t &slot = table->fSlots[i];
+         ULong64_t slotKey = slot.fKey.load(std::memory_order_acquire);
+         if (!slotKey)
+            return nullptr;
+         if (slotKey == key && Match(slot, name))
+            return slot.fValue.load(std::memory_order_acquire);
+      }
+   }
+
+   /// Set the value stored for key (and name if not null).
+   void Insert(ULong64_t key, const char *name, T *value)
+   {
+      key = Fix(key);
+      std::lock_guard<std::mutex> lock(fWriteMutex);
+      Table_t *table = fTable.load(std::memory_order_relaxed);
+
+      // Keep the table at most half full, so that the probe sequences stay short.
+      if (2 * (table->fUsed + 1) > table->fMask + 1) {
+         Table_t *grown = new Table_t(2 * (table->fMask + 1));
+         for (size_t i = 0; i <= table->fMask; ++i) {
+            const Slot_t &slot = table->fSlots[i];
+            if (ULong64_t slotKey = slot.fKey.load(std::memory_order_relaxed))
+               Store(*grown, slotKey, slot.fName.load(std::memory_order_relaxed),
+                     slot.fValue.load(std::memory_order_relaxed));
+         }
+         fTables.emplace_back(grown);
+         fTable.store(grown, std::memory_order_release);
+         table = grown;
+      }
+
+      const char *storedName = nullptr;
+      if (name) {
+         if (Find(key, name) == value && value)
+            return;
+         // Reuse the copy of the name of an existing entry.
+         for (size_t i = key & table->fMask;; i = (i + 1) & table->fMask) {
+            const Slot_t &slot = table->fSlots[i];
+            ULong64_t slotKey = slot.fKey.load(std::memory_order_relaxed);
+            if (!slotKey)
+               break;
+            if (slotKey == key && Match(slot, name)) {
+               storedName = slot.fName.load(std::memory_order_relaxed);
+               break;
+            }
+         }
+         if (!storedName) {
+            size_t len = strlen(name) + 1;
+            fNames.emplace_back(new char[len]);
+            memcpy(fNames.back().get(), name, len);
+            storedName = fNames.back().get();
+         }
+      }
+      Store(*table, key, storedName, value);
+   }
+
+   /// Invalidate all the entries whose value is value.
+   void Remove(const T *value)
+   {
+      std::lock_guard<std::mutex> lock(fWriteMutex);
+      Table_t *table = fTable.load(std::memory_order_relaxed);
+      for (size_t i = 0; i <= table->fMask; ++i) {
+         if (table->fSlots[i].fValue.load(std::memory_order_relaxed) == value)
+            table->fSlots[i].fValue.store(nullptr, std::memory_order_release);
+      }
+   }
+
+   /// Invalidate all the entries.
+   void Clear()
+   {
+      std::lock_guard<std::mutex> lock(fWriteMutex);
+      Table_t *table = fTable.load(std::memory_order_relaxed);
+      for (size_t i = 0; i <= table->fMask; ++i)
+         table->fSlots[i].fValue.store(nullptr, std::memory_order_release);
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -1,6 +1,14 @@
 #include "TClass.h"
 #include "THashTable.h"
 #include "TInterpreter.h"
+#include "TNamed.h"
+#include "TROOT.h"
+#include "TVirtualStreamerInfo.h"
+
+#include <atomic>
+#include <thread>
+#include <typeinfo>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -22,3 +30,37 @@ TEST(TClass, DictCheck)
 
    EXPECT_STREQ(errMsg.c_str(), "Missing dictionary for C, ") << errMsg;
 }
+
+TEST(TClass, ConcurrentGetClass)
+{
+   ROOT::EnableThreadSafety();
+
+   auto named = TClass::GetClass("TNamed");
+   ASSERT_NE(named, nullptr);
+   auto vec = TClass::GetClass("vector<int>");
+   ASSERT_NE(vec, nullptr);
+
+   std::vector<std::thread> threads;
+   std::atomic<int> mismatches{0};
+   for (int i = 0; i < 8; ++i) {
+      threads.emplace_back([&]() {
+         for (int j = 0; j < 1000; ++j) {
+            if (TClass::GetClass("TNamed") != named || TClass::GetClass("class TNamed") != named ||
+                TClass::GetClass(typeid(TNamed)) != named)
+               ++mismatches;
+            // Non normalized names must resolve to the same TClass.
+            if (TClass::GetClass("std::vector<int>") != vec || TClass::GetClass("vector<int,allocator<int> >") != vec)
+               ++mismatches;
+         }
+      });
+   }
+   for (auto &t : threads)
+      t.join();
+   EXPECT_EQ(0, mismatches);
+
+   // The compiled streamer info is found again by version and by checksum.
+   auto info = named->GetStreamerInfo();
+   ASSERT_NE(info, nullptr);
+   EXPECT_EQ(info, named->GetStreamerInfo(named->GetClassVersion()));
+   EXPECT_EQ(info, named->FindStreamerInfo(named->GetCheckSum()));
+}
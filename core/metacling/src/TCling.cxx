@@ -124,6 +124,7 @@ clang/LLVM technology.
 #include <algorithm>
 #include <iostream>
 #include <cassert>
+#include <chrono>
 #include <map>
 #include <set>
 #include <stdexcept>
@@ -1188,6 +1189,42 @@ static void RegisterPreIncludedHeaders(cling::Interpreter &clingInterp)
    clingInterp.declare(PreIncludes);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Times a step of the initialization of the interpreter (creation, module
+/// registration, PCM loading) and records it for PrintStartupReport(), if
+/// the report was enabled with Root.StartupReport.
+
+class TCling::StartupStepRAII {
+   TCling &fCling;
+   std::string fWhat;
+   std::chrono::steady_clock::time_point fStart;
+   Long_t fMemStart = 0;
+
+   static Long_t GetResidentMemory()
+   {
+      ProcInfo_t info;
+      return gSystem->GetProcInfo(&info) == 0 ? info.fMemResident : 0;
+   }
+
+public:
+   StartupStepRAII(TCling &cling, std::string what) : fCling(cling)
+   {
+      if (!fCling.fStartupReport)
+         return;
+      fWhat = std::move(what);
+      fMemStart = GetResidentMemory();
+      fStart = std::chrono::steady_clock::now();
+   }
+
+   ~StartupStepRAII()
+   {
+      if (!fCling.fStartupReport)
+         return;
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - fStart;
+      fCling.fStartupRecords.push_back({std::move(fWhat), elapsed.count(), GetResidentMemory() - fMemStart});
+   }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize the cling interpreter interface.
 /// \param argv - array of arguments passed to the cling::Interpreter constructor
@@ -1201,6 +1238,12 @@ TCling::TCling(const char *name, const char *title, const char* const argv[])
 {
    const bool fromRootCling = IsFromRootCling();
 
+   if (!fromRootCling && gEnv) {
+      fLazyPCMs = gEnv->GetValue("Root.LazyPCM", 0);
+      fStartupReport = gEnv->GetValue("Root.StartupReport", 0);
+   }
+   StartupStepRAII startupStep(*this, "Creation of the interpreter");
+
    fCxxModulesEnabled = false;
 #ifdef R__USE_CXXMODULES
    fCxxModulesEnabled = true;
@@ -1636,6 +1679,63 @@ void TCling::LoadPCMImpl(TFile &pcmFile)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// In lazy mode (Root.LazyPCM set in the .rootrc), RegisterModule() does not
+/// load the PCM of the dictionaries. Load the PCM describing classname, if it
+/// is pending, or all the pending PCMs if classname is null. Called by the
+/// TClassTable when the TProtoClass of a class is missing, by TEnum::GetEnum()
+/// for a missing enum and by TListOfTypes for a missing typedef. Returns true
+/// if a PCM was loaded.
+///
+/// The PCMs are keyed by the autoload keys of the dictionary: its classes,
+/// enums, functions, variables and the typedefs to a class. A typedef to a
+/// fundamental type does not trigger the load of its PCM; it is still found,
+/// by a lookup in the interpreter.
+
+Bool_t TCling::LoadPendingPCMs(const char *classname)
+{
+   // Once all the PCMs are loaded, the lookups failing in the TClassTable
+   // return without taking the lock.
+   if (!fLazyPCMs || !fNPendingPCMs.load(std::memory_order_acquire))
+      return kFALSE;
+
+   R__LOCKGUARD(gInterpreterMutex);
+
+   std::vector<size_t> toLoad;
+   if (classname) {
+      auto iter = fLazyPCMClasses.find(classname);
+      if (iter == fLazyPCMClasses.end())
+         return kFALSE;
+      toLoad.push_back(iter->second);
+   } else {
+      for (size_t index = 0; index < fLazyPCMFiles.size(); ++index)
+         toLoad.push_back(index);
+   }
+
+   Bool_t loaded = kFALSE;
+   for (auto index : toLoad) {
+      // Empty the entry before loading, as LoadPCM() may recurse here
+      // through TClass::GetClass().
+      std::string pcmFileNameFullPath;
+      std::swap(pcmFileNameFullPath, fLazyPCMFiles[index]);
+      if (pcmFileNameFullPath.empty())
+         continue;
+      --fNPendingPCMs;
+      for (auto iter = fLazyPCMClasses.begin(); iter != fLazyPCMClasses.end();) {
+         if (iter->second == index)
+            iter = fLazyPCMClasses.erase(iter);
+         else
+            ++iter;
+      }
+      if (gDebug > 1)
+         ::Info("TCling::LoadPendingPCMs", "loading %s for %s", pcmFileNameFullPath.c_str(),
+                classname ? classname : "all classes");
+      LoadPCM(pcmFileNameFullPath);
+      loaded = kTRUE;
+   }
+   return loaded;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Tries to load a rdict PCM, issues diagnostics if it fails.
 
@@ -1643,6 +1743,7 @@ void TCling::LoadPCM(std::string pcmFileNameFullPath)
 {
    SuspendAutoloadingRAII autoloadOff(this);
    SuspendAutoParsing autoparseOff(this);
+   StartupStepRAII startupStep(*this, "Loading of " + pcmFileNameFullPath);
    assert(!pcmFileNameFullPath.empty());
    assert(llvm::sys::path::is_absolute(pcmFileNameFullPath));
 
@@ -1852,6 +1953,8 @@ void TCling::RegisterModule(const char* modulename,
    // module registration!
    SuspendAutoloadingRAII autoLoadOff(this);
 
+   StartupStepRAII startupStep(*this, std::string("Registration of ") + modulename);
+
    for (const char** inclPath = includePaths; *inclPath; ++inclPath) {
       TCling::AddIncludePath(*inclPath);
    }
@@ -2096,7 +2199,22 @@ void TCling::RegisterModule(const char* modulename,
       llvm::sys::path::remove_filename(pcmFileNameFullPath);
       llvm::sys::path::append(pcmFileNameFullPath,
                               ROOT::TMetaUtils::GetModuleFileName(modulename));
-      LoadPCM(pcmFileNameFullPath.str().str());
+      if (fLazyPCMs && classesHeaders && *classesHeaders && **classesHeaders) {
+         // Only remember which entities the PCM describes; it is loaded by
+         // LoadPendingPCMs() when one of them is looked up.
+         size_t index = fLazyPCMFiles.size();
+         fLazyPCMFiles.push_back(pcmFileNameFullPath.str().str());
+         ++fNPendingPCMs;
+         for (const char** classesHeader = classesHeaders; *classesHeader; ++classesHeader) {
+            fLazyPCMClasses.emplace(*classesHeader, index);
+            while (*classesHeader && strcmp(*classesHeader, "@"))
+               ++classesHeader;
+            if (!*classesHeader)
+               break;
+         }
+      } else {
+         LoadPCM(pcmFileNameFullPath.str().str());
+      }
    }
 
    { // scope within which diagnostics are de-activated
@@ -2416,6 +2534,47 @@ void TCling::PrintIntro()
 {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Print the time and the resident memory spent in each step of the
+/// initialization of the interpreter: its creation, the registration of the
+/// dictionaries and the loading of their PCMs. The steps are only recorded
+/// if Root.StartupReport is set in the .rootrc. By default only the steps
+/// taking more than 1 ms are listed, option "a" lists all of them.
+
+void TCling::PrintStartupReport(Option_t *option) const
+{
+   if (!fStartupReport) {
+      ::Info("TCling::PrintStartupReport", "Set Root.StartupReport in the .rootrc to record the startup steps.");
+      return;
+   }
+
+   const bool all = TString(option).Contains("a", TString::kIgnoreCase);
+   double totalTime = 0, pcmTime = 0;
+   Long_t totalMem = 0, pcmMem = 0;
+   int nPCMs = 0;
+   printf("%-64s %10s %12s\n", "Startup step", "time [ms]", "memory [kB]");
+   for (auto &record : fStartupRecords) {
+      // The PCMs loaded during a registration are already accounted for
+      // by the enclosing step, the lazily loaded ones by the PCM summary.
+      if (record.fWhat.compare(0, 11, "Loading of ") == 0) {
+         pcmTime += record.fTime;
+         pcmMem += record.fMemDelta;
+         ++nPCMs;
+      } else {
+         totalTime += record.fTime;
+         totalMem += record.fMemDelta;
+      }
+      if (all || record.fTime > 1e-3)
+         printf("%-64s %10.1f %12ld\n", record.fWhat.c_str(), 1e3 * record.fTime, record.fMemDelta);
+   }
+   printf("%-64s %10.1f %12ld\n", "Total", 1e3 * totalTime, totalMem);
+   printf("  of which %d PCMs loaded: %.1f ms, %ld kB\n", nPCMs, 1e3 * pcmTime, pcmMem);
+   if (fLazyPCMs) {
+      printf("  %lu of %lu PCMs registered in lazy mode not loaded\n", (unsigned long)fNPendingPCMs.load(),
+             (unsigned long)fLazyPCMFiles.size());
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add the given path to the list of directories in which the interpreter
 /// looks for include files. Only one path item can be specified at a
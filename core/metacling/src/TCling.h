@@ -26,6 +26,7 @@
 
 #include "TInterpreter.h"
 
+#include <atomic>
 #include <set>
 #include <unordered_set>
 #include <unordered_map>
@@ -215,6 +216,7 @@ public: // Public Interface
    Int_t   Load(const char* filenam, Bool_t system = kFALSE);
    void    LoadMacro(const char* filename, EErrorCode* error = 0);
    Int_t   LoadLibraryMap(const char* rootmapfile = 0);
+   Bool_t  LoadPendingPCMs(const char* classname = nullptr);
    Int_t   RescanLibraryMap();
    Int_t   ReloadAllSharedLibraryMaps();
    Int_t   UnloadAllSharedLibraryMaps();
@@ -223,6 +225,7 @@ public: // Public Interface
    Long_t  ProcessLineAsynch(const char* line, EErrorCode* error = 0);
    Long_t  ProcessLineSynch(const char* line, EErrorCode* error = 0);
    void    PrintIntro();
+   void    PrintStartupReport(Option_t* option = "") const;
    bool    RegisterPrebuiltModulePath(const std::string& FullPath,
                                       const std::string& ModuleMapName = "module.modulemap") const;
    void    RegisterModule(const char* modulename,
@@ -588,6 +591,19 @@ private: // Private Utility Functions and Classes
    void AddFriendToClass(clang::FunctionDecl*, clang::CXXRecordDecl*) const;
 
    std::map<std::string, llvm::StringRef> fPendingRdicts;
+   bool fLazyPCMs = false; // If true, RegisterModule only records the PCMs, see LoadPendingPCMs()
+   std::vector<std::string> fLazyPCMFiles; // PCMs registered in lazy mode, emptied once loaded
+   std::unordered_map<std::string, size_t> fLazyPCMClasses; // Class name -> index of its PCM in fLazyPCMFiles
+   std::atomic<size_t> fNPendingPCMs{0}; // Number of PCMs of fLazyPCMFiles not loaded yet, read without lock
+
+   struct StartupRecord_t {
+      std::string fWhat;   // Description of the step
+      double fTime;        // Wall time spent in the step, in seconds
+      Long_t fMemDelta;    // Change of the resident memory during the step, in kB
+   };
+   class StartupStepRAII;
+   bool fStartupReport = false; // If true, the initialization steps are timed, see PrintStartupReport()
+   std::vector<StartupRecord_t> fStartupRecords; // Timing of the initialization steps
    friend void TCling__RegisterRdictForLoadPCM(const std::string &pcmFileNameFullPath, llvm::StringRef *pcmContent);
    void RegisterRdictForLoadPCM(const std::string &pcmFileNameFullPath, llvm::StringRef *pcmContent);
    void LoadPCM(std::string pcmFileNameFullPath);
@@ -0,0 +1,25 @@
+#ifndef ROOT_LazyPCM
+#define ROOT_LazyPCM
+
+/**
+ * Inputs of the lazy PCM test: each dictionary selects one entity to look up
+ * and one marker enum, which is in the list of enums once its PCM is loaded.
+ */
+
+class LazyPCMClass {
+public:
+   int fValue = 0;
+};
+enum ELazyPCMClassMarker { kLazyPCMClassMarker };
+
+enum ELazyPCMEnum { kLazyPCMEnumOne, kLazyPCMEnumTwo };
+enum ELazyPCMEnumMarker { kLazyPCMEnumMarker };
+
+class LazyPCMTypedefTarget {
+public:
+   int fValue = 0;
+};
+typedef LazyPCMTypedefTarget LazyPCMTypedef;
+enum ELazyPCMTypedefMarker { kLazyPCMTypedefMarker };
+
+#endif
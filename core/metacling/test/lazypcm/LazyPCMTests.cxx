@@ -0,0 +1,56 @@
+#include "TClass.h"
+#include "TDataType.h"
+#include "TEnum.h"
+#include "THashList.h"
+#include "TInterpreter.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+// The .rootrc of the test directory sets Root.LazyPCM and Root.StartupReport.
+
+// Whether the PCM selecting the marker enum was loaded: the PCMs add their
+// enums to the list of enums, which is searched without asking the interpreter.
+static bool IsPCMLoaded(const char *marker)
+{
+   auto listOfEnums = dynamic_cast<THashList *>(gROOT->GetListOfEnums());
+   return listOfEnums && listOfEnums->THashList::FindObject(marker);
+}
+
+TEST(LazyPCM, ClassLookup)
+{
+   ASSERT_FALSE(IsPCMLoaded("ELazyPCMClassMarker"));
+   EXPECT_NE(nullptr, TClass::GetClass("LazyPCMClass"));
+   EXPECT_TRUE(IsPCMLoaded("ELazyPCMClassMarker"));
+}
+
+TEST(LazyPCM, EnumLookup)
+{
+   ASSERT_FALSE(IsPCMLoaded("ELazyPCMEnumMarker"));
+   // Without interpreter lookup, only the PCM can provide the enum.
+   TEnum *en = TEnum::GetEnum("ELazyPCMEnum", TEnum::kNone);
+   ASSERT_NE(nullptr, en);
+   EXPECT_EQ(2, en->GetConstants()->GetSize());
+   EXPECT_TRUE(IsPCMLoaded("ELazyPCMEnumMarker"));
+}
+
+TEST(LazyPCM, TypedefLookup)
+{
+   ASSERT_FALSE(IsPCMLoaded("ELazyPCMTypedefMarker"));
+   TDataType *type = gROOT->GetType("LazyPCMTypedef");
+   ASSERT_NE(nullptr, type);
+   EXPECT_STREQ("LazyPCMTypedefTarget", type->GetFullTypeName());
+   EXPECT_TRUE(IsPCMLoaded("ELazyPCMTypedefMarker"));
+}
+
+TEST(LazyPCM, StartupReport)
+{
+   testing::internal::CaptureStdout();
+   gInterpreter->PrintStartupReport("a");
+   const std::string report = testing::internal::GetCapturedStdout();
+   EXPECT_NE(std::string::npos, report.find("Creation of the interpreter"));
+   EXPECT_NE(std::string::npos, report.find("Registration of "));
+   EXPECT_NE(std::string::npos, report.find("PCMs registered in lazy mode not loaded"));
+}
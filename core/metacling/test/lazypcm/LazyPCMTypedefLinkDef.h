@@ -0,0 +1,10 @@
+#ifdef __CINT__
+
+#pragma link off all globals;
+#pragma link off all classes;
+#pragma link off all functions;
+
+#pragma link C++ typedef LazyPCMTypedef;
+#pragma link C++ enum ELazyPCMTypedefMarker;
+
+#endif
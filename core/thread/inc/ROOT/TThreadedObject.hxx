@@ -108,6 +108,32 @@ namespace ROOT {
             }
          };
 
+         /// Merge objs[1], objs[2], ... into objs[0] as a binary tree of pairwise
+         /// merges: at each level, objs[i] absorbs objs[i + step] for all the i
+         /// multiple of 2 * step, in parallel on the implicit multi-threading pool.
+         /// The objects other than objs[0] are modified. Without implicit
+         /// multi-threading, all the objects are merged into objs[0] at once.
+         template<class T>
+         void TreeMerge(const std::vector<T *> &objs)
+         {
+            const auto n = objs.size();
+            if (n < 3 || !ROOT::IsImplicitMTEnabled()) {
+               TList l;
+               for (size_t i = 1; i < n; ++i)
+                  l.Add(objs[i]);
+               if (n > 1)
+                  objs[0]->Merge(&l);
+               return;
+            }
+            for (size_t step = 1; step < n; step *= 2) {
+               ROOT::Internal::ParallelFor((n + step - 1) / (2 * step), [&objs, step](UInt_t k) {
+                  TList l;
+                  l.Add(objs[2 * step * k + step]);
+                  objs[2 * step * k]->Merge(&l);
+               });
+            }
+         }
+
       } // End of namespace TThreadedObjectUtils
    } // End of namespace Internals
 
@@ -127,6 +153,20 @@ namespace ROOT {
          }
          target->Merge(&objTList);
       }
+
+      /// Merge TObjects pairwise, in parallel when the implicit multi-threading
+      /// is enabled (see Internal::TThreadedObjectUtils::TreeMerge). Unlike
+      /// MergeTObjects, the objects in objs other than target are modified.
+      template<class T>
+      void TreeMergeTObjects(std::shared_ptr<T> target, std::vector<std::shared_ptr<T>> &objs)
+      {
+         if (!target) return;
+         std::vector<T *> toMerge{target.get()};
+         for (auto &obj : objs) {
+            if (obj && obj != target) toMerge.push_back(obj.get());
+         }
+         Internal::TThreadedObjectUtils::TreeMerge(toMerge);
+      }
    } // end of namespace TThreadedObjectUtils
 
    /**
@@ -239,8 +279,9 @@ namespace ROOT {
 
       /// Merge all the thread private objects. Can be called once: it does not
       /// create any new object but destroys the present bookkeping collapsing
-      /// all objects into the one at slot 0.
-      std::shared_ptr<T> Merge(TThreadedObjectUtils::MergeFunctionType<T> mergeFunction = TThreadedObjectUtils::MergeTObjects<T>)
+      /// all objects into the one at slot 0. By default the objects are merged
+      /// pairwise, in parallel if the implicit multi-threading is enabled.
+      std::shared_ptr<T> Merge(TThreadedObjectUtils::MergeFunctionType<T> mergeFunction = TThreadedObjectUtils::TreeMergeTObjects<T>)
       {
          // We do not return if we already merged.
          if (fIsMerged) {
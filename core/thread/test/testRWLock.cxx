@@ -14,6 +14,10 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace ROOT;
 
 void testWriteLockV(TVirtualMutex *m, size_t repetition)
@@ -566,3 +570,61 @@ TEST(RWLock, LargeconcurrentReadsAndWritesTL)
 {
    concurrentReadsAndWrites(gRWMutexTL, 10, 20, gRepetition / 10000);
 }
+
+TEST(RWLock, LockProfiling)
+{
+   TMutex mutex;
+   auto profiledLock = [&](size_t repetition) {
+      for (size_t i = 0; i < repetition; ++i) {
+         R__LOCKGUARD(&mutex);
+      }
+   };
+   auto profiledReadWrite = [&](size_t repetition) {
+      for (size_t i = 0; i < repetition; ++i) {
+         {
+            R__READ_LOCKGUARD(gRWMutexStd);
+         }
+         R__WRITE_LOCKGUARD(gRWMutexStd);
+      }
+   };
+
+   profiledLock(10); // not recorded
+
+   ROOT::EnableLockProfiling();
+   std::vector<std::thread> threads;
+   for (int i = 0; i < 4; ++i) {
+      threads.emplace_back(profiledLock, 1000);
+      threads.emplace_back(profiledReadWrite, 100);
+   }
+   for (auto &t : threads)
+      t.join();
+   ROOT::DisableLockProfiling();
+
+   std::string profile = ROOT::GetLockProfile();
+   EXPECT_NE(std::string::npos, profile.find("\"mutex\": \"&mutex\", \"kind\": \"lock\", \"count\": 4000,"));
+   EXPECT_NE(std::string::npos, profile.find("\"mutex\": \"gRWMutexStd\", \"kind\": \"read\", \"count\": 400,"));
+   EXPECT_NE(std::string::npos, profile.find("\"mutex\": \"gRWMutexStd\", \"kind\": \"write\", \"count\": 400,"));
+
+   ROOT::ResetLockProfile();
+   EXPECT_EQ(std::string::npos, ROOT::GetLockProfile().find("gRWMutexStd"));
+}
+
+TEST(RWLock, LockProfileDestroyedSite)
+{
+   ROOT::ResetLockProfile();
+   std::string file = "LockProfileDestroyedSite.cxx";
+   std::string mutexName = "gDestroyedSiteMutex";
+   auto site = new ROOT::Internal::TLockSite(file.c_str(), 42, mutexName.c_str(), "lock");
+   site->Record(10, 20);
+   // The site keeps its own copy of the strings.
+   file = "overwritten";
+   mutexName = "overwritten";
+   EXPECT_NE(std::string::npos, ROOT::GetLockProfile().find("\"file\": \"LockProfileDestroyedSite.cxx\", \"line\": 42"));
+
+   // The statistics of a destroyed site are kept until the next reset.
+   delete site;
+   std::string profile = ROOT::GetLockProfile();
+   EXPECT_NE(std::string::npos, profile.find("\"mutex\": \"gDestroyedSiteMutex\", \"kind\": \"lock\", \"count\": 1,"));
+   ROOT::ResetLockProfile();
+   EXPECT_EQ(std::string::npos, ROOT::GetLockProfile().find("gDestroyedSiteMutex"));
+}
@@ -0,0 +1,92 @@
+#include "TDirectory.h"
+#include "TH1F.h"
+#include "TH2S.h"
+#include "TH3C.h"
+#include "THashList.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(TDirectoryThreads, ConcurrentRegistration)
+{
+   ROOT::EnableThreadSafety();
+
+   const int nThreads = 4;
+   const int nHistos = 500;
+
+   // Each thread books in its own directory and in a shared one.
+   TDirectory shared("shared", "shared");
+   std::vector<std::unique_ptr<TDirectory>> dirs;
+   for (int t = 0; t < nThreads; ++t)
+      dirs.emplace_back(new TDirectory(("dir" + std::to_string(t)).c_str(), ""));
+   ASSERT_TRUE(shared.GetList()->IsUsingLocalLock());
+
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&, t]() {
+         for (int i = 0; i < nHistos; ++i) {
+            std::string name = "h" + std::to_string(t) + "_" + std::to_string(i);
+            dirs[t]->cd();
+            new TH1F(name.c_str(), "", 10, 0, 1);
+            shared.cd();
+            new TH1F(("s" + name).c_str(), "", 10, 0, 1);
+            EXPECT_NE(nullptr, shared.FindObject(("s" + name).c_str()));
+         }
+         // Deleting a histogram unregisters it from its directory.
+         for (int i = 0; i < nHistos; i += 2)
+            delete dirs[t]->FindObject(("h" + std::to_string(t) + "_" + std::to_string(i)).c_str());
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+
+   EXPECT_EQ(nThreads * nHistos, shared.GetList()->GetSize());
+   for (int t = 0; t < nThreads; ++t) {
+      EXPECT_EQ(nHistos / 2, dirs[t]->GetList()->GetSize());
+      EXPECT_EQ(nullptr, dirs[t]->FindObject(("h" + std::to_string(t) + "_0").c_str()));
+      EXPECT_NE(nullptr, dirs[t]->FindObject(("h" + std::to_string(t) + "_1").c_str()));
+   }
+   gROOT->cd();
+}
+
+TEST(TDirectoryThreads, FirstObjectOfNewClass)
+{
+   ROOT::EnableThreadSafety();
+
+   const int nThreads = 4;
+
+   // Hashing the first object of a class checks the consistency of the class,
+   // which takes the global lock for writing: it must not happen under the
+   // lock of the directory's list, which the other threads wait for while
+   // holding the global lock for reading.
+   TDirectory shared("sharedNew", "sharedNew");
+   std::atomic<int> ready(0);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&, t]() {
+         ++ready;
+         while (ready < nThreads) {
+         }
+         std::string name = std::to_string(t);
+         shared.cd();
+         new TH2S(("h2_" + name).c_str(), "", 10, 0, 1, 10, 0, 1);
+         EXPECT_NE(nullptr, shared.FindObject(("h2_" + name).c_str()));
+         new TH3C(("h3_" + name).c_str(), "", 5, 0, 1, 5, 0, 1, 5, 0, 1);
+         EXPECT_NE(nullptr, shared.FindObject(("h3_" + name).c_str()));
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+
+   EXPECT_EQ(2 * nThreads, shared.GetList()->GetSize());
+   delete shared.FindObject("h2_0");
+   EXPECT_EQ(nullptr, shared.FindObject("h2_0"));
+   EXPECT_EQ(2 * nThreads - 1, shared.GetList()->GetSize());
+   gROOT->cd();
+}
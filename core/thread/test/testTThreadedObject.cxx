@@ -126,3 +126,28 @@ TEST(TThreadedObject, SnapshotMerge)
    IsSameHist(*hsum1, *hsum0);
    EXPECT_TRUE(hsum1 != hsum0);
 }
+
+#ifdef R__USE_IMT
+TEST(TThreadedObject, TreeMerge)
+{
+   TH1::AddDirectory(false);
+   ROOT::EnableImplicitMT(4);
+
+   const int nSlots = 7;
+   TH1F m0("h", "h", 64, -4, 4);
+   ROOT::TThreadedObject<TH1F> tto("h", "h", 64, -4, 4);
+   tto->SetName("h");
+   gRandom->SetSeed(1);
+   for (int i = 0; i < nSlots; ++i) {
+      if (i)
+         tto.SetAtSlot(i, std::make_shared<TH1F>("h", "h", 64, -4, 4));
+      tto.GetAtSlot(i)->FillRandom("gaus", 100);
+      m0.Add(tto.GetAtSlot(i).get());
+   }
+   auto hsum = tto.Merge();
+   IsSameHist(*hsum, m0);
+   EXPECT_EQ(nSlots * 100, hsum->GetEntries());
+
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -741,6 +741,38 @@ Bool_t TH1Merger::BufferMerge()
    return kFALSE; 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bin contents and errors of hist to fH0 when both store their
+/// contents in a ARRAY, without going through the virtual bin accessors.
+/// Return false if the histograms are not of that kind.
+
+template <typename ARRAY>
+Bool_t TH1Merger::AddArrays(const TH1 *hist)
+{
+   ARRAY *dst = dynamic_cast<ARRAY *>(fH0);
+   const ARRAY *src = dynamic_cast<const ARRAY *>(hist);
+   if (!dst || !src || dst->fN != src->fN)
+      return kFALSE;
+
+   const Int_t n = src->fN;
+   for (Int_t ibin = 0; ibin < n; ibin++)
+      dst->fArray[ibin] += src->fArray[ibin];
+
+   if (fH0->fSumw2.fN) {
+      Double_t *sumw2 = fH0->fSumw2.fArray;
+      if (hist->fSumw2.fN) {
+         const Double_t *hsumw2 = hist->fSumw2.fArray;
+         for (Int_t ibin = 0; ibin < n; ibin++)
+            sumw2[ibin] += hsumw2[ibin];
+      } else {
+         // Like GetBinErrorSqUnchecked: the content itself, even if negative
+         for (Int_t ibin = 0; ibin < n; ibin++)
+            sumw2[ibin] += src->fArray[ibin];
+      }
+   }
+   return kTRUE;
+}
+
 Bool_t TH1Merger::SameAxesMerge() { 
 
 
@@ -768,6 +800,15 @@ Bool_t TH1Merger::SameAxesMerge() {
          totstats[i] += stats[i];
       nentries += hist->GetEntries();
 
+      // fast path for histograms of the same type: add the bin arrays directly
+      TClass *cl = fH0->IsA();
+      if (hist->IsA() == cl && hist->fNcells == fH0->fNcells) {
+         if ((cl == TH1D::Class() || cl == TH2D::Class() || cl == TH3D::Class()) && AddArrays<TArrayD>(hist))
+            continue;
+         if ((cl == TH1F::Class() || cl == TH2F::Class() || cl == TH3F::Class()) && AddArrays<TArrayF>(hist))
+            continue;
+      }
+
          //Int_t nx = hist->GetXaxis()->GetNbins();
          // loop on bins of the histogram and do the merge
       for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
@@ -95,6 +95,9 @@ private:
 
    Bool_t AutoP2Merge();
 
+   template <typename ARRAY>
+   Bool_t AddArrays(const TH1 *hist);
+
    Bool_t SameAxesMerge();
 
    Bool_t DifferentAxesMerge();
@@ -2,6 +2,8 @@
 
 #include "TH1.h"
 #include "TH1F.h"
+#include "TH1D.h"
+#include "TList.h"
 
 // StatOverflows TH1
 TEST(TH1, StatOverflows)
@@ -30,3 +32,49 @@ TEST(TH1, StatOverflows)
    EXPECT_EQ(TH1::EStatOverflows::kConsider, h1.GetStatOverflows());
    EXPECT_EQ(TH1::EStatOverflows::kNeutral,  h2.GetStatOverflows());
 }
+
+// The merge of histograms of the same class adds their arrays directly: it must
+// give the same result as the generic merge, used here for a TH1F into a TH1D.
+TEST(TH1, MergeSameClassAsGeneric)
+{
+   for (bool sourceSumw2 : {false, true}) {
+      TH1D fast("fast", "fast", 10, 0, 10);
+      TH1D generic("generic", "generic", 10, 0, 10);
+      TH1D sourceD("sourceD", "sourceD", 10, 0, 10);
+      TH1F sourceF("sourceF", "sourceF", 10, 0, 10);
+      fast.Sumw2();
+      generic.Sumw2();
+      if (sourceSumw2) {
+         sourceD.Sumw2();
+         sourceF.Sumw2();
+      }
+      for (int bin = 0; bin <= 11; ++bin) {
+         fast.Fill(bin - 0.5, 0.5);
+         generic.Fill(bin - 0.5, 0.5);
+         // Negative weights
+         const double content = (bin % 3 == 0) ? -1.5 : 2.;
+         sourceD.SetBinContent(bin, content);
+         sourceF.SetBinContent(bin, content);
+         if (sourceSumw2) {
+            sourceD.SetBinError(bin, 0.5 * bin);
+            sourceF.SetBinError(bin, 0.5 * bin);
+         }
+      }
+      sourceD.SetEntries(12);
+      sourceF.SetEntries(12);
+
+      TList fastList;
+      fastList.Add(&sourceD);
+      fast.Merge(&fastList);
+      TList genericList;
+      genericList.Add(&sourceF);
+      generic.Merge(&genericList);
+
+      for (int bin = 0; bin <= 11; ++bin) {
+         EXPECT_DOUBLE_EQ(generic.GetBinContent(bin), fast.GetBinContent(bin)) << "bin " << bin;
+         // The sum of the squares of the weights may be negative: compare it, not its root
+         EXPECT_DOUBLE_EQ(generic.GetSumw2()->At(bin), fast.GetSumw2()->At(bin)) << "bin " << bin;
+      }
+      EXPECT_EQ(generic.GetEntries(), fast.GetEntries());
+   }
+}
@@ -246,6 +246,13 @@ Bool_t TDCacheFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 
 Bool_t TDCacheFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
 {
+   Int_t st;
+   if ((st = ReadBuffersViaBlockCache(buf, pos, len, nbuf))) {
+      if (st == 2)
+         return kTRUE;
+      return kFALSE;
+   }
+
 #ifdef _IOVEC2_
 
    iovec2 *vector;
@@ -15,10 +15,12 @@
 #include "TFileMerger.h"
 #include "TMemFile.h"
 
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -70,6 +72,40 @@ public:
    /** Returns the number of buffers currently in the queue. */
    size_t GetQueueSize() const;
 
+   /** Returns the largest number of buffers that were in the queue at the same time. */
+   size_t GetMaxQueueSize() const;
+
+   /** Returns the number of bytes currently queued or being merged. */
+   size_t GetBufferedBytes() const;
+
+   /** Returns the number of merges done so far. */
+   size_t GetNMerges() const;
+
+   /** Returns the duration in seconds of the last merge, from the moment the
+    *  buffers were taken from the queue until they were written to the output. */
+   double GetLastMergeLatency() const;
+
+   /** Returns the total time in seconds spent merging. */
+   double GetTotalMergeTime() const;
+
+   /** Returns the number of merges whose buffers were merged concurrently,
+    *  see SetMergeConcurrency(). */
+   size_t GetNConcurrentMerges() const;
+
+   /** Returns the total time in seconds producers spent blocked in
+    *  TBufferMergerFile::Write() because of the memory budget. */
+   double GetTotalBlockedTime() const;
+
+   /** Returns the number of TBufferMergerFile::Write() calls that blocked
+    *  because of the memory budget. */
+   size_t GetNBlocked() const;
+
+   /** Returns the memory budget in bytes (default = 0, no limit). */
+   size_t GetMaxBufferedBytes() const;
+
+   /** Returns the number of groups of buffers merged concurrently (default = 0). */
+   size_t GetMergeConcurrency() const;
+
    /** Returns the current value of the auto save setting in bytes (default = 0). */
    size_t GetAutoSave() const;
 
@@ -86,6 +122,21 @@ public:
     */
    void SetAutoSave(size_t size);
 
+   /** Limits the memory used by the buffers written by the TBufferMergerFiles
+    *  and not yet merged into the output to about size bytes. A
+    *  TBufferMergerFile::Write() that would exceed the budget performs the
+    *  pending merge itself or, if another thread is already merging, blocks
+    *  until that merge is done. A value of 0 (the default) means no limit.
+    */
+   void SetMaxBufferedBytes(size_t size);
+
+   /** When the implicit multi-threading is enabled and n > 1, the buffers
+    *  taken from the queue by a merge are split in up to n groups that are
+    *  merged (and recompressed if needed) concurrently into intermediate
+    *  in-memory files, which are then merged in order into the output file.
+    */
+   void SetMergeConcurrency(size_t n);
+
    /** Sets the merge options. SetMergeOptions("fast") will disable
     * recompression of input data into the output if they have different
     * compression settings.
@@ -108,13 +159,26 @@ private:
    void Init(std::unique_ptr<TFile>);
 
    void Merge();
+   bool MergeGroups(std::vector<std::unique_ptr<TBufferFile>> &buffers);
    void Push(TBufferFile *buffer);
 
    size_t fAutoSave{0};                                          //< AutoSave only every fAutoSave bytes
    size_t fBuffered{0};                                          //< Number of bytes currently buffered
+   size_t fMerging{0};                                           //< Number of bytes taken by the running merge
+   size_t fMaxBuffered{0};                                       //< Memory budget of fBuffered + fMerging
+   size_t fMergeConcurrency{0};                                  //< Number of groups of buffers merged concurrently
+   bool fMergeRunning{false};                                    //< Whether a merge is running
+   size_t fMaxQueueSize{0};                                      //< Largest number of buffers in fQueue
+   size_t fNMerges{0};                                           //< Number of merges done
+   size_t fNConcurrentMerges{0};                                 //< Number of merges done concurrently
+   double fLastMergeLatency{0};                                  //< Duration of the last merge in seconds
+   double fMergeTime{0};                                         //< Total time spent merging in seconds
+   double fBlockedTime{0};                                       //< Total time producers were blocked in seconds
+   size_t fNBlocked{0};                                          //< Number of times producers were blocked
    TFileMerger fMerger{false, false};                            //< TFileMerger used to merge all buffers
    std::mutex fMergeMutex;                                       //< Mutex used to lock fMerger
-   std::mutex fQueueMutex;                                       //< Mutex used to lock fQueue
+   mutable std::mutex fQueueMutex;                               //< Mutex used to lock fQueue and the counters
+   std::condition_variable fMergeDone;                           //< Signaled when a merge frees memory
    std::queue<TBufferFile *> fQueue;                             //< Queue to which data is pushed and merged
    std::vector<std::weak_ptr<TBufferMergerFile>> fAttachedFiles; //< Attached files
 };
@@ -44,10 +44,19 @@ protected:
    Long64_t    fSeekKeys{0};             ///< Location of Keys record on file
    TFile      *fFile{nullptr};           ///< Pointer to current file in memory
    TList      *fKeys{nullptr};           ///< Pointer to keys list in memory
+   mutable Bool_t fKeysLazy{kFALSE};     ///<! True while fKeys only holds the keys looked up through the index of the keys record
+   Int_t       fNkeysOnFile{0};          ///<! Number of keys in the indexed keys record
+   Int_t       fNbucketsIndex{0};        ///<! Number of buckets of the index of the keys record
+   Int_t       fOffsetBuckets{0};        ///<! Offset of the buckets of the index in the keys record
+   Int_t       fOffsetEntries{0};        ///<! Offset of the entries of the index in the keys record
 
    void        CleanTargets();
    void        InitDirectoryFile(TClass *cl = nullptr);
    void        BuildDirectoryFile(TFile* motherFile, TDirectory* motherDir);
+   const TList *GetKeysForName(const char *name) const;
+   void        LoadAllKeys() const;
+   Int_t       ReadIndexedKeys(const char *name) const;
+   Bool_t      ReadKeysIndex(Version_t versiondir);
 
 private:
    TDirectoryFile(const TDirectoryFile &directory) = delete;  //Directories cannot be copied
@@ -93,10 +102,10 @@ public:
    const TDatime      &GetCreationDate() const { return fDatimeC; }
            TFile      *GetFile() const override { return fFile; }
            TKey       *GetKey(const char *name, Short_t cycle=9999) const override;
-           TList      *GetListOfKeys() const override { return fKeys; }
+           TList      *GetListOfKeys() const override { if (fKeysLazy) LoadAllKeys(); return fKeys; }
    const TDatime      &GetModificationDate() const { return fDatimeM; }
            Int_t       GetNbytesKeys() const override { return fNbytesKeys; }
-           Int_t       GetNkeys() const override { return fKeys->GetSize(); }
+           Int_t       GetNkeys() const override { return fKeysLazy ? fNkeysOnFile : fKeys->GetSize(); }
            Long64_t    GetSeekDir() const override { return fSeekDir; }
            Long64_t    GetSeekParent() const override { return fSeekParent; }
            Long64_t    GetSeekKeys() const override { return fSeekKeys; }
@@ -130,7 +139,7 @@ public:
            void        WriteDirHeader() override;
            void        WriteKeys() override;
 
-   ClassDefOverride(TDirectoryFile,5)  //Describe directory structure in a ROOT file
+   ClassDefOverride(TDirectoryFile,6)  //Describe directory structure in a ROOT file
 };
 
 #endif
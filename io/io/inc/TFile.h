@@ -44,10 +44,12 @@ class TFileCacheWrite;
 class TProcessID;
 class TStopwatch;
 class TFilePrefetch;
+class TFileBlockCache;
 
 class TFile : public TDirectoryFile {
   friend class TDirectoryFile;
   friend class TFilePrefetch;
+  friend class TFileBlockCache;
 // TODO: We need to make sure only one TBasket is being written at a time
 // if we are writing multiple baskets in parallel.
 #ifdef R__USE_IMT
@@ -98,6 +100,7 @@ protected:
    Bool_t           fNoAnchorInName{kFALSE};  ///<!True if we don't want to force the anchor to be appended to the file name
    Bool_t           fIsRootFile{kTRUE};       ///<!True is this is a ROOT file, raw file otherwise
    Bool_t           fInitDone{kFALSE};        ///<!True if the file has been initialized
+   Bool_t           fUseBlockCache{kFALSE};   ///<!True if the reads go through TFileBlockCache::GetGlobal()
    Bool_t           fMustFlush{kTRUE};        ///<!True if the file buffers must be flushed
    Bool_t           fIsPcmFile{kFALSE};       ///<!True if the file is a ROOT pcm file.
    TFileOpenHandle *fAsyncHandle{nullptr};    ///<!For proper automatic cleanup
@@ -132,6 +135,8 @@ protected:
    virtual void        Init(Bool_t create);
            Bool_t      FlushWriteCache();
            Int_t       ReadBufferViaCache(char *buf, Int_t len);
+           Int_t       ReadBufferViaBlockCache(char *buf, Int_t len);
+           Int_t       ReadBuffersViaBlockCache(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf);
            Int_t       WriteBufferViaCache(const char *buf, Int_t len);
 
    ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,76 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TFileBlockCache
+#define ROOT_TFileBlockCache
+
+#include "TObject.h"
+#include "TString.h"
+
+#include <atomic>
+#include <mutex>
+
+class TFile;
+
+class TFileBlockCache : public TObject {
+
+private:
+   TFileBlockCache(const TFileBlockCache&) = delete;
+   TFileBlockCache& operator=(const TFileBlockCache&) = delete;
+
+   TString   fDirectory;                      ///< Cache directory, shared by all the processes of the node
+   Long64_t  fMaxSize;                        ///< Size above which the least recently used blocks are evicted
+   Int_t     fBlockSize;                      ///< Size of the blocks, aligned on multiples of it in the files
+   Long64_t  fUsage;                          ///<! Estimated size of the cache directory
+   Long64_t  fWrittenSinceScan;               ///<! Bytes written by this process since the last scan
+   std::mutex fUsageMutex;                    ///<! Protects fUsage and fWrittenSinceScan
+   std::atomic<Long64_t> fHits;               ///<! Number of blocks found in the cache
+   std::atomic<Long64_t> fMisses;             ///<! Number of blocks not found in the cache
+   std::atomic<Long64_t> fBytesHit;           ///<! Bytes read from the cache
+   std::atomic<Long64_t> fBytesMissed;        ///<! Bytes that had to be read from the original file
+   std::atomic<Long64_t> fBytesEvicted;       ///<! Bytes removed from the cache by this process
+
+   static TFileBlockCache *fgGlobal;          ///< Cache used by the remote files, see GetGlobal()
+
+   TString   GetBlockPath(TFile *file, Long64_t index) const;
+   Bool_t    ReadBlock(const char *path, char *buf, Int_t len);
+   Bool_t    WriteBlock(const char *path, const char *buf, Int_t len);
+   Long64_t  Scan(Long64_t target, const char *keep);
+   Long64_t  ShrinkImpl(Long64_t size, const char *keep);
+
+public:
+   enum { kDefaultBlockSize = 1024 * 1024 };
+
+   TFileBlockCache(const char *directory, Long64_t maxSize = 0, Int_t blockSize = kDefaultBlockSize);
+   virtual ~TFileBlockCache() {}
+
+   Bool_t    ReadBuffers(TFile *file, char *buf, const Long64_t *pos, const Int_t *len, Int_t nbuf);
+   Long64_t  Shrink(Long64_t size);
+
+   const char *GetDirectory() const { return fDirectory; }
+   Long64_t  GetMaxSize() const { return fMaxSize; }
+   Int_t     GetBlockSize() const { return fBlockSize; }
+   Long64_t  GetHits() const { return fHits; }
+   Long64_t  GetMisses() const { return fMisses; }
+   Long64_t  GetBytesHit() const { return fBytesHit; }
+   Long64_t  GetBytesMissed() const { return fBytesMissed; }
+   Long64_t  GetBytesEvicted() const { return fBytesEvicted; }
+   Double_t  GetHitRate() const;
+   Bool_t    IsValid() const { return !fDirectory.IsNull(); }
+   virtual void Print(Option_t *option = "") const;
+   void      ResetStatistics();
+
+   static TFileBlockCache *GetGlobal();
+   static Bool_t SetGlobal(const char *directory, Long64_t maxSize = 0, Int_t blockSize = kDefaultBlockSize);
+
+   ClassDef(TFileBlockCache, 0) // Node-level disk cache of the blocks read from remote files
+};
+
+#endif
@@ -54,6 +54,7 @@ protected:
    TString        fObjectNames;               ///< List of object names to be either merged exclusively or skipped
    TList          fMergeList;                 ///< list of TObjString containing the name of the files need to be merged
    TList          fExcessFiles;               ///<! List of TObjString containing the name of the files not yet added to fFileList due to user or system limitiation on the max number of files opened.
+   Int_t          fMaxObjectsInFlight{1000};  ///< Maximum number of objects read and not yet written when merging keys concurrently
 
    Bool_t         OpenExcessFiles();
    virtual Bool_t AddFile(TFile *source, Bool_t own, Bool_t cpProgress);
@@ -86,6 +87,8 @@ public:
    TFile      *GetOutputFile() const { return fOutputFile; }
    Int_t       GetMaxOpenedFiles() const { return fMaxOpenedFiles; }
    void        SetMaxOpenedFiles(Int_t newmax);
+   Int_t       GetMaxObjectsInFlight() const { return fMaxObjectsInFlight; }
+   void        SetMaxObjectsInFlight(Int_t newmax) { fMaxObjectsInFlight = newmax; }
    const char *GetMsgPrefix() const { return fMsgPrefix; }
    void        SetMsgPrefix(const char *prefix);
    const char *GetMergeOptions() { return fMergeOptions; }
@@ -117,7 +120,7 @@ public:
    virtual void   SetNotrees(Bool_t notrees=kFALSE) {fNoTrees = notrees;}
    virtual void        RecursiveRemove(TObject *obj);
 
-   ClassDef(TFileMerger, 6)  // File copying and merging services
+   ClassDef(TFileMerger, 7)  // File copying and merging services
 };
 
 #endif
@@ -25,8 +25,11 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 
+class TFileBlockCache;
+
 
 class TFilePrefetch : public TObject {
 
@@ -44,6 +47,7 @@ private:
    TStopwatch  fWaitTime;          // time wating to prefetch a buffer (in usec)
    Bool_t      fThreadJoined;      // mark if async thread was joined
    std::atomic<Bool_t> fPrefetchFinished;  // true if prefetching is over
+   std::unique_ptr<TFileBlockCache> fBlockCache; //! disk cache of the blocks, see SetCache()
 
    static TThread::VoidRtnFunc_t ThreadProc(void*);  //create a joinable worker thread
 
@@ -51,7 +55,7 @@ public:
    TFilePrefetch(TFile*);
    virtual ~TFilePrefetch();
 
-   void      ReadAsync(TFPBlock*, Bool_t&);
+   Bool_t    ReadAsync(TFPBlock*, Bool_t&);
    void      ReadListOfBlocks();
 
    void      AddPendingBlock(TFPBlock*);
@@ -66,9 +70,6 @@ public:
    Int_t     ThreadStart();
 
    Bool_t    SetCache(const char*);
-   Bool_t    CheckBlockInCache(char*&, TFPBlock*);
-   char     *GetBlockFromCache(const char*, Int_t);
-   void      SaveBlockInCache(TFPBlock*);
 
    Int_t     SumHex(const char*);
    Bool_t    BinarySearchReadList(TFPBlock*, Long64_t, Int_t, Int_t*);
@@ -13,6 +13,7 @@
 #define ROOT_TStreamerInfo
 
 #include <atomic>
+#include <string>
 
 #include "TVirtualStreamerInfo.h"
 
@@ -69,6 +70,9 @@ public:
    // make the opaque pointer public.
    typedef TCompInfo TCompInfo_t;
 
+   /// Signature of the natively compiled streamers (see JitCompile)
+   typedef void (*JitStreamer_t)(TBuffer &b, char *obj, TStreamerInfo *info, TCompInfo_t *const *compinfo);
+
 protected:
    //---------------------------------------------------------------------------
    // Adapter class used to handle streaming collection of pointers
@@ -114,6 +118,11 @@ private:
    TStreamerInfoActions::TActionSequence *fWriteMemberWise;       ///<! List of write action resulting from the compilation for use in member wise streaming.
    TStreamerInfoActions::TActionSequence *fWriteMemberWiseVecPtr; ///<! List of write action resulting from the compilation for use in member wise streaming.
    TStreamerInfoActions::TActionSequence *fWriteText;             ///<! List of text write action resulting for the compilation, used for JSON.
+   std::atomic<Int_t> fJitState;         ///<! Whether the natively compiled streamers are requested, pending or done (see EJitState).
+   JitStreamer_t     fJitReader;         ///<! Natively compiled replacement of fReadObjectWise, if any.
+   JitStreamer_t     fJitWriter;         ///<! Natively compiled replacement of fWriteObjectWise, if any.
+
+   enum EJitState { kJitOff = 0, kJitPending = 1, kJitDone = 2 };
 
    static std::atomic<Int_t>             fgCount;     ///<Number of TStreamerInfo instances
 
@@ -124,6 +133,8 @@ private:
    void              GenerateDeclaration(FILE *fp, FILE *sfp, const TList *subClasses, Bool_t top = kTRUE);
    void              InsertArtificialElements(std::vector<const ROOT::TSchemaRule*> &rules);
    void              DestructorImpl(void* p, Bool_t dtorOnly);
+   Bool_t            GenerateJitStreamers(std::string &readBody, std::string &writeBody) const;
+   static Bool_t     IsJitRequested(const TClass *cl);
 
 private:
    TStreamerInfo(const TStreamerInfo&) = delete;            // TStreamerInfo are not copiable.  Not Implemented.
@@ -239,6 +250,12 @@ public:
    Double_t            GetValueClones(TClonesArray *clones, Int_t i, Int_t j, Int_t k, Int_t eoffset) const { return GetTypedValueClones<Double_t>(clones, i, j, k, eoffset); }
    Double_t            GetValueSTL(TVirtualCollectionProxy *cont, Int_t i, Int_t j, Int_t k, Int_t eoffset) const { return GetTypedValueSTL<Double_t>(cont, i, j, k, eoffset); }
    Double_t            GetValueSTLP(TVirtualCollectionProxy *cont, Int_t i, Int_t j, Int_t k, Int_t eoffset) const { return GetTypedValueSTLP<Double_t>(cont, i, j, k, eoffset); }
+   Bool_t              IsJitted() const { return fJitState == kJitDone && fJitReader; }
+   Bool_t              JitCompile();
+   Bool_t              JitReadObject(TBuffer &b, void *obj);
+   Bool_t              JitWriteObject(TBuffer &b, void *obj);
+   static void         JitReadElement(TBuffer &b, char *obj, TStreamerInfo *info, Int_t i);
+   static void         JitWriteElement(TBuffer &b, char *obj, TStreamerInfo *info, Int_t i);
    void                ls(Option_t *option="") const;
    Bool_t              MatchLegacyCheckSum(UInt_t checksum) const;
    TVirtualStreamerInfo *NewInfo(TClass *cl) {return new TStreamerInfo(cl);}
@@ -264,6 +281,7 @@ public:
    void                SetCheckSum(UInt_t checksum) {fCheckSum = checksum;}
    void                SetClass(TClass *cl) {fClass = cl;}
    void                SetClassVersion(Int_t vers) {fClassVersion=vers;}
+   static void         SetJitStreamers(const char *classname, Bool_t enable = kTRUE);
    void                SetOnFileClassVersion(Int_t vers) {fOnFileClassVersion=vers;}
    void                TagFile(TFile *fFile);
 private:
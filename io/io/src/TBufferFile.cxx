@@ -36,15 +36,7 @@ The concrete implementation of TBuffer for writing/reading to/from a ROOT file o
 #include "TVirtualMutex.h"
 #include "TROOT.h"
 
-#if (defined(__linux) || defined(__APPLE__)) && defined(__i386__) && \
-     defined(__GNUC__)
-#define USE_BSWAPCPY
-#endif
-
-#ifdef USE_BSWAPCPY
-#include "Bswapcpy.h"
-#endif
-
+#include <algorithm>
 
 const UInt_t kNewClassTag       = 0xFFFFFFFF;
 const UInt_t kClassMask         = 0x80000000;  // OR the class index with this
@@ -57,6 +49,84 @@ const Int_t  kMapOffset         = 2;   // first 2 map entries are taken by null
 
 ClassImp(TBufferFile);
 
+namespace {
+
+// Number of values converted at once by the helpers below.
+const Int_t kConvertChunk = 256;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read n values stored as truncated floats (nbits != 0) or as floats, and
+/// store them in 'to', converted to T.
+
+template <typename T>
+void ReadTruncatedFloats(char *&buf, T *to, Int_t n, Int_t nbits)
+{
+   Float_t tmp[kConvertChunk];
+   for (Int_t i = 0; i < n; i += kConvertChunk) {
+      Int_t m = std::min(kConvertChunk, n - i);
+      if (nbits) {
+         ROOT::Internal::UnpackTruncatedFloats(tmp, buf, m, nbits);
+         buf += 3 * m;
+      } else {
+#ifdef R__BYTESWAP
+         ROOT::Internal::ByteSwapCopy32(tmp, buf, m);
+#else
+         memcpy(tmp, buf, sizeof(Float_t) * m);
+#endif
+         buf += sizeof(Float_t) * m;
+      }
+      for (Int_t j = 0; j < m; ++j)
+         to[i + j] = (T)tmp[j];
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write n values as truncated floats (nbits != 0) or as floats.
+
+template <typename T>
+void WriteTruncatedFloats(char *&buf, const T *from, Int_t n, Int_t nbits)
+{
+   Float_t tmp[kConvertChunk];
+   for (Int_t i = 0; i < n; i += kConvertChunk) {
+      Int_t m = std::min(kConvertChunk, n - i);
+      for (Int_t j = 0; j < m; ++j)
+         tmp[j] = (Float_t)from[i + j];
+      if (nbits) {
+         ROOT::Internal::PackTruncatedFloats(buf, tmp, m, nbits);
+         buf += 3 * m;
+      } else {
+#ifdef R__BYTESWAP
+         ROOT::Internal::ByteSwapCopy32(buf, tmp, m);
+#else
+         memcpy(buf, tmp, sizeof(Float_t) * m);
+#endif
+         buf += sizeof(Float_t) * m;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read n values stored as integers scaled to [minvalue, maxvalue].
+
+template <typename T>
+void ReadScaledValues(char *&buf, T *to, Int_t n, Double_t factor, Double_t minvalue)
+{
+   UInt_t tmp[kConvertChunk];
+   for (Int_t i = 0; i < n; i += kConvertChunk) {
+      Int_t m = std::min(kConvertChunk, n - i);
+#ifdef R__BYTESWAP
+      ROOT::Internal::ByteSwapCopy32(tmp, buf, m);
+#else
+      memcpy(tmp, buf, sizeof(UInt_t) * m);
+#endif
+      buf += sizeof(UInt_t) * m;
+      for (Int_t j = 0; j < m; ++j)
+         to[i + j] = (T)(tmp[j] / factor + minvalue);
+   }
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Thread-safe check on StreamerInfos of a TClass
 
@@ -762,13 +832,8 @@ Int_t TBufferFile::ReadArray(Short_t *&h)
    if (!h) h = new Short_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy16(h, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
 #else
    memcpy(h, fBufCur, l);
    fBufCur += l;
@@ -795,13 +860,8 @@ Int_t TBufferFile::ReadArray(Int_t *&ii)
    if (!ii) ii = new Int_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy32(ii, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
 #else
    memcpy(ii, fBufCur, l);
    fBufCur += l;
@@ -854,8 +914,8 @@ Int_t TBufferFile::ReadArray(Long64_t *&ll)
    if (!ll) ll = new Long64_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy64(ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -882,13 +942,8 @@ Int_t TBufferFile::ReadArray(Float_t *&f)
    if (!f) f = new Float_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy32(f, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
 #else
    memcpy(f, fBufCur, l);
    fBufCur += l;
@@ -915,8 +970,8 @@ Int_t TBufferFile::ReadArray(Double_t *&d)
    if (!d) d = new Double_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy64(d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1035,13 +1090,8 @@ Int_t TBufferFile::ReadStaticArray(Short_t *h)
    if (!h) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy16(h, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
 #else
    memcpy(h, fBufCur, l);
    fBufCur += l;
@@ -1067,13 +1117,8 @@ Int_t TBufferFile::ReadStaticArray(Int_t *ii)
    if (!ii) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy32(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
 #else
    memcpy(ii, fBufCur, l);
    fBufCur += l;
@@ -1124,8 +1169,8 @@ Int_t TBufferFile::ReadStaticArray(Long64_t *ll)
    if (!ll) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy64(ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1151,13 +1196,8 @@ Int_t TBufferFile::ReadStaticArray(Float_t *f)
    if (!f) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy32(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
 #else
    memcpy(f, fBufCur, l);
    fBufCur += l;
@@ -1183,8 +1223,8 @@ Int_t TBufferFile::ReadStaticArray(Double_t *d)
    if (!d) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy64(d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1301,13 +1341,8 @@ void TBufferFile::ReadFastArray(Short_t *h, Int_t n)
    if (n <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy16(h, fBufCur, n);
    fBufCur += sizeof(Short_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
 #else
    memcpy(h, fBufCur, l);
    fBufCur += l;
@@ -1323,13 +1358,8 @@ void TBufferFile::ReadFastArray(Int_t *ii, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy32(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
 #else
    memcpy(ii, fBufCur, l);
    fBufCur += l;
@@ -1361,8 +1391,8 @@ void TBufferFile::ReadFastArray(Long64_t *ll, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy64(ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1378,13 +1408,8 @@ void TBufferFile::ReadFastArray(Float_t *f, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy32(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
 #else
    memcpy(f, fBufCur, l);
    fBufCur += l;
@@ -1400,8 +1425,8 @@ void TBufferFile::ReadFastArray(Double_t *d, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy64(d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1418,33 +1443,14 @@ void TBufferFile::ReadFastArrayFloat16(Float_t *f, Int_t n, TStreamerElement *el
 
    if (ele && ele->GetFactor() != 0) {
       //a range was specified. We read an integer and convert it back to a float
-      Double_t xmin = ele->GetXmin();
-      Double_t factor = ele->GetFactor();
-      for (int j=0;j < n; j++) {
-         UInt_t aint; *this >> aint; f[j] = (Float_t)(aint/factor + xmin);
-      }
+      ReadScaledValues(fBufCur, f, n, ele->GetFactor(), ele->GetXmin());
    } else {
-      Int_t i;
       Int_t nbits = 0;
       if (ele) nbits = (Int_t)ele->GetXmin();
       if (!nbits) nbits = 12;
       //we read the exponent and the truncated mantissa of the float
       //and rebuild the new float.
-      union {
-         Float_t fFloatValue;
-         Int_t   fIntValue;
-      };
-      UChar_t  theExp;
-      UShort_t theMan;
-      for (i = 0; i < n; i++) {
-         *this >> theExp;
-         *this >> theMan;
-         fIntValue = theExp;
-         fIntValue <<= 23;
-         fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-         if(1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-         f[i] = fFloatValue;
-      }
+      ReadTruncatedFloats(fBufCur, f, n, nbits);
    }
 }
 
@@ -1457,9 +1463,7 @@ void TBufferFile::ReadFastArrayWithFactor(Float_t *ptr, Int_t n, Double_t factor
    if (n <= 0 || 3*n > fBufSize) return;
 
    //a range was specified. We read an integer and convert it back to a float
-   for (int j=0;j < n; j++) {
-      UInt_t aint; *this >> aint; ptr[j] = (Float_t)(aint/factor + minvalue);
-   }
+   ReadScaledValues(fBufCur, ptr, n, factor, minvalue);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1473,21 +1477,7 @@ void TBufferFile::ReadFastArrayWithNbits(Float_t *ptr, Int_t n, Int_t nbits)
    if (!nbits) nbits = 12;
    //we read the exponent and the truncated mantissa of the float
    //and rebuild the new float.
-   union {
-      Float_t fFloatValue;
-      Int_t   fIntValue;
-   };
-   UChar_t  theExp;
-   UShort_t theMan;
-   for (Int_t i = 0; i < n; i++) {
-      *this >> theExp;
-      *this >> theMan;
-      fIntValue = theExp;
-      fIntValue <<= 23;
-      fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-      if(1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-      ptr[i] = fFloatValue;
-   }
+   ReadTruncatedFloats(fBufCur, ptr, n, nbits);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1500,41 +1490,13 @@ void TBufferFile::ReadFastArrayDouble32(Double_t *d, Int_t n, TStreamerElement *
 
    if (ele && ele->GetFactor() != 0) {
       //a range was specified. We read an integer and convert it back to a double.
-      Double_t xmin = ele->GetXmin();
-      Double_t factor = ele->GetFactor();
-      for (int j=0;j < n; j++) {
-         UInt_t aint; *this >> aint; d[j] = (Double_t)(aint/factor + xmin);
-      }
+      ReadScaledValues(fBufCur, d, n, ele->GetFactor(), ele->GetXmin());
    } else {
-      Int_t i;
       Int_t nbits = 0;
       if (ele) nbits = (Int_t)ele->GetXmin();
-      if (!nbits) {
-         //we read a float and convert it to double
-         Float_t afloat;
-         for (i = 0; i < n; i++) {
-            *this >> afloat;
-            d[i] = (Double_t)afloat;
-         }
-      } else {
-         //we read the exponent and the truncated mantissa of the float
-         //and rebuild the double.
-         union {
-            Float_t fFloatValue;
-            Int_t   fIntValue;
-         };
-         UChar_t  theExp;
-         UShort_t theMan;
-         for (i = 0; i < n; i++) {
-            *this >> theExp;
-            *this >> theMan;
-            fIntValue = theExp;
-            fIntValue <<= 23;
-            fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-            if (1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-            d[i] = (Double_t)fFloatValue;
-         }
-      }
+      //we read a float (nbits == 0) or the exponent and the truncated
+      //mantissa of the float and convert it to double
+      ReadTruncatedFloats(fBufCur, d, n, nbits);
    }
 }
 
@@ -1547,9 +1509,7 @@ void TBufferFile::ReadFastArrayWithFactor(Double_t *d, Int_t n, Double_t factor,
    if (n <= 0 || 3*n > fBufSize) return;
 
    //a range was specified. We read an integer and convert it back to a double.
-   for (int j=0;j < n; j++) {
-      UInt_t aint; *this >> aint; d[j] = (Double_t)(aint/factor + minvalue);
-   }
+   ReadScaledValues(fBufCur, d, n, factor, minvalue);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1560,32 +1520,9 @@ void TBufferFile::ReadFastArrayWithNbits(Double_t *d, Int_t n, Int_t nbits)
 {
    if (n <= 0 || 3*n > fBufSize) return;
 
-   if (!nbits) {
-      //we read a float and convert it to double
-      Float_t afloat;
-      for (Int_t i = 0; i < n; i++) {
-         *this >> afloat;
-         d[i] = (Double_t)afloat;
-      }
-   } else {
-      //we read the exponent and the truncated mantissa of the float
-      //and rebuild the double.
-      union {
-         Float_t fFloatValue;
-         Int_t   fIntValue;
-      };
-      UChar_t  theExp;
-      UShort_t theMan;
-      for (Int_t i = 0; i < n; i++) {
-         *this >> theExp;
-         *this >> theMan;
-         fIntValue = theExp;
-         fIntValue <<= 23;
-         fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-         if (1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-         d[i] = (Double_t)fFloatValue;
-      }
-   }
+   //we read a float (nbits == 0) or the exponent and the truncated
+   //mantissa of the float and convert it to double
+   ReadTruncatedFloats(fBufCur, d, n, nbits);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1734,13 +1671,8 @@ void TBufferFile::WriteArray(const Short_t *h, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(fBufCur, h, n);
+   ROOT::Internal::ByteSwapCopy16(fBufCur, h, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
-# endif
 #else
    memcpy(fBufCur, h, l);
    fBufCur += l;
@@ -1764,13 +1696,8 @@ void TBufferFile::WriteArray(const Int_t *ii, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, ii, n);
+   ROOT::Internal::ByteSwapCopy32(fBufCur, ii, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
-# endif
 #else
    memcpy(fBufCur, ii, l);
    fBufCur += l;
@@ -1832,8 +1759,8 @@ void TBufferFile::WriteArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, ll, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -1857,13 +1784,8 @@ void TBufferFile::WriteArray(const Float_t *f, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, f, n);
+   ROOT::Internal::ByteSwapCopy32(fBufCur, f, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
-# endif
 #else
    memcpy(fBufCur, f, l);
    fBufCur += l;
@@ -1887,8 +1809,8 @@ void TBufferFile::WriteArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, d, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -2000,13 +1922,8 @@ void TBufferFile::WriteFastArray(const Short_t *h, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(fBufCur, h, n);
+   ROOT::Internal::ByteSwapCopy16(fBufCur, h, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
-# endif
 #else
    memcpy(fBufCur, h, l);
    fBufCur += l;
@@ -2024,13 +1941,8 @@ void TBufferFile::WriteFastArray(const Int_t *ii, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, ii, n);
+   ROOT::Internal::ByteSwapCopy32(fBufCur, ii, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
-# endif
 #else
    memcpy(fBufCur, ii, l);
    fBufCur += l;
@@ -2076,8 +1988,8 @@ void TBufferFile::WriteFastArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, ll, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -2095,13 +2007,8 @@ void TBufferFile::WriteFastArray(const Float_t *f, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, f, n);
+   ROOT::Internal::ByteSwapCopy32(fBufCur, f, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
-# endif
 #else
    memcpy(fBufCur, f, l);
    fBufCur += l;
@@ -2119,8 +2026,8 @@ void TBufferFile::WriteFastArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, d, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -2156,25 +2063,10 @@ void TBufferFile::WriteFastArrayFloat16(const Float_t *f, Int_t n, TStreamerElem
       //number of bits stored in fXmin (see TStreamerElement::GetRange)
       if (ele) nbits = (Int_t)ele->GetXmin();
       if (!nbits) nbits = 12;
-      Int_t i;
       //a range is not specified, but nbits is.
       //In this case we truncate the mantissa to nbits and we stream
       //the exponent as a UChar_t and the mantissa as a UShort_t.
-      union {
-         Float_t fFloatValue;
-         Int_t   fIntValue;
-      };
-      for (i = 0; i < n; i++) {
-         fFloatValue = f[i];
-         UChar_t  theExp = (UChar_t)(0x000000ff & ((fIntValue<<1)>>24));
-         UShort_t theMan = ((1<<(nbits+1))-1) & (fIntValue>>(23-nbits-1));
-         theMan++;
-         theMan = theMan>>1;
-         if (theMan&1<<nbits) theMan = (1<<nbits) - 1;
-         if (fFloatValue < 0) theMan |= 1<<(nbits+1);
-         *this << theExp;
-         *this << theMan;
-      }
+      WriteTruncatedFloats(fBufCur, f, n, nbits);
    }
 }
 
@@ -2206,33 +2098,10 @@ void TBufferFile::WriteFastArrayDouble32(const Double_t *d, Int_t n, TStreamerEl
       Int_t nbits = 0;
       //number of bits stored in fXmin (see TStreamerElement::GetRange)
       if (ele) nbits = (Int_t)ele->GetXmin();
-      Int_t i;
-      if (!nbits) {
-         //if no range and no bits specified, we convert from double to float
-         for (i = 0; i < n; i++) {
-            Float_t afloat = (Float_t)d[i];
-            *this << afloat;
-         }
-      } else {
-         //a range is not specified, but nbits is.
-         //In this case we truncate the mantissa to nbits and we stream
-         //the exponent as a UChar_t and the mantissa as a UShort_t.
-         union {
-            Float_t fFloatValue;
-            Int_t   fIntValue;
-         };
-         for (i = 0; i < n; i++) {
-            fFloatValue = (Float_t)d[i];
-            UChar_t  theExp = (UChar_t)(0x000000ff & ((fIntValue<<1)>>24));
-            UShort_t theMan = ((1<<(nbits+1))-1) & (fIntValue>>(23-nbits-1));
-            theMan++;
-            theMan = theMan>>1;
-            if(theMan&1<<nbits) theMan = (1<<nbits) - 1;
-            if (fFloatValue < 0) theMan |= 1<<(nbits+1);
-            *this << theExp;
-            *this << theMan;
-         }
-      }
+      //if no range and no bits specified, we convert from double to float,
+      //if only nbits is specified, we truncate the mantissa to nbits and we
+      //stream the exponent as a UChar_t and the mantissa as a UShort_t.
+      WriteTruncatedFloats(fBufCur, d, n, nbits);
    }
 }
 
@@ -3343,7 +3212,8 @@ Int_t TBufferFile::ReadClassBuffer(const TClass *cl, void *pointer, Int_t versio
    }
 
    // Deserialize the object.
-   ApplySequence(*(sinfo->GetReadObjectWiseActions()), (char*)pointer);
+   if (gDebug || !sinfo->JitReadObject(*this, pointer))
+      ApplySequence(*(sinfo->GetReadObjectWiseActions()), (char*)pointer);
    if (sinfo->IsRecovered()) count=0;
 
    // Check that the buffer position corresponds to the byte count.
@@ -3482,7 +3352,8 @@ Int_t TBufferFile::ReadClassBuffer(const TClass *cl, void *pointer, const TClass
    }
 
    //deserialize the object
-   ApplySequence(*(sinfo->GetReadObjectWiseActions()), (char*)pointer );
+   if (gDebug || !sinfo->JitReadObject(*this, pointer))
+      ApplySequence(*(sinfo->GetReadObjectWiseActions()), (char*)pointer );
    if (sinfo->TStreamerInfo::IsRecovered()) R__c=0; // 'TStreamerInfo::' avoids going via a virtual function.
 
    // Check that the buffer position corresponds to the byte count.
@@ -3530,7 +3401,8 @@ Int_t TBufferFile::WriteClassBuffer(const TClass *cl, void *pointer)
 
    //NOTE: In the future Philippe wants this to happen via a custom action
    TagStreamerInfo(sinfo);
-   ApplySequence(*(sinfo->GetWriteObjectWiseActions()), (char*)pointer);
+   if (gDebug || !sinfo->JitWriteObject(*this, pointer))
+      ApplySequence(*(sinfo->GetWriteObjectWiseActions()), (char*)pointer);
 
    //write the byte count at the start of the buffer
    SetByteCount(R__c, kTRUE);
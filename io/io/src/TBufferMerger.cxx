@@ -16,6 +16,12 @@
 #include "TROOT.h"
 #include "TVirtualMutex.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <chrono>
 #include <utility>
 
 namespace ROOT {
@@ -62,18 +68,101 @@ std::shared_ptr<TBufferMergerFile> TBufferMerger::GetFile()
 
 size_t TBufferMerger::GetQueueSize() const
 {
+   std::lock_guard<std::mutex> lock(fQueueMutex);
    return fQueue.size();
 }
 
+size_t TBufferMerger::GetMaxQueueSize() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fMaxQueueSize;
+}
+
+size_t TBufferMerger::GetBufferedBytes() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fBuffered + fMerging;
+}
+
+size_t TBufferMerger::GetNMerges() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fNMerges;
+}
+
+double TBufferMerger::GetLastMergeLatency() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fLastMergeLatency;
+}
+
+double TBufferMerger::GetTotalMergeTime() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fMergeTime;
+}
+
+size_t TBufferMerger::GetNConcurrentMerges() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fNConcurrentMerges;
+}
+
+double TBufferMerger::GetTotalBlockedTime() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fBlockedTime;
+}
+
+size_t TBufferMerger::GetNBlocked() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fNBlocked;
+}
+
+size_t TBufferMerger::GetMaxBufferedBytes() const
+{
+   return fMaxBuffered;
+}
+
+size_t TBufferMerger::GetMergeConcurrency() const
+{
+   return fMergeConcurrency;
+}
+
 void TBufferMerger::Push(TBufferFile *buffer)
 {
+   const size_t size = buffer->BufferSize();
+   bool merge = false;
    {
-      std::lock_guard<std::mutex> lock(fQueueMutex);
-      fBuffered += buffer->BufferSize();
+      std::unique_lock<std::mutex> lock(fQueueMutex);
+
+      // Apply backpressure: as long as adding this buffer would exceed the
+      // memory budget, either merge what is queued ourselves or wait for the
+      // running merge to release its buffers. A single buffer larger than the
+      // budget is always accepted once nothing else is held.
+      if (fMaxBuffered > 0 && fBuffered + fMerging > 0 && fBuffered + fMerging + size > fMaxBuffered) {
+         auto start = std::chrono::steady_clock::now();
+         while (fBuffered + fMerging > 0 && fBuffered + fMerging + size > fMaxBuffered) {
+            if (fMergeRunning || fBuffered == 0) {
+               fMergeDone.wait(lock);
+            } else {
+               lock.unlock();
+               Merge();
+               lock.lock();
+            }
+         }
+         fBlockedTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+         ++fNBlocked;
+      }
+
+      fBuffered += size;
       fQueue.push(buffer);
+      fMaxQueueSize = std::max(fMaxQueueSize, fQueue.size());
+      merge = fBuffered > fAutoSave;
    }
 
-   if (fBuffered > fAutoSave)
+   if (merge)
       Merge();
 }
 
@@ -93,30 +182,104 @@ void TBufferMerger::SetAutoSave(size_t size)
    fAutoSave = size;
 }
 
+void TBufferMerger::SetMaxBufferedBytes(size_t size)
+{
+   fMaxBuffered = size;
+}
+
+void TBufferMerger::SetMergeConcurrency(size_t n)
+{
+   fMergeConcurrency = n;
+}
+
 void TBufferMerger::SetMergeOptions(const TString& options)
 {
    fMerger.SetMergeOptions(options);
 }
 
+bool TBufferMerger::MergeGroups(std::vector<std::unique_ptr<TBufferFile>> &buffers)
+{
+   bool concurrent = false;
+#ifdef R__USE_IMT
+   const size_t ngroups = std::min(fMergeConcurrency, buffers.size());
+   if (ngroups > 1 && ROOT::IsImplicitMTEnabled()) {
+      // Merge contiguous groups of buffers concurrently into intermediate
+      // in-memory files, so that decompression, merging and recompression
+      // run in parallel and only the intermediate results are serialized.
+      const char *name = fMerger.GetOutputFileName();
+      const Int_t compress = fMerger.GetOutputFile()->GetCompressionSettings();
+      const TString options = fMerger.GetMergeOptions();
+      std::vector<std::unique_ptr<TBufferFile>> merged(ngroups);
+
+      auto mergeGroup = [&](UInt_t i) {
+         TDirectory::TContext ctxt;
+         TFileMerger merger(false, false);
+         merger.SetMergeOptions(options);
+         std::unique_ptr<TMemFile> output(new TMemFile(name, "RECREATE", "", compress));
+         auto file = output.get();
+         merger.OutputFile(std::move(output));
+         const size_t first = i * buffers.size() / ngroups;
+         const size_t last = (i + 1) * buffers.size() / ngroups;
+         for (size_t j = first; j < last; ++j)
+            merger.AddAdoptFile(new TMemFile(name, std::move(buffers[j])));
+         merger.PartialMerge();
+         merged[i].reset(new TBufferFile(TBuffer::kWrite, file->GetSize()));
+         file->CopyTo(*merged[i]);
+         merged[i]->SetReadMode();
+      };
+
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(mergeGroup, ROOT::TSeqU(ngroups));
+      buffers = std::move(merged);
+      concurrent = true;
+   }
+#endif
+
+   for (auto &buffer : buffers)
+      fMerger.AddAdoptFile(new TMemFile(fMerger.GetOutputFileName(), std::move(buffer)));
+
+   fMerger.PartialMerge();
+   fMerger.Reset();
+   return concurrent;
+}
+
 void TBufferMerger::Merge()
 {
    if (fMergeMutex.try_lock()) {
+      auto start = std::chrono::steady_clock::now();
       std::queue<TBufferFile *> queue;
       {
          std::lock_guard<std::mutex> q(fQueueMutex);
          std::swap(queue, fQueue);
+         fMerging = fBuffered;
          fBuffered = 0;
+         fMergeRunning = true;
       }
 
+      std::vector<std::unique_ptr<TBufferFile>> buffers;
+      buffers.reserve(queue.size());
       while (!queue.empty()) {
-         std::unique_ptr<TBufferFile> buffer{queue.front()};
-         fMerger.AddAdoptFile(new TMemFile(fMerger.GetOutputFileName(), std::move(buffer)));
+         buffers.emplace_back(queue.front());
          queue.pop();
       }
 
-      fMerger.PartialMerge();
-      fMerger.Reset();
+      bool concurrent = false;
+      if (!buffers.empty())
+         concurrent = MergeGroups(buffers);
+
+      double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      {
+         std::lock_guard<std::mutex> q(fQueueMutex);
+         fMerging = 0;
+         fMergeRunning = false;
+         ++fNMerges;
+         if (concurrent)
+            ++fNConcurrentMerges;
+         fLastMergeLatency = latency;
+         fMergeTime += latency;
+      }
       fMergeMutex.unlock();
+      fMergeDone.notify_all();
    }
 }
 
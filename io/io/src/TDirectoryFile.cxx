@@ -21,6 +21,16 @@ Begin_Macro
 ../../../tutorials/io/fildir.C
 End_Macro
  The structure of a file is shown in TFile::TFile
+
+ Since version 6 of the directory record, the record holding the list of keys
+ of a directory ends with a hash index of the keys by name. A directory opened
+ read-only then reads only the trailer of the index; TDirectoryFile::GetKey()
+ and TDirectoryFile::Get() read the index entries and the key of the requested
+ name on demand, so that opening a file or a directory does not depend on its
+ number of keys. The whole list of keys is read the first time it is needed,
+ e.g. by GetListOfKeys() or ls(). Files written with the index can still be
+ read by older versions of ROOT, which ignore it. Lazy reading can be disabled
+ with the rootrc resource `TFile.LazyKeys: no`.
 */
 
 #include "Riostream.h"
@@ -47,10 +57,40 @@ End_Macro
 #include "TProcessUUID.h"
 #include "TVirtualMutex.h"
 #include "TEmulatedCollectionProxy.h"
+#include "TEnv.h"
+
+#include <vector>
 
 const UInt_t kIsBigFile = BIT(16);
 const Int_t  kMaxLen = 2048;
 
+namespace {
+
+// Layout of the index at the end of the keys record: the buckets, i.e. the
+// index of the first entry of each bucket plus the total number of entries,
+// then the entries (hash of the name, offset and size of the key in the
+// record) sorted by bucket, then a fixed size trailer.
+const Version_t kKeysIndexDirVersion = 6;     // first directory version with the index
+const UInt_t    kKeysIndexMagic = 0x4b584449; // "KXDI"
+const Int_t     kKeysIndexVersion = 1;
+const Int_t     kKeysIndexEntrySize = 3 * sizeof(Int_t);
+const Int_t     kKeysIndexTrailerSize = 6 * sizeof(Int_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// FNV-1a hash of a key name, part of the file format: it must not change.
+
+UInt_t HashKeyName(const char *name)
+{
+   UInt_t hash = 2166136261u;
+   for (const unsigned char *c = (const unsigned char *)name; *c; ++c) {
+      hash ^= *c;
+      hash *= 16777619u;
+   }
+   return hash;
+}
+
+} // unnamed namespace
+
 ClassImp(TDirectoryFile);
 
 
@@ -229,6 +269,8 @@ Int_t TDirectoryFile::AppendKey(TKey *key)
       return 0;
    }
 
+   if (fKeysLazy) LoadAllKeys();
+
    fModified = kTRUE;
 
    key->SetMotherDir(this);
@@ -265,7 +307,7 @@ void TDirectoryFile::Browse(TBrowser *b)
       TObject *obj = nullptr;
       TIter nextin(fList);
       TKey *key = nullptr, *keyo = nullptr;
-      TIter next(fKeys);
+      TIter next(GetListOfKeys());
 
       cd();
 
@@ -318,9 +360,10 @@ void TDirectoryFile::BuildDirectoryFile(TFile* motherFile, TDirectory* motherDir
    fSeekDir    = 0;
    fSeekParent = 0;
    fSeekKeys   = 0;
-   fList       = new THashList(100,50);
+   THashList *list = new THashList(100,50);
+   list->UseLocalLock();
+   fList       = list;
    fKeys       = new THashList(100,50);
-   fList->UseRWLock();
    fMother     = motherDir;
    fFile       = motherFile ? motherFile : TFile::CurrentFile();
    SetBit(kCanDelete);
@@ -574,6 +617,7 @@ void TDirectoryFile::Close(Option_t *option)
    if (fKeys) {
       fKeys->Delete("slow");
    }
+   fKeysLazy = kFALSE;
 
    TDirectoryFile::CleanTargets();
 }
@@ -943,7 +987,7 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 //*-*---------------------Case of Key---------------------
 //                        ===========
    TKey *key;
-   TIter nextkey(GetListOfKeys());
+   TIter nextkey(GetKeysForName(namobj));
    while ((key = (TKey *) nextkey())) {
       if (strcmp(namobj,key->GetName()) == 0) {
          if ((cycle == 9999) || (cycle == key->GetCycle())) {
@@ -1063,7 +1107,7 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 //                        ===========
    void *idcur = nullptr;
    TKey *key;
-   TIter nextkey(GetListOfKeys());
+   TIter nextkey(GetKeysForName(namobj));
    while ((key = (TKey *) nextkey())) {
       if (strcmp(namobj,key->GetName()) == 0) {
          if ((cycle == 9999) || (cycle == key->GetCycle())) {
@@ -1090,6 +1134,21 @@ Int_t TDirectoryFile::GetBufferSize() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of keys of the hash list fKeys which holds the keys named
+/// name (with others), or nullptr. If the keys are read lazily, the keys named
+/// name are read from the index first, unless they already were.
+
+const TList *TDirectoryFile::GetKeysForName(const char *name) const
+{
+   if (!fKeys) return nullptr;
+
+   THashList *keys = static_cast<THashList *>(fKeys);
+   if (fKeysLazy && !keys->FindObject(name))
+      ReadIndexedKeys(name);
+   return keys->GetListForObject(name);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return pointer to key with name,cycle
 ///
@@ -1100,7 +1159,7 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
    if (!fKeys) return nullptr;
 
    // TIter::TIter() already checks for null pointers
-   TIter next( ((THashList *)(GetListOfKeys()))->GetListForObject(name) );
+   TIter next(GetKeysForName(name));
 
    TKey *key;
    while (( key = (TKey *)next() )) {
@@ -1253,6 +1312,44 @@ void TDirectoryFile::Purge(Short_t)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read all the keys of a directory whose keys are read lazily. The keys
+/// already looked up are kept, in their place in the list, since the callers
+/// of GetKey() may hold pointers to them.
+
+void TDirectoryFile::LoadAllKeys() const
+{
+   if (!fKeysLazy || !fKeys) return;
+
+   TDirectoryFile *self = const_cast<TDirectoryFile *>(this);
+   THashList *lookedUp = static_cast<THashList *>(fKeys);
+   self->fKeys = new THashList(100,50);
+   self->fKeys->UseRWLock();
+   fKeysLazy = kFALSE;
+   self->ReadKeys(kFALSE);
+
+   if (lookedUp->GetSize()) {
+      TObjLink *lnk = fKeys->FirstLink();
+      while (lnk) {
+         TObjLink *next = lnk->Next();
+         TKey *key = (TKey *)lnk->GetObject();
+         TIter nextold(lookedUp->GetListForObject(key->GetName()));
+         TKey *old;
+         while ((old = (TKey *)nextold())) {
+            if (old->GetCycle() == key->GetCycle() && !strcmp(old->GetName(), key->GetName())) {
+               fKeys->AddBefore(lnk, old);
+               fKeys->Remove(lnk);
+               delete key;
+               break;
+            }
+         }
+         lnk = next;
+      }
+   }
+   lookedUp->Clear("nodelete");
+   delete lookedUp;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read objects from a ROOT file directory into memory.
 ///
@@ -1321,6 +1418,12 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
    if (!fFile->IsBinary())
       return fFile->DirReadKeys(this);
 
+   if (fKeysLazy && !forceRead) {
+      LoadAllKeys();
+      return fKeys->GetSize();
+   }
+   fKeysLazy = kFALSE;
+
    TDirectory::TContext ctxt(this);
 
    char *buffer;
@@ -1391,6 +1494,115 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare the lazy reading of the keys, through the index at the end of the
+/// keys record written since version 6 of the directory record (versiondir).
+/// Only the trailer of the index is read. Return kFALSE if the keys must be
+/// read with ReadKeys(): the directory is writable, the record has no valid
+/// index or lazy reading is disabled with `TFile.LazyKeys: no`.
+
+Bool_t TDirectoryFile::ReadKeysIndex(Version_t versiondir)
+{
+   fKeysLazy = kFALSE;
+   if (versiondir % 1000 < kKeysIndexDirVersion || !fFile || !fKeys || !fFile->IsBinary() || IsWritable())
+      return kFALSE;
+   if (fSeekKeys <= 0 || fNbytesKeys < kKeysIndexTrailerSize)
+      return kFALSE;
+   if (!gEnv->GetValue("TFile.LazyKeys", 1))
+      return kFALSE;
+
+   char trailer[kKeysIndexTrailerSize];
+   if (fFile->ReadBuffer(trailer, fSeekKeys + fNbytesKeys - kKeysIndexTrailerSize, kKeysIndexTrailerSize))
+      return kFALSE;
+   char *buffer = trailer;
+   Int_t nkeys, nbuckets, offsetBuckets, offsetEntries, version;
+   UInt_t magic;
+   frombuf(buffer, &nkeys);
+   frombuf(buffer, &nbuckets);
+   frombuf(buffer, &offsetBuckets);
+   frombuf(buffer, &offsetEntries);
+   frombuf(buffer, &version);
+   frombuf(buffer, &magic);
+   if (magic != kKeysIndexMagic || version != kKeysIndexVersion)
+      return kFALSE;
+   // The record may have been damaged or rewritten without index
+   const Int_t end = fNbytesKeys - kKeysIndexTrailerSize;
+   if (nkeys < 0 || nbuckets <= 0 || (nbuckets & (nbuckets - 1)) || offsetBuckets <= 0 ||
+       offsetBuckets + (Long64_t)(nbuckets + 1) * sizeof(Int_t) > offsetEntries ||
+       offsetEntries + (Long64_t)nkeys * kKeysIndexEntrySize > end)
+      return kFALSE;
+
+   fNkeysOnFile   = nkeys;
+   fNbucketsIndex = nbuckets;
+   fOffsetBuckets = offsetBuckets;
+   fOffsetEntries = offsetEntries;
+   fKeysLazy      = kTRUE;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read from the index the keys named name, add them to fKeys in the order
+/// of the keys record and return their number. It costs a few small reads,
+/// whatever the number of keys of the directory.
+
+Int_t TDirectoryFile::ReadIndexedKeys(const char *name) const
+{
+   const UInt_t hash = HashKeyName(name);
+   const Int_t bucket = hash & (fNbucketsIndex - 1);
+
+   char range[2 * sizeof(Int_t)];
+   if (fFile->ReadBuffer(range, fSeekKeys + fOffsetBuckets + bucket * sizeof(Int_t), sizeof(range)))
+      return 0;
+   char *buffer = range;
+   Int_t first, last;
+   frombuf(buffer, &first);
+   frombuf(buffer, &last);
+   if (first < 0 || last > fNkeysOnFile || last <= first)
+      return 0;
+
+   std::vector<char> entries((last - first) * kKeysIndexEntrySize);
+   if (fFile->ReadBuffer(entries.data(), fSeekKeys + fOffsetEntries + first * kKeysIndexEntrySize, entries.size()))
+      return 0;
+
+   TDirectoryFile *self = const_cast<TDirectoryFile *>(this);
+   const Long64_t fsize = fFile->GetSize();
+   std::vector<char> keybuf;
+   Int_t nread = 0;
+   buffer = entries.data();
+   for (Int_t i = first; i < last; ++i) {
+      UInt_t entryHash;
+      Int_t offset, length;
+      frombuf(buffer, &entryHash);
+      frombuf(buffer, &offset);
+      frombuf(buffer, &length);
+      if (entryHash != hash)
+         continue;
+      if (offset <= 0 || length <= 0 || offset + (Long64_t)length > fOffsetBuckets) {
+         Error("ReadIndexedKeys", "illegal entry in the index of the keys of %s", GetName());
+         break;
+      }
+      keybuf.resize(length);
+      if (fFile->ReadBuffer(keybuf.data(), fSeekKeys + offset, length))
+         break;
+      char *keybuffer = keybuf.data();
+      TKey *key = new TKey(self);
+      key->ReadKeyBuffer(keybuffer);
+      if (strcmp(name, key->GetName())) {
+         delete key;
+         continue;
+      }
+      if (key->GetSeekKey() < 64 || key->GetSeekKey() > fsize ||
+          key->GetSeekPdir() < 64 || key->GetSeekPdir() > fsize) {
+         Error("ReadIndexedKeys", "reading illegal key %s", name);
+         delete key;
+         break;
+      }
+      fKeys->Add(key);
+      ++nread;
+   }
+   return nread;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read object with keyname from the current directory
 ///
@@ -1447,6 +1659,7 @@ void TDirectoryFile::ResetAfterMerge(TFileMergeInfo *info)
    if (fKeys) {
       fKeys->Delete("slow");
    }
+   fKeysLazy = kFALSE;
 
    InitDirectoryFile(cl);
 
@@ -1613,6 +1826,8 @@ void TDirectoryFile::SetWritable(Bool_t writable)
 {
    TDirectory::TContext ctxt(this);
 
+   // The keys must all be in memory to be written back
+   if (writable && fKeysLazy) LoadAllKeys();
    fWritable = writable;
 
    // recursively set all sub-directories
@@ -1650,7 +1865,7 @@ Int_t TDirectoryFile::Sizeof() const
 
 void TDirectoryFile::Streamer(TBuffer &b)
 {
-   Version_t v,version;
+   Version_t v = 0, version;
    if (b.IsReading()) {
       BuildDirectoryFile((TFile*)b.GetParent(), nullptr);
       if (fFile && fFile->IsWritable()) fWritable = kTRUE;
@@ -1709,7 +1924,7 @@ void TDirectoryFile::Streamer(TBuffer &b)
       fList->UseRWLock();
       R__LOCKGUARD(gROOTMutex);
       gROOT->GetUUIDs()->AddUUID(fUUID,this);
-      if (fSeekKeys) ReadKeys();
+      if (fSeekKeys && !ReadKeysIndex(v)) ReadKeys();
    } else {
       if (fFile && !fFile->IsBinary()) {
          b.WriteVersion(TDirectoryFile::Class());
@@ -2117,17 +2332,57 @@ void TDirectoryFile::WriteKeys()
    while ((key = (TKey*)next())) {
       nbytes += key->Sizeof();
    }
+//*-* followed by the index of the keys by name, see ReadKeysIndex
+   Int_t nbuckets = 1;
+   while (nbuckets < nkeys) nbuckets *= 2;
+   nbytes += (nbuckets + 1) * sizeof(Int_t) + nkeys * kKeysIndexEntrySize + kKeysIndexTrailerSize;
    TKey *headerkey  = new TKey(fName,fTitle,IsA(),nbytes,this);
    if (headerkey->GetSeekKey() == 0) {
       delete headerkey;
       return;
    }
-   char *buffer = headerkey->GetBuffer();
+   char *start  = headerkey->GetBuffer();
+   char *buffer = start;
+   const Int_t keylen = headerkey->GetKeylen();
+   std::vector<UInt_t> hashes(nkeys);
+   std::vector<Int_t> offsets(nkeys + 1);
    next.Reset();
    tobuf(buffer, nkeys);
+   Int_t ikey = 0;
    while ((key = (TKey*)next())) {
+      hashes[ikey] = HashKeyName(key->GetName());
+      offsets[ikey++] = keylen + Int_t(buffer - start);
       key->FillBuffer(buffer);
    }
+   offsets[nkeys] = keylen + Int_t(buffer - start);
+
+   // Sort the entries by bucket, keeping the order of the keys in each bucket
+   std::vector<Int_t> firstInBucket(nbuckets + 1, 0);
+   for (Int_t i = 0; i < nkeys; ++i)
+      ++firstInBucket[(hashes[i] & (nbuckets - 1)) + 1];
+   for (Int_t b = 0; b < nbuckets; ++b)
+      firstInBucket[b + 1] += firstInBucket[b];
+   std::vector<Int_t> sorted(nkeys);
+   std::vector<Int_t> fill(firstInBucket.begin(), firstInBucket.end() - 1);
+   for (Int_t i = 0; i < nkeys; ++i)
+      sorted[fill[hashes[i] & (nbuckets - 1)]++] = i;
+
+   const Int_t offsetBuckets = keylen + Int_t(buffer - start);
+   for (Int_t b = 0; b <= nbuckets; ++b)
+      tobuf(buffer, firstInBucket[b]);
+   const Int_t offsetEntries = keylen + Int_t(buffer - start);
+   for (Int_t i : sorted) {
+      tobuf(buffer, hashes[i]);
+      tobuf(buffer, offsets[i]);
+      tobuf(buffer, offsets[i + 1] - offsets[i]);
+   }
+   buffer = start + nbytes - kKeysIndexTrailerSize;
+   tobuf(buffer, nkeys);
+   tobuf(buffer, nbuckets);
+   tobuf(buffer, offsetBuckets);
+   tobuf(buffer, offsetEntries);
+   tobuf(buffer, kKeysIndexVersion);
+   tobuf(buffer, kKeysIndexMagic);
 
    fSeekKeys     = headerkey->GetSeekKey();
    fNbytesKeys   = headerkey->GetNbytes();
@@ -102,6 +102,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TDatime.h"
 #include "TError.h"
 #include "TFile.h"
+#include "TFileBlockCache.h"
 #include "TFileCacheRead.h"
 #include "TFileCacheWrite.h"
 #include "TFree.h"
@@ -745,8 +746,15 @@ void TFile::Init(Bool_t create)
 
       //*-* -------------Read keys of the top directory
       if (fSeekKeys > fBEGIN && fEND <= size) {
+         // The blocks of read-only remote files are identified by the UUID
+         // of the file: from now on they can go through the block cache.
+         if (!fWritable && !fArchive && versiondir > 1 && TFileBlockCache::GetGlobal()) {
+            const TUrl *url = GetEndpointUrl();
+            fUseBlockCache = url && strcmp(url->GetProtocol(), "file");
+         }
          //normal case. Recover only if file has no keys
-         TDirectoryFile::ReadKeys(kFALSE);
+         if (!ReadKeysIndex(versiondir))
+            TDirectoryFile::ReadKeys(kFALSE);
          gDirectory = this;
          if (!GetNkeys()) {
             if (tryrecover) {
@@ -811,7 +819,7 @@ void TFile::Init(Bool_t create)
             }
          } else if (fVersion != gROOT->GetVersionInt() && fVersion > 30000) {
             // Don't complain about missing streamer info for empty files.
-            if (fKeys->GetSize()) {
+            if (GetNkeys()) {
                Warning("Init","no StreamerInfo found in %s therefore preventing schema evolution when reading this file.",GetName());
             }
          }
@@ -819,7 +827,12 @@ void TFile::Init(Bool_t create)
    }
 
    // Count number of TProcessIDs in this file
-   {
+   if (fKeysLazy) {
+      // Do not read all the keys: the process IDs are named ProcessID0, ProcessID1...
+      while (GetKey(TString::Format("ProcessID%d", fNProcessIDs)))
+         fNProcessIDs++;
+      fProcessIDs = new TObjArray(fNProcessIDs+1);
+   } else {
       TIter next(fKeys);
       TKey *key;
       while ((key = (TKey*)next())) {
@@ -1750,7 +1763,42 @@ Int_t TFile::ReadBufferViaCache(char *buf, Int_t len)
       }
    }
 
-   return 0;
+   return ReadBufferViaBlockCache(buf, len);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read buffer at the current offset via the node-level block cache of the
+/// remote files, TFileBlockCache::GetGlobal().
+///
+/// Returns 0 if the file does not use the block cache, 1 in case read via
+/// the block cache was successful, 2 in case read via the block cache failed.
+
+Int_t TFile::ReadBufferViaBlockCache(char *buf, Int_t len)
+{
+   Long64_t off = GetRelOffset();
+   Int_t st = ReadBuffersViaBlockCache(buf, &off, &len, 1);
+   if (st == 1)
+      SetOffset(off + len);
+   return st;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the nbuf blocks described in arrays pos and len via the node-level
+/// block cache of the remote files, TFileBlockCache::GetGlobal().
+///
+/// The remote file classes call it first in their ReadBuffers(), the
+/// blocks missing from the cache are then read with the cache disabled.
+/// Returns 0 if the file does not use the block cache, 1 in case read via
+/// the block cache was successful, 2 in case read via the block cache failed.
+
+Int_t TFile::ReadBuffersViaBlockCache(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
+{
+   if (!fUseBlockCache || fWritable || !buf)
+      return 0;
+   TFileBlockCache *blockCache = TFileBlockCache::GetGlobal();
+   if (!blockCache)
+      return 0;
+   return blockCache->ReadBuffers(this, buf, pos, len, nbuf) ? 2 : 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
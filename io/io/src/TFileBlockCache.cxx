@@ -0,0 +1,484 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/**
+\class TFileBlockCache
+\ingroup IO
+
+A disk cache of the blocks read from remote files, shared by all the
+processes running on a node.
+
+The files are cut in blocks of fixed size (GetBlockSize(), 1 MB by default)
+aligned on multiples of this size. A block is identified by the UUID of the
+file it belongs to and by its index in the file, so that the same block
+read through different URLs, protocols (TNetXNGFile, TDavixFile, TWebFile,
+...) or processes maps to the same cache entry, whatever the ranges that
+were requested. The end of the file is part of the name of the block as
+well, so that the blocks of a file updated since are not reused. Each block
+is stored in its own file, under one of 256 sub-directories of the cache
+directory.
+
+The remote files read-only use the cache returned by GetGlobal() in
+TFile::ReadBuffer() and TFile::ReadBuffers(): the reads of TFileCacheRead
+and TTreeCache as well as the reads of the keys and objects done without
+a cache (TKey::ReadFile(), TFile::ReadStreamerInfo(), ...). The blocks
+overlapping a request are looked up in the cache, the missing ones are read
+from the file with one vectored read and stored. The bytes served from the
+cache are counted as read in the statistics of the file (TFile::GetBytesRead(),
+TVirtualPerfStats), the bytes of the missing blocks read beyond the
+requested ranges as read ahead (TFile::GetBytesReadExtra()).
+
+Concurrent access from many processes is safe without locking the readers:
+ - a block is written to a temporary file which is then atomically renamed
+   to its final name, so a reader sees either the complete block or nothing;
+ - a block read from the cache has its modification time updated, which
+   gives the order used for the least recently used eviction;
+ - the eviction is serialized between processes by a TLockFile; a reader
+   that still has an evicted block open keeps reading it.
+
+The cache used by the remote files is set with SetGlobal() or with the
+rootrc variables:
+~~~ {.cpp}
+Cache.BlockDirectory: /scratch/rootcache
+Cache.BlockMaxSize:   20000
+Cache.BlockSize:      1024
+~~~
+where the maximum size is given in MB and the block size in kB.
+
+The files opened for writing or read from an archive do not use the cache.
+*/
+
+#include "TFileBlockCache.h"
+
+#include "TEnv.h"
+#include "TError.h"
+#include "TFile.h"
+#include "TLockFile.h"
+#include "TSystem.h"
+#include "TTimeStamp.h"
+#include "TUUID.h"
+#include "TVirtualMonitoring.h"
+#include "TVirtualPerfStats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+ClassImp(TFileBlockCache);
+
+TFileBlockCache *TFileBlockCache::fgGlobal = nullptr;
+
+namespace {
+
+/// Age in seconds after which a left-over temporary file or eviction lock is
+/// considered abandoned by a crashed process.
+const Long_t kStaleAge = 3600;
+
+/// Read the nbuf ranges from file without going through the block cache.
+/// The ranges are copied since some ReadBuffers() shift them in place.
+Bool_t ReadFromFile(TFile *file, char *buf, const Long64_t *pos, const Int_t *len, Int_t nbuf,
+                    Bool_t &useBlockCache)
+{
+   std::vector<Long64_t> filePos(pos, pos + nbuf);
+   std::vector<Int_t> fileLen(len, len + nbuf);
+   const Bool_t old = useBlockCache;
+   useBlockCache = kFALSE;
+   Bool_t result = file->ReadBuffers(buf, filePos.data(), fileLen.data(), nbuf);
+   useBlockCache = old;
+   return result;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a cache in directory, evicting the least recently used blocks when
+/// the directory grows above maxSize bytes (no limit if maxSize <= 0). The
+/// files are cached in blocks of blockSize bytes.
+/// The directory is created if needed; if it cannot be created the cache is
+/// not valid and all the reads miss.
+
+TFileBlockCache::TFileBlockCache(const char *directory, Long64_t maxSize, Int_t blockSize)
+   : fDirectory(directory), fMaxSize(maxSize), fBlockSize(blockSize > 0 ? blockSize : (Int_t)kDefaultBlockSize),
+     fUsage(0), fWrittenSinceScan(0), fHits(0), fMisses(0), fBytesHit(0), fBytesMissed(0), fBytesEvicted(0)
+{
+   gSystem->ExpandPathName(fDirectory);
+   if (gSystem->AccessPathName(fDirectory) && gSystem->mkdir(fDirectory, kTRUE) != 0 &&
+       gSystem->AccessPathName(fDirectory)) {
+      Error("TFileBlockCache", "cannot create the cache directory %s", fDirectory.Data());
+      fDirectory = "";
+      return;
+   }
+   if (gSystem->AccessPathName(fDirectory, kWritePermission)) {
+      Error("TFileBlockCache", "no write permission on the cache directory %s", fDirectory.Data());
+      fDirectory = "";
+      return;
+   }
+   fUsage = Scan(-1, nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the path of the file holding the block index of file. It does not
+/// depend on the URL used to open the file.
+
+TString TFileBlockCache::GetBlockPath(TFile *file, Long64_t index) const
+{
+   TString uuid = file->GetUUID().AsString();
+   return TString::Format("%s/%.2s/%s_%lld_%lld", fDirectory.Data(), uuid.Data(), uuid.Data(), file->GetEND(),
+                          index);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the block stored at path into buf. Return kFALSE if the block is not
+/// in the cache or does not have exactly len bytes.
+
+Bool_t TFileBlockCache::ReadBlock(const char *path, char *buf, Int_t len)
+{
+   Bool_t found = kFALSE;
+   if (FILE *fp = fopen(path, "rb")) {
+      if (fseek(fp, 0, SEEK_END) == 0 && ftell(fp) == len && fseek(fp, 0, SEEK_SET) == 0)
+         found = (Int_t)fread(buf, 1, len, fp) == len;
+      fclose(fp);
+   }
+
+   if (found) {
+      // Mark the block as recently used.
+      gSystem->Utime(path, (Long_t)time(nullptr), 0);
+      ++fHits;
+      fBytesHit += len;
+   } else {
+      ++fMisses;
+      fBytesMissed += len;
+   }
+   return found;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store the len bytes of buf as the block at path. The block becomes visible
+/// to the other processes only once it is completely written. Return kFALSE
+/// if the block could not be written.
+
+Bool_t TFileBlockCache::WriteBlock(const char *path, const char *buf, Int_t len)
+{
+   TString dir = gSystem->DirName(path);
+   if (gSystem->AccessPathName(dir))
+      gSystem->mkdir(dir, kTRUE);
+
+   static std::atomic<UInt_t> counter{0};
+   TString tmp = TString::Format("%s.%s.%d.%u.tmp", path, gSystem->HostName(), gSystem->GetPid(), counter++);
+   FILE *fp = fopen(tmp, "wb");
+   if (!fp)
+      return kFALSE;
+   Bool_t ok = (Int_t)fwrite(buf, 1, len, fp) == len;
+   ok = (fclose(fp) == 0) && ok;
+   if (!ok || gSystem->Rename(tmp, path) != 0) {
+      gSystem->Unlink(tmp);
+      return kFALSE;
+   }
+
+   if (fMaxSize <= 0)
+      return kTRUE;
+
+   // The usage estimate only knows about the blocks written by this process:
+   // rescan the directory once in a while to account for the other ones.
+   Bool_t shrink;
+   {
+      std::lock_guard<std::mutex> lock(fUsageMutex);
+      fUsage += len;
+      fWrittenSinceScan += len;
+      shrink = fUsage > fMaxSize || fWrittenSinceScan > fMaxSize / 10;
+   }
+   if (shrink)
+      ShrinkImpl(fMaxSize, path);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the nbuf ranges of file described by pos and len into buf, like
+/// TFile::ReadBuffers(): the blocks overlapping them are taken from the
+/// cache, the missing ones are read from file with a single vectored read
+/// and stored in the cache. Ranges beyond the end of file are read from
+/// file directly.
+/// Return kTRUE in case of failure.
+
+Bool_t TFileBlockCache::ReadBuffers(TFile *file, char *buf, const Long64_t *pos, const Int_t *len, Int_t nbuf)
+{
+   const Long64_t end = file->GetEND();
+   Bool_t cacheable = IsValid();
+   for (Int_t i = 0; cacheable && i < nbuf; ++i)
+      cacheable = pos[i] >= 0 && len[i] >= 0 && pos[i] + len[i] <= end;
+   if (!cacheable)
+      return ReadFromFile(file, buf, pos, len, nbuf, file->fUseBlockCache);
+
+   // The indices of the blocks overlapping the ranges, in increasing order.
+   std::vector<Long64_t> indices;
+   for (Int_t i = 0; i < nbuf; ++i) {
+      if (len[i] == 0)
+         continue;
+      for (Long64_t index = pos[i] / fBlockSize; index <= (pos[i] + len[i] - 1) / fBlockSize; ++index)
+         indices.push_back(index);
+   }
+   std::sort(indices.begin(), indices.end());
+   indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+   const Int_t nblocks = indices.size();
+
+   Double_t start = 0;
+   if (gPerfStats)
+      start = TTimeStamp();
+
+   // Look up the blocks, collecting the missing ones as ranges of consecutive
+   // blocks for a single read of the file.
+   std::vector<char> blocks((size_t)nblocks * fBlockSize);
+   std::vector<TString> paths(nblocks);
+   std::vector<Bool_t> hit(nblocks);
+   std::vector<Long64_t> missPos;
+   std::vector<Int_t> missLen;
+   Long64_t fetched = 0;
+   for (Int_t k = 0; k < nblocks; ++k) {
+      const Int_t blockLen = (Int_t)std::min<Long64_t>(fBlockSize, end - indices[k] * fBlockSize);
+      paths[k] = GetBlockPath(file, indices[k]);
+      hit[k] = ReadBlock(paths[k], &blocks[(size_t)k * fBlockSize], blockLen);
+      if (hit[k])
+         continue;
+      if (k > 0 && !hit[k - 1] && indices[k] == indices[k - 1] + 1 && missLen.back() <= kMaxInt - blockLen)
+         missLen.back() += blockLen;
+      else {
+         missPos.push_back(indices[k] * fBlockSize);
+         missLen.push_back(blockLen);
+      }
+      fetched += blockLen;
+   }
+
+   if (fetched) {
+      std::vector<char> fetchBuffer(fetched);
+      if (ReadFromFile(file, fetchBuffer.data(), missPos.data(), missLen.data(), (Int_t)missPos.size(),
+                       file->fUseBlockCache))
+         return kTRUE;
+      Long64_t offset = 0;
+      for (Int_t k = 0; k < nblocks; ++k) {
+         if (hit[k])
+            continue;
+         const Int_t blockLen = (Int_t)std::min<Long64_t>(fBlockSize, end - indices[k] * fBlockSize);
+         memcpy(&blocks[(size_t)k * fBlockSize], &fetchBuffer[offset], blockLen);
+         WriteBlock(paths[k], &fetchBuffer[offset], blockLen);
+         offset += blockLen;
+      }
+   }
+
+   // Copy the requested ranges out of the blocks.
+   Long64_t bytesHit = 0, bytesMissed = 0;
+   char *out = buf;
+   for (Int_t i = 0; i < nbuf; ++i) {
+      Long64_t cur = pos[i];
+      const Long64_t last = pos[i] + len[i];
+      while (cur < last) {
+         const Long64_t index = cur / fBlockSize;
+         const Int_t k = std::lower_bound(indices.begin(), indices.end(), index) - indices.begin();
+         const Long64_t n = std::min(last, (index + 1) * fBlockSize) - cur;
+         memcpy(out, &blocks[(size_t)k * fBlockSize + (cur - index * fBlockSize)], n);
+         (hit[k] ? bytesHit : bytesMissed) += n;
+         out += n;
+         cur += n;
+      }
+   }
+
+   // The bytes served from the cache count as read from the file, the bytes
+   // of the missing blocks beyond the requested ranges as read ahead.
+   if (bytesHit) {
+      file->fBytesRead += bytesHit;
+      TFile::fgBytesRead += bytesHit;
+      file->fReadCalls++;
+      TFile::fgReadCalls++;
+      if (gMonitoringWriter)
+         gMonitoringWriter->SendFileReadProgress(file);
+      if (gPerfStats)
+         gPerfStats->FileReadEvent(file, (Int_t)bytesHit, start);
+   }
+   const Long64_t extra = fetched - bytesMissed;
+   if (extra > 0) {
+      file->fBytesReadExtra += extra;
+      file->fBytesRead -= extra;
+      TFile::fgBytesRead -= extra;
+   }
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evict the least recently used blocks until the cache directory holds at
+/// most 90% of size bytes. If another process is already evicting, return
+/// immediately. Return the size of the cache directory.
+
+Long64_t TFileBlockCache::Shrink(Long64_t size)
+{
+   return ShrinkImpl(size, nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of Shrink(), never evicting the block stored at keep (the
+/// one just written, whose modification time may equal older ones).
+
+Long64_t TFileBlockCache::ShrinkImpl(Long64_t size, const char *keep)
+{
+   if (!IsValid())
+      return 0;
+
+   TString lockPath = fDirectory + "/.lock";
+   Long_t modTime = 0;
+   if (gSystem->GetPathInfo(lockPath, nullptr, (Long_t *)nullptr, nullptr, &modTime) == 0 &&
+       (Long_t)time(nullptr) - modTime < kStaleAge) {
+      std::lock_guard<std::mutex> lock(fUsageMutex);
+      fWrittenSinceScan = 0;
+      return fUsage;
+   }
+
+   Long64_t usage;
+   {
+      TLockFile lock(lockPath, kStaleAge);
+      usage = Scan(size - size / 10, keep);
+   }
+   std::lock_guard<std::mutex> lock(fUsageMutex);
+   fUsage = usage;
+   fWrittenSinceScan = 0;
+   return usage;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the size of the blocks in the cache directory after removing the
+/// least recently used ones until it is at most target bytes (no eviction if
+/// target < 0), except the block at keep. Abandoned temporary files are
+/// removed as well.
+
+Long64_t TFileBlockCache::Scan(Long64_t target, const char *keep)
+{
+   struct Entry_t {
+      Long_t fMtime;
+      Long64_t fSize;
+      std::string fPath;
+      bool operator<(const Entry_t &other) const { return fMtime < other.fMtime; }
+   };
+   std::vector<Entry_t> entries;
+   Long64_t total = 0;
+   const Long_t now = (Long_t)time(nullptr);
+
+   for (Int_t i = 0; i < 256; ++i) {
+      TString dir = TString::Format("%s/%02x", fDirectory.Data(), i);
+      void *dirp = gSystem->OpenDirectory(dir);
+      if (!dirp)
+         continue;
+      while (const char *name = gSystem->GetDirEntry(dirp)) {
+         if (name[0] == '.')
+            continue;
+         TString path = dir + "/" + name;
+         FileStat_t st;
+         if (gSystem->GetPathInfo(path, st) != 0 || !R_ISREG(st.fMode))
+            continue;
+         if (path.EndsWith(".tmp")) {
+            if (now - st.fMtime > kStaleAge)
+               gSystem->Unlink(path);
+            continue;
+         }
+         total += st.fSize;
+         if (target >= 0 && !(keep && path == keep))
+            entries.push_back({st.fMtime, st.fSize, path.Data()});
+      }
+      gSystem->FreeDirectory(dirp);
+   }
+
+   if (target < 0 || total <= target)
+      return total;
+
+   std::sort(entries.begin(), entries.end());
+   for (const auto &entry : entries) {
+      if (total <= target)
+         break;
+      if (gSystem->Unlink(entry.fPath.c_str()) == 0) {
+         total -= entry.fSize;
+         fBytesEvicted += entry.fSize;
+      }
+   }
+   return total;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the fraction of the bytes requested that were found in the cache.
+
+Double_t TFileBlockCache::GetHitRate() const
+{
+   Long64_t requested = fBytesHit + fBytesMissed;
+   return requested ? Double_t(fBytesHit) / requested : 0.;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the cache directory and the hit statistics of this process.
+
+void TFileBlockCache::Print(Option_t *) const
+{
+   printf("******TFileBlockCache statistics for directory: %s *************\n", fDirectory.Data());
+   printf("Maximum size.......................: %lld bytes\n", fMaxSize);
+   printf("Blocks found / not found...........: %lld / %lld\n", GetHits(), GetMisses());
+   printf("Bytes read from cache / from file..: %lld / %lld\n", GetBytesHit(), GetBytesMissed());
+   printf("Hit rate...........................: %6.2f %%\n", 100. * GetHitRate());
+   printf("Bytes evicted......................: %lld\n", GetBytesEvicted());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset the hit statistics.
+
+void TFileBlockCache::ResetStatistics()
+{
+   fHits = 0;
+   fMisses = 0;
+   fBytesHit = 0;
+   fBytesMissed = 0;
+   fBytesEvicted = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the block cache used when reading remote files, or nullptr if none.
+/// Unless SetGlobal() was called, it is configured by the rootrc variables
+/// Cache.BlockDirectory, Cache.BlockMaxSize (in MB) and Cache.BlockSize (in kB).
+
+TFileBlockCache *TFileBlockCache::GetGlobal()
+{
+   static bool init = []() {
+      const char *dir = gEnv->GetValue("Cache.BlockDirectory", "");
+      if (dir && *dir && !fgGlobal)
+         SetGlobal(dir, (Long64_t)(gEnv->GetValue("Cache.BlockMaxSize", 0.) * 1024 * 1024),
+                   gEnv->GetValue("Cache.BlockSize", (Int_t)kDefaultBlockSize / 1024) * 1024);
+      return true;
+   }();
+   (void)init;
+   return fgGlobal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Use directory as the block cache for remote files, with at most maxSize
+/// bytes (no limit if maxSize <= 0) in blocks of blockSize bytes. A null or
+/// empty directory disables the cache; the files opened while it is disabled
+/// do not use it. Must not be called while files are being read.
+/// Return kFALSE if the directory cannot be used.
+
+Bool_t TFileBlockCache::SetGlobal(const char *directory, Long64_t maxSize, Int_t blockSize)
+{
+   delete fgGlobal;
+   fgGlobal = nullptr;
+   if (!directory || !*directory)
+      return kTRUE;
+
+   fgGlobal = new TFileBlockCache(directory, maxSize, blockSize);
+   if (!fgGlobal->IsValid()) {
+      delete fgGlobal;
+      fgGlobal = nullptr;
+      return kFALSE;
+   }
+   return kTRUE;
+}
@@ -40,6 +40,13 @@ to be merged, like the standalone hadd program.
 #include "TMemFile.h"
 #include "TVirtualMutex.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <memory>
+#include <vector>
+
 #ifdef WIN32
 // For _getmaxstdio
 #include <stdio.h>
@@ -55,6 +62,126 @@ ClassImp(TFileMerger);
 
 TClassRef R__TH1_Class("TH1");
 TClassRef R__TTree_Class("TTree");
+TClassRef R__TGraph_Class("TGraph");
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Whether the objects of class cl can be merged concurrently with the other
+/// keys of the directory: only the classes whose Merge() is known not to touch
+/// any shared state. The TTrees, which are reset after the merge and write
+/// their baskets into the target file, are always merged sequentially.
+
+Bool_t R__CanMergeConcurrently(TClass *cl)
+{
+   return cl->GetMerge() && !cl->GetResetAfterMerge() &&
+          (cl->InheritsFrom(R__TH1_Class) || cl->InheritsFrom(R__TGraph_Class));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the merged object obj of class cl in the target directory under the
+/// name keyname. Return false if the object could not be written.
+
+Bool_t R__WriteMergedObject(TDirectory *target, TObject *obj, TClass *cl, const TString &keyname, Bool_t canBeMerged)
+{
+   Bool_t status = kTRUE;
+   if (cl->InheritsFrom( TCollection::Class() )) {
+      // Don't overwrite, if the object were not merged.
+      if ( obj->Write( keyname, canBeMerged ? TObject::kSingleKey | TObject::kOverwrite : TObject::kSingleKey) <= 0 ) {
+         status = kFALSE;
+      }
+      ((TCollection*)obj)->SetOwner();
+      delete obj;
+   } else {
+      // Don't overwrite, if the object were not merged.
+      // NOTE: this is probably wrong for emulated objects.
+      if (cl->IsTObject()) {
+         if ( obj->Write( keyname, canBeMerged ? TObject::kOverwrite : 0) <= 0) {
+            status = kFALSE;
+         }
+      } else {
+         if ( target->WriteObjectAny( (void*)obj, cl, keyname, canBeMerged ? "OverWrite" : "" ) <= 0) {
+            status = kFALSE;
+         }
+      }
+      cl->Destructor(obj); // just in case the class is not loaded.
+   }
+   return status;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// An object which can be merged concurrently (see R__CanMergeConcurrently)
+/// read from the first file together with the same-name objects of the other
+/// files, waiting to be merged concurrently with the other keys of the directory.
+
+struct TInFlightMerge {
+   TObject             *fObject;  ///< Object receiving the merge, written once merged
+   TClass              *fClass;   ///< Class of fObject
+   TString              fName;    ///< Name of the key
+   TList                fInputs;  ///< Objects to be merged into fObject
+   std::vector<TString> fSources; ///< Name of the file of each input, for the error messages
+   Bool_t               fOneGo;   ///< Whether all the inputs are merged in a single call
+   TFileMergeInfo       fInfo;    ///< Merge information of this series of objects
+
+   TInFlightMerge(TDirectory *target) : fInfo(target) {}
+};
+
+using InFlightMerges_t = std::vector<std::unique_ptr<TInFlightMerge>>;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the in-flight objects, concurrently when the implicit multi-threading
+/// is enabled, then write them in the target directory in the order in which
+/// their keys were read, so that the output does not depend on the scheduling.
+/// Return false if one of the objects could not be written.
+
+Bool_t R__MergeInFlight(TDirectory *target, InFlightMerges_t &inflight)
+{
+   auto mergeOne = [&inflight](UInt_t i) {
+      TInFlightMerge &merge = *inflight[i];
+      ROOT::MergeFunc_t func = merge.fClass->GetMerge();
+      if (merge.fOneGo || merge.fInputs.IsEmpty()) {
+         func(merge.fObject, &merge.fInputs, &merge.fInfo);
+         merge.fInfo.fIsFirst = kFALSE;
+         return;
+      }
+      TList inputs;
+      for (Int_t j = 0; j < merge.fInputs.GetSize(); ++j) {
+         inputs.Add(merge.fInputs.At(j));
+         Long64_t result = func(merge.fObject, &inputs, &merge.fInfo);
+         merge.fInfo.fIsFirst = kFALSE;
+         if (result < 0) {
+            Error("MergeRecursive", "calling Merge() on '%s' with the corresponding object in '%s'",
+                  merge.fObject->GetName(), merge.fSources[j].Data());
+         }
+         inputs.Clear();
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (inflight.size() > 1 && ROOT::IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(mergeOne, ROOT::TSeqU(inflight.size()));
+   } else
+#endif
+   {
+      for (UInt_t i = 0; i < inflight.size(); ++i)
+         mergeOne(i);
+   }
+
+   // The inputs are deleted here rather than in the tasks because they are
+   // registered in the (non thread safe) list of their source directory.
+   Bool_t status = kTRUE;
+   target->cd();
+   for (auto &merge : inflight) {
+      merge->fInputs.Delete();
+      if (!R__WriteMergedObject(target, merge->fObject, merge->fClass, merge->fName, kTRUE))
+         status = kFALSE;
+   }
+   inflight.clear();
+   return status;
+}
+
+} // namespace
 
 static const Int_t kCpProgress = BIT(14);
 static const Int_t kCintFileNumber = 100;
@@ -411,6 +538,16 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
       info.fOptions.Append(" fast");
    }
 
+   // Histograms and graphs are merged concurrently, by batches of at most
+   // fMaxObjectsInFlight objects, when the implicit multi-threading is on.
+   // The other objects are merged sequentially.
+   Bool_t concurrent = kFALSE;
+#ifdef R__USE_IMT
+   concurrent = ROOT::IsImplicitMTEnabled() && fMaxObjectsInFlight > 1 && !(type & kIncremental);
+#endif
+   InFlightMerges_t inflight;
+   Int_t ninflight = 0;
+
    TFile      *current_file;
    TDirectory *current_sourcedir;
    if (type & kIncremental) {
@@ -516,6 +653,56 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
             }
             Bool_t canBeMerged = kTRUE;
 
+            if (concurrent && R__CanMergeConcurrently(cl)) {
+               oldkeyname = key->GetName();
+               if (alreadyseen) {
+                  cl->Destructor(obj);
+                  continue;
+               }
+               std::unique_ptr<TInFlightMerge> merge(new TInFlightMerge(target));
+               merge->fObject = obj;
+               merge->fClass = cl;
+               merge->fName = key->GetName();
+               merge->fOneGo = fHistoOneGo && cl->InheritsFrom(R__TH1_Class);
+               merge->fInfo.fIOFeatures = fIOFeatures;
+               merge->fInfo.fOptions = info.fOptions;
+
+               // Read the same-name objects from all the other source files.
+               TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
+               for (; nextsource; nextsource = (TFile*)sourcelist->After( nextsource )) {
+                  TDirectory *ndir = nextsource->GetDirectory(path);
+                  if (!ndir) continue;
+                  ndir->cd();
+                  TKey *key2 = (TKey*)ndir->GetListOfKeys()->FindObject(key->GetName());
+                  if (!key2) continue;
+                  TObject *hobj = key2->ReadObj();
+                  if (!hobj) {
+                     Info("MergeRecursive", "could not read object for key {%s, %s}; skipping file %s",
+                          key->GetName(), key->GetTitle(), nextsource->GetName());
+                     continue;
+                  }
+                  // Set ownership for collections
+                  if (hobj->InheritsFrom(TCollection::Class())) {
+                     ((TCollection*)hobj)->SetOwner();
+                  }
+                  hobj->ResetBit(kMustCleanup);
+                  merge->fInputs.Add(hobj);
+                  merge->fSources.emplace_back(nextsource->GetName());
+               }
+               ninflight += 1 + merge->fInputs.GetSize();
+               inflight.push_back(std::move(merge));
+               if (ninflight >= fMaxObjectsInFlight) {
+                  if (!R__MergeInFlight(target, inflight)) status = kFALSE;
+                  ninflight = 0;
+               }
+               continue;
+            }
+            // Keep the order of the keys in the output.
+            if (!inflight.empty()) {
+               if (!R__MergeInFlight(target, inflight)) status = kFALSE;
+               ninflight = 0;
+            }
+
             if ( cl->InheritsFrom( TDirectory::Class() ) ) {
                // it's a subdirectory
 
@@ -746,26 +933,8 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                if (!(type&kIncremental) || dynamic_cast<TDirectory*>(obj)->GetFile() != target) {
                   delete obj;
                }
-            } else if (cl->InheritsFrom( TCollection::Class() )) {
-               // Don't overwrite, if the object were not merged.
-               if ( obj->Write( oldkeyname, canBeMerged ? TObject::kSingleKey | TObject::kOverwrite : TObject::kSingleKey) <= 0 ) {
-                  status = kFALSE;
-               }
-               ((TCollection*)obj)->SetOwner();
-               delete obj;
-            } else {
-               // Don't overwrite, if the object were not merged.
-               // NOTE: this is probably wrong for emulated objects.
-               if (cl->IsTObject()) {
-                  if ( obj->Write( oldkeyname, canBeMerged ? TObject::kOverwrite : 0) <= 0) {
-                     status = kFALSE;
-                  }
-               } else {
-                  if ( target->WriteObjectAny( (void*)obj, cl, oldkeyname, canBeMerged ? "OverWrite" : "" ) <= 0) {
-                     status = kFALSE;
-                  }
-               }
-               cl->Destructor(obj); // just in case the class is not loaded.
+            } else if (!R__WriteMergedObject(target, obj, cl, oldkeyname, canBeMerged)) {
+               status = kFALSE;
             }
             info.Reset();
          } // while ( ( TKey *key = (TKey*)nextkey() ) )
@@ -777,6 +946,9 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
          current_sourcedir = 0;
       }
    }
+   if (!inflight.empty() && !R__MergeInFlight(target, inflight)) {
+      status = kFALSE;
+   }
    // save modifications to the target directory.
    if (!(type&kIncremental)) {
       // In case of incremental build, we will call Write on the top directory/file, so we do not need
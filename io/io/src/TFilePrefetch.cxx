@@ -10,9 +10,7 @@
  *************************************************************************/
 
 #include "TFilePrefetch.h"
-#include "TTimeStamp.h"
-#include "TVirtualPerfStats.h"
-#include "TVirtualMonitoring.h"
+#include "TFileBlockCache.h"
 
 #include <iostream>
 #include <string>
@@ -100,24 +98,28 @@ void TFilePrefetch::WaitFinishPrefetch()
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Read one block and insert it in prefetchBuffers list.
+/// inCache is set if the block was entirely found in the cache (see SetCache()).
+/// Return kTRUE in case of failure, like TFile::ReadBuffers().
 
-void TFilePrefetch::ReadAsync(TFPBlock* block, Bool_t &inCache)
+Bool_t TFilePrefetch::ReadAsync(TFPBlock* block, Bool_t &inCache)
 {
-   char* path = 0;
-
-   if (CheckBlockInCache(path, block)){
-      block->SetBuffer(GetBlockFromCache(path, block->GetDataSize()));
-      inCache = kTRUE;
+   inCache = kFALSE;
+   if (fBlockCache) {
+      // Only this thread reads through the cache set with SetCache().
+      Long64_t misses = fBlockCache->GetMisses();
+      if (fBlockCache->ReadBuffers(fFile, block->GetBuffer(), block->GetPos(), block->GetLen(), block->GetNoElem()))
+         return kTRUE;
+      inCache = fBlockCache->GetMisses() == misses;
+      return kFALSE;
    }
-   else{
-      fFile->ReadBuffers(block->GetBuffer(), block->GetPos(), block->GetLen(), block->GetNoElem());
-      if (fFile->GetArchive()) {
-         for (Int_t i = 0; i < block->GetNoElem(); i++)
-            block->SetPos(i, block->GetPos(i) - fFile->GetArchiveOffset());
-      }
-      inCache =kFALSE;
+
+   if (fFile->ReadBuffers(block->GetBuffer(), block->GetPos(), block->GetLen(), block->GetNoElem()))
+      return kTRUE;
+   if (fFile->GetArchive()) {
+      for (Int_t i = 0; i < block->GetNoElem(); i++)
+         block->SetPos(i, block->GetPos(i) - fFile->GetArchiveOffset());
    }
-   delete[] path;
+   return kFALSE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -129,10 +131,10 @@ void TFilePrefetch::ReadListOfBlocks()
    TFPBlock*  block = 0;
 
    while((block = GetPendingBlock())){
-      ReadAsync(block, inCache);
+      if (ReadAsync(block, inCache))
+         Error("ReadListOfBlocks", "failed to read a block of %d pieces at %lld from %s", block->GetNoElem(),
+               block->GetPos(0), fFile->GetName());
       AddReadBlock(block);
-      if (!inCache)
-         SaveBlockInCache(block);
    }
 }
 
@@ -387,149 +389,22 @@ Int_t TFilePrefetch::SumHex(const char *hex)
    return result;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-/// Test if the block is in cache.
-
-Bool_t TFilePrefetch::CheckBlockInCache(char*& path, TFPBlock* block)
-{
-   if (fPathCache == "")
-      return false;
-
-   Bool_t found = false;
-   TString fullPath(fPathCache); // path of the cached files.
-
-   Int_t value = 0;
-
-   if (!gSystem->OpenDirectory(fullPath))
-      gSystem->mkdir(fullPath);
-
-   //dir is SHA1 value modulo 16; filename is the value of the SHA1(offset+len)
-   TMD5* md = new TMD5();
-
-   TString concatStr;
-   for (Int_t i=0; i < block->GetNoElem(); i++){
-      concatStr.Form("%lld", block->GetPos(i));
-      md->Update((UChar_t*)concatStr.Data(), concatStr.Length());
-   }
-
-   md->Final();
-   TString fileName( md->AsString() );
-   value = SumHex(fileName);
-   value = value % 16;
-   TString dirName;
-   dirName.Form("%i", value);
-
-   fullPath += "/" + dirName + "/" + fileName;
-
-   FileStat_t stat;
-   if (gSystem->GetPathInfo(fullPath, stat) == 0) {
-      path = new char[fullPath.Length() + 1];
-      strlcpy(path, fullPath,fullPath.Length() + 1);
-      found = true;
-   } else
-      found = false;
-
-   delete md;
-   return found;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// Return a buffer from cache.
-
-char* TFilePrefetch::GetBlockFromCache(const char* path, Int_t length)
-{
-   char *buffer = 0;
-   TString strPath = path;
-
-   strPath += "?filetype=raw";
-   TFile* file = new TFile(strPath);
-
-   Double_t start = 0;
-   if (gPerfStats != 0) start = TTimeStamp();
-
-   buffer = (char*) calloc(length, sizeof(char));
-   file->ReadBuffer(buffer, 0, length);
-
-   fFile->fBytesRead  += length;
-   fFile->fgBytesRead += length;
-   fFile->SetReadCalls(fFile->GetReadCalls() + 1);
-   fFile->fgReadCalls++;
-
-   if (gMonitoringWriter)
-      gMonitoringWriter->SendFileReadProgress(fFile);
-   if (gPerfStats != 0) {
-      gPerfStats->FileReadEvent(fFile, length, start);
-   }
-
-   file->Close();
-   delete file;
-   return buffer;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// Save the block content in cache.
-
-void TFilePrefetch::SaveBlockInCache(TFPBlock* block)
-{
-   if (fPathCache == "")
-      return;
-
-   //dir is SHA1 value modulo 16; filename is the value of the SHA1
-   TMD5* md = new TMD5();
-
-   TString concatStr;
-   for(Int_t i=0; i< block->GetNoElem(); i++){
-      concatStr.Form("%lld", block->GetPos(i));
-      md->Update((UChar_t*)concatStr.Data(), concatStr.Length());
-   }
-   md->Final();
-
-   TString fileName( md->AsString() );
-   Int_t value = SumHex(fileName);
-   value = value % 16;
-
-   TString fullPath( fPathCache );
-   TString dirName;
-   dirName.Form("%i", value);
-   fullPath += ("/" + dirName);
-
-   if (!gSystem->OpenDirectory(fullPath))
-      gSystem->mkdir(fullPath);
-
-   TFile* file = 0;
-   fullPath += ("/" + fileName);
-   FileStat_t stat;
-   if (gSystem->GetPathInfo(fullPath, stat) == 0) {
-      fullPath += "?filetype=raw";
-      file = TFile::Open(fullPath, "update");
-   } else{
-      fullPath += "?filetype=raw";
-      file = TFile::Open(fullPath, "new");
-   }
-
-   if (file) {
-      // coverity[unchecked_value] We do not print error message, have not error
-      // return code and close the file anyway, not need to check the return value.
-      file->WriteBuffer(block->GetBuffer(), block->GetDataSize());
-      file->Close();
-      delete file;
-   }
-   delete md;
-}
-
-
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the path of the cache directory.
+///
+/// The blocks are kept in a TFileBlockCache, so that they are shared with the
+/// other processes using the same directory and identified by the file they
+/// belong to.
 
 Bool_t TFilePrefetch::SetCache(const char* path)
 {
   fPathCache = path;
-
-  if (!gSystem->OpenDirectory(path)){
-    return (!gSystem->mkdir(path) ? true : false);
+  fBlockCache.reset(new TFileBlockCache(path));
+  if (!fBlockCache->IsValid()) {
+    fBlockCache.reset();
+    fPathCache = "";
+    return false;
   }
-
-  // Directory already exists
   return true;
 }
 
@@ -66,6 +66,12 @@
 
 #include "RZip.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <vector>
+
 const Int_t kTitleMax = 32000;
 #if 0
 const Int_t kMAXFILEBUFFER = 262144;
@@ -86,6 +92,108 @@ std::atomic<UInt_t> keyAbsNumber{0};
 
 ClassImp(TKey);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compress the nbytes of objbuf into target in chunks of kMAXZIPBUF bytes.
+/// Each chunk is compressed independently of the others, so when the implicit
+/// multi-threading is enabled they are compressed concurrently; the output is
+/// the same as when compressing them one after the other.
+/// Return the total compressed size or 0 if one of the chunks cannot be compressed.
+
+Int_t ZipChunks(char *target, char *objbuf, Int_t nbytes, Int_t cxlevel,
+                ROOT::RCompressionSetting::EAlgorithm::EValues cxAlgorithm)
+{
+   const Int_t nbuffers = 1 + (nbytes - 1) / kMAXZIPBUF;
+   std::vector<Int_t> nouts(nbuffers, 0);
+
+   // Each chunk is first written at the offset of its uncompressed data (the
+   // compressed output is never larger than its input) and then compacted.
+   auto zipChunk = [&](UInt_t i) {
+      Int_t bufmax = (i == UInt_t(nbuffers - 1)) ? nbytes - i * kMAXZIPBUF : kMAXZIPBUF;
+      Int_t nout = 0;
+      R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf + i * kMAXZIPBUF, &bufmax, target + i * kMAXZIPBUF, &nout,
+                              cxAlgorithm);
+      nouts[i] = nout;
+   };
+
+#ifdef R__USE_IMT
+   if (nbuffers > 1 && ROOT::IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(zipChunk, ROOT::TSeqU(nbuffers));
+   } else
+#endif
+   {
+      for (Int_t i = 0; i < nbuffers; ++i) {
+         zipChunk(i);
+         if (nouts[i] == 0 || nouts[i] >= nbytes) return 0;
+      }
+   }
+
+   Int_t noutot = 0;
+   for (Int_t i = 0; i < nbuffers; ++i) {
+      if (nouts[i] == 0 || nouts[i] >= nbytes) return 0; //this happens when the buffer cannot be compressed
+      if (i) memmove(target + noutot, target + i * kMAXZIPBUF, nouts[i]);
+      noutot += nouts[i];
+   }
+   return noutot;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Uncompress the chunks starting at bufcur into objbuf until objlen bytes are
+/// produced. The chunk headers are read first so that, when the implicit
+/// multi-threading is enabled, the chunks are uncompressed concurrently.
+/// Return false if one of the chunks could not be uncompressed.
+
+Bool_t UnzipChunks(char *objbuf, UChar_t *bufcur, Int_t objlen)
+{
+   struct Chunk {
+      UChar_t *fSource;
+      char *fTarget;
+      Int_t fNin;
+      Int_t fNbuf;
+      Int_t fNout;
+   };
+   std::vector<Chunk> chunks;
+   Int_t noutot = 0;
+   while (noutot < objlen) {
+      Int_t nin, nbuf;
+      Int_t hc = R__unzip_header(&nin, bufcur, &nbuf);
+      if (hc != 0) break;
+      nbuf = TMath::Min(nbuf, objlen - noutot);
+      chunks.push_back({bufcur, objbuf, nin, nbuf, 0});
+      noutot += nbuf;
+      bufcur += nin;
+      objbuf += nbuf;
+   }
+   if (chunks.empty()) return kFALSE;
+
+   auto unzipChunk = [&](UInt_t i) {
+      Chunk &chunk = chunks[i];
+      R__unzip(&chunk.fNin, chunk.fSource, &chunk.fNbuf, (unsigned char *)chunk.fTarget, &chunk.fNout);
+   };
+
+#ifdef R__USE_IMT
+   if (chunks.size() > 1 && ROOT::IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(unzipChunk, ROOT::TSeqU(chunks.size()));
+   } else
+#endif
+   {
+      for (UInt_t i = 0; i < chunks.size(); ++i) {
+         unzipChunk(i);
+         if (!chunks[i].fNout) return kFALSE;
+      }
+   }
+
+   for (const auto &chunk : chunks) {
+      if (!chunk.fNout) return kFALSE;
+   }
+   return kTRUE;
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TKey default constructor.
 
@@ -240,7 +348,7 @@ TKey::TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* moth
 
    Build(motherDir, obj->ClassName(), -1);
 
-   Int_t lbuf, nout, noutot, bufmax, nzip;
+   Int_t lbuf, noutot;
    fBufferRef = new TBufferFile(TBuffer::kWrite, bufsize);
    fBufferRef->SetParent(GetFile());
    fCycle     = fMotherDir->AppendKey(this);
@@ -259,24 +367,14 @@ TKey::TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* moth
       Int_t buflen = TMath::Max(512,fKeylen + fObjlen + 9*nbuffers + 28); //add 28 bytes in case object is placed in a deleted gap
       fBuffer = new char[buflen];
       char *objbuf = fBufferRef->Buffer() + fKeylen;
-      char *bufcur = &fBuffer[fKeylen];
-      noutot = 0;
-      nzip   = 0;
-      for (Int_t i = 0; i < nbuffers; ++i) {
-         if (i == nbuffers - 1) bufmax = fObjlen - nzip;
-         else               bufmax = kMAXZIPBUF;
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
-         if (nout == 0 || nout >= fObjlen) { //this happens when the buffer cannot be compressed
-            fBuffer = fBufferRef->Buffer();
-            Create(fObjlen);
-            fBufferRef->SetBufferOffset(0);
-            Streamer(*fBufferRef);         //write key itself again
-            return;
-         }
-         bufcur += nout;
-         noutot += nout;
-         objbuf += kMAXZIPBUF;
-         nzip   += kMAXZIPBUF;
+      noutot = ZipChunks(&fBuffer[fKeylen], objbuf, fObjlen, cxlevel, cxAlgorithm);
+      if (noutot == 0) { //this happens when the buffer cannot be compressed
+         delete [] fBuffer;
+         fBuffer = fBufferRef->Buffer();
+         Create(fObjlen);
+         fBufferRef->SetBufferOffset(0);
+         Streamer(*fBufferRef);         //write key itself again
+         return;
       }
       Create(noutot);
       fBufferRef->SetBufferOffset(0);
@@ -336,7 +434,7 @@ TKey::TKey(const void *obj, const TClass *cl, const char *name, Int_t bufsize, T
    Streamer(*fBufferRef);         //write key itself
    fKeylen    = fBufferRef->Length();
 
-   Int_t lbuf, nout, noutot, bufmax, nzip;
+   Int_t lbuf, noutot;
 
    fBufferRef->MapObject(actualStart,clActual);         //register obj in map in case of self reference
    clActual->Streamer((void*)actualStart, *fBufferRef); //write object
@@ -350,24 +448,14 @@ TKey::TKey(const void *obj, const TClass *cl, const char *name, Int_t bufsize, T
       Int_t buflen = TMath::Max(512,fKeylen + fObjlen + 9*nbuffers + 28); //add 28 bytes in case object is placed in a deleted gap
       fBuffer = new char[buflen];
       char *objbuf = fBufferRef->Buffer() + fKeylen;
-      char *bufcur = &fBuffer[fKeylen];
-      noutot = 0;
-      nzip   = 0;
-      for (Int_t i = 0; i < nbuffers; ++i) {
-         if (i == nbuffers - 1) bufmax = fObjlen - nzip;
-         else               bufmax = kMAXZIPBUF;
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
-         if (nout == 0 || nout >= fObjlen) { //this happens when the buffer cannot be compressed
-            fBuffer = fBufferRef->Buffer();
-            Create(fObjlen);
-            fBufferRef->SetBufferOffset(0);
-            Streamer(*fBufferRef);         //write key itself again
-            return;
-         }
-         bufcur += nout;
-         noutot += nout;
-         objbuf += kMAXZIPBUF;
-         nzip   += kMAXZIPBUF;
+      noutot = ZipChunks(&fBuffer[fKeylen], objbuf, fObjlen, cxlevel, cxAlgorithm);
+      if (noutot == 0) { //this happens when the buffer cannot be compressed
+         delete [] fBuffer;
+         fBuffer = fBufferRef->Buffer();
+         Create(fObjlen);
+         fBufferRef->SetBufferOffset(0);
+         Streamer(*fBufferRef);         //write key itself again
+         return;
       }
       Create(noutot);
       fBufferRef->SetBufferOffset(0);
@@ -799,19 +887,8 @@ TObject *TKey::ReadObj()
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = fBufferRef->Buffer() + fKeylen;
       UChar_t *bufcur = (UChar_t *)&fBuffer[fKeylen];
-      Int_t nin, nout = 0, nbuf;
-      Int_t noutot = 0;
-      while (1) {
-         Int_t hc = R__unzip_header(&nin, bufcur, &nbuf);
-         if (hc!=0) break;
-         R__unzip(&nin, bufcur, &nbuf, (unsigned char*) objbuf, &nout);
-         if (!nout) break;
-         noutot += nout;
-         if (noutot >= fObjlen) break;
-         bufcur += nin;
-         objbuf += nout;
-      }
-      if (nout) {
+      Bool_t unzipped = UnzipChunks(objbuf, bufcur, fObjlen);
+      if (unzipped) {
          tobj->Streamer(*fBufferRef); //does not work with example 2 above
          delete [] fBuffer;
       } else {
@@ -930,19 +1007,8 @@ TObject *TKey::ReadObjWithBuffer(char *bufferRead)
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = fBufferRef->Buffer() + fKeylen;
       UChar_t *bufcur = (UChar_t *)&fBuffer[fKeylen];
-      Int_t nin, nout = 0, nbuf;
-      Int_t noutot = 0;
-      while (1) {
-         Int_t hc = R__unzip_header(&nin, bufcur, &nbuf);
-         if (hc!=0) break;
-         R__unzip(&nin, bufcur, &nbuf, (unsigned char*) objbuf, &nout);
-         if (!nout) break;
-         noutot += nout;
-         if (noutot >= fObjlen) break;
-         bufcur += nin;
-         objbuf += nout;
-      }
-      if (nout) {
+      Bool_t unzipped = UnzipChunks(objbuf, bufcur, fObjlen);
+      if (unzipped) {
          tobj->Streamer(*fBufferRef); //does not work with example 2 above
       } else {
          // Even-though we have a TObject, if the class is emulated the virtual
@@ -1077,19 +1143,8 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = fBufferRef->Buffer() + fKeylen;
       UChar_t *bufcur = (UChar_t *)&fBuffer[fKeylen];
-      Int_t nin, nout = 0, nbuf;
-      Int_t noutot = 0;
-      while (1) {
-         Int_t hc = R__unzip_header(&nin, bufcur, &nbuf);
-         if (hc!=0) break;
-         R__unzip(&nin, bufcur, &nbuf, (unsigned char*) objbuf, &nout);
-         if (!nout) break;
-         noutot += nout;
-         if (noutot >= fObjlen) break;
-         bufcur += nin;
-         objbuf += nout;
-      }
-      if (nout) {
+      Bool_t unzipped = UnzipChunks(objbuf, bufcur, fObjlen);
+      if (unzipped) {
          cl->Streamer((void*)pobj, *fBufferRef, clOnfile);    //read object
          delete [] fBuffer;
       } else {
@@ -1168,19 +1223,8 @@ Int_t TKey::Read(TObject *obj)
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = fBufferRef->Buffer() + fKeylen;
       UChar_t *bufcur = (UChar_t *)&fBuffer[fKeylen];
-      Int_t nin, nout = 0, nbuf;
-      Int_t noutot = 0;
-      while (1) {
-         Int_t hc = R__unzip_header(&nin, bufcur, &nbuf);
-         if (hc!=0) break;
-         R__unzip(&nin, bufcur, &nbuf, (unsigned char*) objbuf, &nout);
-         if (!nout) break;
-         noutot += nout;
-         if (noutot >= fObjlen) break;
-         bufcur += nin;
-         objbuf += nout;
-      }
-      if (nout) obj->Streamer(*fBufferRef);
+      Bool_t unzipped = UnzipChunks(objbuf, bufcur, fObjlen);
+      if (unzipped) obj->Streamer(*fBufferRef);
       delete [] fBuffer;
    } else {
       obj->Streamer(*fBufferRef);
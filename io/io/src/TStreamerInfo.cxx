@@ -75,6 +75,9 @@ element type.
 
 #include <memory>
 #include <array>
+#include <set>
+#include <string>
+#include <unordered_map>
 
 std::atomic<Int_t> TStreamerInfo::fgCount{0};
 
@@ -168,6 +171,9 @@ TStreamerInfo::TStreamerInfo()
    fWriteMemberWise = 0;
    fWriteMemberWiseVecPtr = 0;
    fWriteText = 0;
+   fJitState = kJitOff;
+   fJitReader = nullptr;
+   fJitWriter = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -203,6 +209,9 @@ TStreamerInfo::TStreamerInfo(TClass *cl)
    fWriteMemberWise = 0;
    fWriteMemberWiseVecPtr = 0;
    fWriteText = 0;
+   fJitState = kJitOff;
+   fJitReader = nullptr;
+   fJitWriter = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2557,6 +2566,9 @@ void TStreamerInfo::Clear(Option_t *option)
       fSize = 0;
       ResetIsCompiled();
       ResetBit(kBuildOldUsed);
+      fJitState = kJitOff;
+      fJitReader = nullptr;
+      fJitWriter = nullptr;
 
       if (fReadObjectWise) fReadObjectWise->fActions.clear();
       if (fReadMemberWise) fReadMemberWise->fActions.clear();
@@ -4534,6 +4546,254 @@ void TStreamerInfo::InsertArtificialElements(std::vector<const ROOT::TSchemaRule
    } // None of the target of the rule are on file.
 }
 
+namespace {
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Names of the classes whose streamers are natively compiled (see TStreamerInfo::SetJitStreamers)
+
+   std::set<std::string> &JitClassNames()
+   {
+      static std::set<std::string> gJitClassNames;
+      return gJitClassNames;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Return the name of the type used in memory by the basic type 'type' or
+   /// nullptr if the type is not streamed inline by the natively compiled streamers.
+
+   const char *JitBasicTypeName(Int_t type)
+   {
+      switch (type) {
+         case TStreamerInfo::kBool:     return "Bool_t";
+         case TStreamerInfo::kChar:     return "Char_t";
+         case TStreamerInfo::kShort:    return "Short_t";
+         case TStreamerInfo::kInt:      return "Int_t";
+         case TStreamerInfo::kLong:     return "Long_t";
+         case TStreamerInfo::kLong64:   return "Long64_t";
+         case TStreamerInfo::kFloat:    return "Float_t";
+         case TStreamerInfo::kDouble:   return "Double_t";
+         case TStreamerInfo::kUChar:    return "UChar_t";
+         case TStreamerInfo::kUShort:   return "UShort_t";
+         case TStreamerInfo::kUInt:     return "UInt_t";
+         case TStreamerInfo::kULong:    return "ULong_t";
+         case TStreamerInfo::kULong64:  return "ULong64_t";
+         case TStreamerInfo::kFloat16:  return "Float_t";
+         case TStreamerInfo::kDouble32: return "Double_t";
+         default: return nullptr;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Compile the streamer function whose signature and body is 'body'.
+   /// Identical bodies, for example of the same layout seen in several files,
+   /// share the same function. Must be called with gInterpreterMutex taken.
+
+   TStreamerInfo::JitStreamer_t CompileJitStreamer(const std::string &body)
+   {
+      static std::unordered_map<std::string, TStreamerInfo::JitStreamer_t> gJitStreamers;
+      auto funcit = gJitStreamers.find(body);
+      if (funcit != gJitStreamers.end()) return funcit->second;
+
+      // to be sure the interpreter is initialized
+      ROOT::GetROOT();
+      R__ASSERT(gInterpreter);
+
+      static Bool_t headersDeclared = gInterpreter->Declare("#include \"TBuffer.h\"\n#include \"TStreamerInfo.h\"\n");
+      if (!headersDeclared) return nullptr;
+
+      std::string name = TString::Format("R__TStreamerInfoJit_%zu", std::hash<std::string>()(body)).Data();
+      if (!gInterpreter->Declare(("void " + name + body).c_str())) return nullptr;
+      TInterpreter::EErrorCode errorCode;
+      auto func = (TStreamerInfo::JitStreamer_t)gInterpreter->Calc(("(long)&" + name).c_str(), &errorCode);
+      if (errorCode != TInterpreter::kNoError) return nullptr;
+      gJitStreamers.insert(std::make_pair(body, func));
+      return func;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the streamers of 'cl' were requested to be natively compiled.
+
+Bool_t TStreamerInfo::IsJitRequested(const TClass *cl)
+{
+   if (!cl) return kFALSE;
+   R__LOCKGUARD(gInterpreterMutex);
+   return JitClassNames().count(cl->GetName()) != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Request (or stop requesting) natively compiled streamers for the class
+/// 'classname'.
+///
+/// For each compiled StreamerInfo of the class, i.e. for each pair of on-file
+/// version and in-memory layout, a straight-line C++ function reading and one
+/// writing the object is generated and compiled with the interpreter the first
+/// time an object is streamed. The basic data members and the fixed size arrays
+/// of basic types are streamed inline, without going through the per member
+/// dispatch of the action sequence; the other members (base classes, objects,
+/// collections, including the ones streamed member-wise) are streamed by the
+/// same code as the action sequence, see JitReadElement.
+///
+/// StreamerInfos that require a conversion of a data member, skip data members
+/// or apply schema evolution rules keep using the action sequences.
+///
+/// Only the whole-object streaming (TBuffer::ReadClassBuffer and
+/// WriteClassBuffer) uses the native streamers, in particular for the objects
+/// stored in keys and in unsplit branches. The split TBranchElements read and
+/// write a subset of the data members with their own action sequences and are
+/// not affected.
+
+void TStreamerInfo::SetJitStreamers(const char *classname, Bool_t enable)
+{
+   if (!classname || !classname[0]) return;
+   TClass *cl = TClass::GetClass(classname, kFALSE, kTRUE);
+
+   R__LOCKGUARD(gInterpreterMutex);
+   const std::string name = cl ? cl->GetName() : classname;
+   if (enable) JitClassNames().insert(name);
+   else JitClassNames().erase(name);
+
+   if (!cl) return;
+   const TObjArray *infos = cl->GetStreamerInfos();
+   for (Int_t i = infos->LowerBound(); i <= infos->GetLast(); ++i) {
+      auto info = dynamic_cast<TStreamerInfo *>(infos->At(i));
+      if (!info || !info->IsCompiled()) continue;
+      if (enable) {
+         if (info->fJitState == kJitOff) info->fJitState = kJitPending;
+      } else {
+         info->fJitState = kJitOff;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the signature and body of the natively compiled read and write
+/// streamers. Return false if this StreamerInfo requires schema evolution
+/// that is only supported by the action sequences.
+
+Bool_t TStreamerInfo::GenerateJitStreamers(std::string &readBody, std::string &writeBody) const
+{
+   readBody = writeBody = "(TBuffer &b, char *obj, TStreamerInfo *info, TStreamerInfo::TCompInfo_t *const *compinfo)\n{\n";
+   for (Int_t i = 0; i < fNdata; ++i) {
+      const TCompInfo *comp = fCompOpt[i];
+      TStreamerElement *element = comp->fElem;
+      // Same as in Compile, no action is created for these.
+      if (!element || element->GetType() < 0) continue;
+
+      const Int_t type = comp->fType;
+      if ((type >= kSkip && type < kSTL) || type >= kCache)
+         return kFALSE;
+      if (element->TestBit(TStreamerElement::kCache) || element->TestBit(TStreamerElement::kWrite) ||
+          element->TestBit(TStreamerElement::kRepeat))
+         return kFALSE;
+
+      const Bool_t isArray = type > kOffsetL && type < kOffsetP;
+      const Int_t basic = isArray ? type - kOffsetL : type;
+      const char *typeName = JitBasicTypeName(basic);
+      if (!typeName) {
+         readBody += TString::Format("   TStreamerInfo::JitReadElement(b, obj, info, %d);\n", i).Data();
+         writeBody += TString::Format("   TStreamerInfo::JitWriteElement(b, obj, info, %d);\n", i).Data();
+         continue;
+      }
+
+      TString address = TString::Format("(%s*)(obj+%d)", typeName, comp->fOffset);
+      if (basic == kFloat16 || basic == kDouble32) {
+         const char *what = basic == kFloat16 ? "Float16" : "Double32";
+         if (isArray) {
+            readBody += TString::Format("   b.ReadFastArray%s(%s, %d, compinfo[%d]->fElem);\n", what, address.Data(), comp->fLength, i).Data();
+            writeBody += TString::Format("   b.WriteFastArray%s(%s, %d, compinfo[%d]->fElem);\n", what, address.Data(), comp->fLength, i).Data();
+         } else {
+            readBody += TString::Format("   b.Read%s(%s, compinfo[%d]->fElem);\n", what, address.Data(), i).Data();
+            writeBody += TString::Format("   b.Write%s(%s, compinfo[%d]->fElem);\n", what, address.Data(), i).Data();
+         }
+      } else if (isArray) {
+         readBody += TString::Format("   b.ReadFastArray(%s, %d);\n", address.Data(), comp->fLength).Data();
+         writeBody += TString::Format("   b.WriteFastArray(%s, %d);\n", address.Data(), comp->fLength).Data();
+      } else {
+         readBody += TString::Format("   b >> *%s;\n", address.Data()).Data();
+         writeBody += TString::Format("   b << *%s;\n", address.Data()).Data();
+      }
+   }
+   readBody += "}\n";
+   writeBody += "}\n";
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate and compile the straight-line read and write streamers of this
+/// StreamerInfo (see SetJitStreamers). Return false, and keep using the action
+/// sequences, if the StreamerInfo is not compiled, requires schema evolution
+/// not supported by the native streamers or if the compilation fails.
+
+Bool_t TStreamerInfo::JitCompile()
+{
+   R__LOCKGUARD(gInterpreterMutex);
+   if (fJitState == kJitDone) return fJitReader != nullptr;
+   if (!IsCompiled()) return kFALSE;
+
+   fJitReader = nullptr;
+   fJitWriter = nullptr;
+   std::string readBody, writeBody;
+   if (GenerateJitStreamers(readBody, writeBody)) {
+      fJitReader = CompileJitStreamer(readBody);
+      fJitWriter = CompileJitStreamer(writeBody);
+      if (!fJitReader || !fJitWriter) {
+         Warning("JitCompile", "Could not compile the streamers of %s version %d, using the streamer actions.",
+                 GetName(), fClassVersion);
+         fJitReader = nullptr;
+         fJitWriter = nullptr;
+      }
+   }
+   fJitState = kJitDone;
+   return fJitReader != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the data member 'i' of the optimized list of elements of 'info' with the
+/// generic code; used by the natively compiled streamers for the members they do
+/// not stream inline.
+
+void TStreamerInfo::JitReadElement(TBuffer &b, char *obj, TStreamerInfo *info, Int_t i)
+{
+   info->ReadBuffer(b, &obj, &(info->fCompOpt[i]), /*first*/ 0, /*last*/ 1, /*narr*/ 1, /*eoffset*/ 0, 2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the data member 'i' of the optimized list of elements of 'info' with the
+/// generic code; used by the natively compiled streamers for the members they do
+/// not stream inline.
+
+void TStreamerInfo::JitWriteElement(TBuffer &b, char *obj, TStreamerInfo *info, Int_t i)
+{
+   info->WriteBufferAux(b, &obj, &(info->fCompOpt[i]), /*first*/ 0, /*last*/ 1, /*narr*/ 1, /*eoffset*/ 0, 2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize obj with the natively compiled streamer, compiling it first if it
+/// was requested. Return false if there is none and the action sequence must be
+/// used instead. Only called for whole objects: the split TBranchElements keep
+/// reading their data members with their own action sequences.
+
+Bool_t TStreamerInfo::JitReadObject(TBuffer &b, void *obj)
+{
+   if (fJitState == kJitOff || (fJitState == kJitPending && !JitCompile()) || !fJitReader)
+      return kFALSE;
+   fJitReader(b, (char *)obj, this, fCompOpt);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Serialize obj with the natively compiled streamer, compiling it first if it
+/// was requested. Return false if there is none and the action sequence must be
+/// used instead.
+
+Bool_t TStreamerInfo::JitWriteObject(TBuffer &b, void *obj)
+{
+   if (fJitState == kJitOff || (fJitState == kJitPending && !JitCompile()) || !fJitWriter)
+      return kFALSE;
+   fJitWriter(b, (char *)obj, this, fCompOpt);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///  List the TStreamerElement list and also the precomputed tables
 ///  if option contains the string "incOrig", also prints the original
@@ -2977,6 +2977,9 @@ void TStreamerInfo::Compile()
    fOptimized = kFALSE;
    fNdata = 0;
    fNfulldata = 0;
+   fJitState = kJitOff;
+   fJitReader = nullptr;
+   fJitWriter = nullptr;
 
    TObjArray* infos = (TObjArray*) gROOT->GetListOfStreamerInfo();
    if (fNumber >= infos->GetSize()) {
@@ -3196,6 +3199,9 @@ void TStreamerInfo::Compile()
    fOptimized = isOptimized;
    SetIsCompiled();
 
+   // The native streamers are compiled lazily, on first use (see TStreamerInfo::JitReadObject and JitCompile).
+   if (IsJitRequested(fClass)) fJitState = kJitPending;
+
    if (gDebug > 0) {
       ls();
    }
@@ -0,0 +1,146 @@
+#include "TAttAxis.h"
+#include "TBufferFile.h"
+#include "TNamed.h"
+#include "TStreamerInfo.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+const std::vector<Int_t> kSizes{1, 3, 7, 16, 33, 100, 1000};
+
+template <typename T>
+std::vector<T> MakeValues(Int_t n)
+{
+   std::vector<T> values(n);
+   for (Int_t i = 0; i < n; ++i) {
+      Double_t x = (i % 2 ? -1 : 1) * (i * 1234567.891 + 0.3 * i * i);
+      values[i] = std::is_integral<T>::value ? (T)(Long64_t)x : (T)x;
+   }
+   return values;
+}
+
+// Compare the array version of the streaming with the element by element one.
+template <typename T>
+void CheckFastArray()
+{
+   for (auto n : kSizes) {
+      auto values = MakeValues<T>(n);
+      TBufferFile array(TBuffer::kWrite);
+      TBufferFile single(TBuffer::kWrite);
+      array.WriteFastArray(values.data(), n);
+      for (auto v : values)
+         single << v;
+      ASSERT_EQ(array.Length(), single.Length());
+      EXPECT_EQ(0, memcmp(array.Buffer(), single.Buffer(), array.Length())) << "n = " << n;
+
+      TBufferFile reader(TBuffer::kRead, array.Length(), array.Buffer(), kFALSE);
+      std::vector<T> read(n);
+      reader.ReadFastArray(read.data(), n);
+      EXPECT_EQ(values, read);
+      EXPECT_EQ(reader.Length(), array.Length());
+   }
+}
+
+} // anonymous namespace
+
+TEST(TBufferFile, FastArrays)
+{
+   CheckFastArray<Short_t>();
+   CheckFastArray<Int_t>();
+   CheckFastArray<Long64_t>();
+   CheckFastArray<Float_t>();
+   CheckFastArray<Double_t>();
+}
+
+TEST(TBufferFile, TruncatedFloatArrays)
+{
+   for (auto n : kSizes) {
+      auto values = MakeValues<Float_t>(n);
+      values[0] = 0.f;
+      if (n > 2) {
+         values[1] = -0.f;
+         values[2] = INFINITY;
+      }
+      TBufferFile array(TBuffer::kWrite);
+      TBufferFile single(TBuffer::kWrite);
+      array.WriteFastArrayFloat16(values.data(), n);
+      for (auto &v : values)
+         single.WriteFloat16(&v);
+      ASSERT_EQ(array.Length(), single.Length());
+      EXPECT_EQ(0, memcmp(array.Buffer(), single.Buffer(), array.Length())) << "n = " << n;
+
+      TBufferFile reader(TBuffer::kRead, array.Length(), array.Buffer(), kFALSE);
+      TBufferFile singleReader(TBuffer::kRead, single.Length(), single.Buffer(), kFALSE);
+      std::vector<Float_t> read(n);
+      std::vector<Double_t> readDouble(n);
+      reader.ReadFastArrayWithNbits(read.data(), n, 12);
+      reader.SetBufferOffset(0);
+      reader.ReadFastArrayWithNbits(readDouble.data(), n, 12);
+      for (Int_t i = 0; i < n; ++i) {
+         Float_t expected;
+         singleReader.ReadWithNbits(&expected, 12);
+         EXPECT_EQ(0, memcmp(&expected, &read[i], sizeof(Float_t))) << "n = " << n << " i = " << i;
+         EXPECT_EQ((Double_t)expected, readDouble[i]);
+      }
+   }
+}
+
+TEST(TBufferFile, Double32AsFloatArrays)
+{
+   for (auto n : kSizes) {
+      auto values = MakeValues<Double_t>(n);
+      TBufferFile array(TBuffer::kWrite);
+      array.WriteFastArrayDouble32(values.data(), n);
+      EXPECT_EQ(array.Length(), Int_t(sizeof(Float_t) * n));
+
+      TBufferFile reader(TBuffer::kRead, array.Length(), array.Buffer(), kFALSE);
+      std::vector<Double_t> read(n);
+      reader.ReadFastArrayDouble32(read.data(), n);
+      for (Int_t i = 0; i < n; ++i)
+         EXPECT_EQ((Double_t)(Float_t)values[i], read[i]);
+   }
+}
+
+TEST(TBufferFile, JitStreamers)
+{
+   TAttAxis axis;
+   axis.SetNdivisions(7);
+   axis.SetLabelSize(0.5);
+   axis.SetTitleColor(3);
+   TNamed named("name", "title");
+
+   TBufferFile reference(TBuffer::kWrite);
+   axis.Streamer(reference);
+   named.Streamer(reference);
+
+   TStreamerInfo::SetJitStreamers("TAttAxis");
+   TStreamerInfo::SetJitStreamers("TNamed");
+   TBufferFile jitted(TBuffer::kWrite);
+   axis.Streamer(jitted);
+   named.Streamer(jitted);
+   auto info = static_cast<TStreamerInfo *>(TAttAxis::Class()->GetStreamerInfo());
+   EXPECT_TRUE(info->IsJitted());
+   ASSERT_EQ(reference.Length(), jitted.Length());
+   EXPECT_EQ(0, memcmp(reference.Buffer(), jitted.Buffer(), reference.Length()));
+
+   TBufferFile reader(TBuffer::kRead, jitted.Length(), jitted.Buffer(), kFALSE);
+   TAttAxis readAxis;
+   TNamed readNamed;
+   readAxis.Streamer(reader);
+   readNamed.Streamer(reader);
+   EXPECT_EQ(7, readAxis.GetNdivisions());
+   EXPECT_EQ(0.5, readAxis.GetLabelSize());
+   EXPECT_EQ(3, readAxis.GetTitleColor());
+   EXPECT_STREQ("name", readNamed.GetName());
+   EXPECT_STREQ("title", readNamed.GetTitle());
+
+   TStreamerInfo::SetJitStreamers("TAttAxis", kFALSE);
+   TStreamerInfo::SetJitStreamers("TNamed", kFALSE);
+   EXPECT_FALSE(info->IsJitted());
+}
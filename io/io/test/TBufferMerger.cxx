@@ -4,6 +4,7 @@
 #include "ROOT/TTaskGroup.hxx"
 
 #include "TFile.h"
+#include "TMemFile.h"
 #include "TROOT.h"
 #include "TTree.h"
 
@@ -176,6 +177,95 @@ TEST(TBufferMerger, AutoSave)
    RemoveFile("tbuffermerger_autosave.root");
 }
 
+TEST(TBufferMerger, MemoryBudgetAndConcurrentMerge)
+{
+   int nevents = 16384;
+   int nthreads = 8;
+   int nwrites = 4;
+   int events_per_write = nevents / nthreads / nwrites;
+
+   ROOT::EnableThreadSafety();
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+
+   // Size of the buffer pushed by one write of a producer.
+   size_t bufferSize = 0;
+   {
+      TMemFile f("tbuffermerger_budget.root", "RECREATE");
+      auto tree = new TTree("mytree", "mytree");
+      Fill(tree, 0, events_per_write);
+      f.Write();
+      bufferSize = f.GetSize();
+   }
+
+   {
+      TBufferMerger merger("tbuffermerger_budget.root");
+
+      // Only the budget triggers the merges: a producer pushing a third buffer
+      // blocks and merges the two buffers held, concurrently with IMT.
+      merger.SetAutoSave(64 * 1024 * 1024);
+      merger.SetMaxBufferedBytes(2 * bufferSize + bufferSize / 2);
+      merger.SetMergeConcurrency(4);
+
+      std::vector<std::thread> threads;
+      for (int i = 0; i < nthreads; ++i) {
+         threads.emplace_back([=, &merger]() {
+            auto myfile = merger.GetFile();
+            auto mytree = new TTree("mytree", "mytree");
+            mytree->ResetBit(kMustCleanup);
+
+            int n = 0;
+            mytree->Branch("n", &n, "n/I");
+            for (int w = 0; w < nwrites; ++w) {
+               for (int j = 0; j < events_per_write; ++j) {
+                  n = (i * nwrites + w) * events_per_write + j;
+                  mytree->Fill();
+               }
+               myfile->Write();
+            }
+            mytree->ResetBranchAddresses();
+         });
+      }
+
+      for (auto &&t : threads)
+         t.join();
+
+      EXPECT_GT(merger.GetNMerges(), 0u);
+      EXPECT_GT(merger.GetMaxQueueSize(), 1u);
+      EXPECT_LE(merger.GetLastMergeLatency(), merger.GetTotalMergeTime());
+      EXPECT_GT(merger.GetNBlocked(), 0u);
+      EXPECT_GT(merger.GetTotalBlockedTime(), 0.);
+#ifdef R__USE_IMT
+      EXPECT_GT(merger.GetNConcurrentMerges(), 0u);
+#endif
+   }
+
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+
+   {
+      TFile f("tbuffermerger_budget.root");
+      auto t = (TTree *)f.Get("mytree");
+      ASSERT_TRUE(t != nullptr);
+
+      int n;
+      long long sum = 0;
+      int nentries = (int)t->GetEntries();
+      t->SetBranchAddress("n", &n);
+      for (int i = 0; i < nentries; ++i) {
+         t->GetEntry(i);
+         sum += n;
+      }
+
+      EXPECT_EQ(nevents, nentries);
+      EXPECT_EQ((long long)nevents * (nevents - 1) / 2, sum);
+   }
+
+   RemoveFile("tbuffermerger_budget.root");
+}
+
 TEST(TBufferMerger, CheckTreeFillResults)
 {
    int sum_s, sum_p;
@@ -1,6 +1,11 @@
 #include "TFileMerger.h"
 
+#include "TH1F.h"
+#include "TKey.h"
 #include "TMemFile.h"
+#include "TNamed.h"
+#include "TROOT.h"
+#include "TSystem.h"
 #include "TTree.h"
 
 #include "gtest/gtest.h"
@@ -96,3 +101,70 @@ TEST(TFileMerger, CreateWithUnwritableTFilePointer)
    output->SetWritable(false);
    EXPECT_ROOT_ERROR(merger.OutputFile(std::move(output)), "Error in .* output file output.root is not writable\n");
 }
+
+#ifdef R__USE_IMT
+static void CreateHistos(TMemFile &file, Int_t nhistos, Double_t value)
+{
+   file.cd();
+   for (Int_t i = 0; i < nhistos; ++i) {
+      auto h = new TH1F(TString::Format("h%d", i), "A histogram", 10, 0, 10);
+      h->Fill(i % 10, value);
+      if (i == nhistos / 2) {
+         TNamed named("named", "Not mergeable");
+         named.Write();
+      }
+   }
+   file.Write();
+}
+
+static void MergeInto(const char *output, TMemFile &a, TMemFile &b, Int_t maxInFlight)
+{
+   TFileMerger merger(kFALSE);
+   ASSERT_TRUE(merger.OutputFile(output, "RECREATE"));
+   merger.SetMaxObjectsInFlight(maxInFlight);
+   merger.AddFile(&a, kFALSE);
+   merger.AddFile(&b, kFALSE);
+   EXPECT_TRUE(merger.Merge());
+}
+
+static void CompareMergedFiles(const char *serialName, const char *concurrentName)
+{
+   TFile serial(serialName);
+   TFile concurrent(concurrentName);
+   auto serialKeys = serial.GetListOfKeys();
+   auto concurrentKeys = concurrent.GetListOfKeys();
+   ASSERT_EQ(101, serialKeys->GetSize());
+   ASSERT_EQ(serialKeys->GetSize(), concurrentKeys->GetSize());
+   for (Int_t i = 0; i < serialKeys->GetSize(); ++i) {
+      auto key = static_cast<TKey *>(serialKeys->At(i));
+      auto other = static_cast<TKey *>(concurrentKeys->At(i));
+      ASSERT_STREQ(key->GetName(), other->GetName());
+      auto h = dynamic_cast<TH1 *>(key->ReadObj());
+      if (!h)
+         continue;
+      auto otherh = static_cast<TH1 *>(other->ReadObj());
+      EXPECT_EQ(2, h->GetEntries());
+      EXPECT_EQ(h->GetEntries(), otherh->GetEntries());
+      for (Int_t bin = 0; bin <= h->GetNbinsX() + 1; ++bin)
+         EXPECT_EQ(h->GetBinContent(bin), otherh->GetBinContent(bin)) << key->GetName() << " bin " << bin;
+   }
+}
+
+TEST(TFileMerger, ConcurrentKeys)
+{
+   TMemFile a("histos_a.root", "RECREATE");
+   CreateHistos(a, 100, 1.);
+   TMemFile b("histos_b.root", "RECREATE");
+   CreateHistos(b, 100, 2.);
+
+   MergeInto("ConcurrentKeys_serial.root", a, b, 0);
+   ROOT::EnableImplicitMT(4);
+   MergeInto("ConcurrentKeys_mt.root", a, b, 10);
+   ROOT::DisableImplicitMT();
+
+   CompareMergedFiles("ConcurrentKeys_serial.root", "ConcurrentKeys_mt.root");
+
+   gSystem->Unlink("ConcurrentKeys_serial.root");
+   gSystem->Unlink("ConcurrentKeys_mt.root");
+}
+#endif
@@ -1,6 +1,17 @@
+#include "TDirectoryFile.h"
+#include "TEnv.h"
 #include "TFile.h"
+#include "TFileBlockCache.h"
+#include "TKey.h"
+#include "TMemFile.h"
+#include "TObjString.h"
+#include "TROOT.h"
 #include "TSystem.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 // Tests ROOT-9857
@@ -22,4 +33,190 @@ TEST(TFile, ReadFromSameFile)
    auto o2 = f2.Get(objpath);
 
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
-}
\ No newline at end of file
+}
+
+namespace {
+// Gives access to the keys of the top directory in memory, without loading all of them.
+class TFileKeysInMemory : public TFile {
+public:
+   TFileKeysInMemory(const char *name) : TFile(name) {}
+   Int_t GetNkeysInMemory() const { return fKeys->GetSize(); }
+   Int_t GetNbytesKeys() const { return fNbytesKeys; }
+};
+} // namespace
+
+TEST(TDirectoryFile, LazyKeys)
+{
+   const auto filename = "LazyKeys.root";
+   const Int_t n = 1000;
+   {
+      TFile f(filename, "RECREATE");
+      for (Int_t i = 0; i < n; ++i) {
+         TObjString str(TString::Format("%d", i));
+         str.Write(TString::Format("str%d", i));
+      }
+      TObjString again("again");
+      again.Write("str7");
+      auto sub = f.mkdir("sub");
+      sub->cd();
+      TObjString insub("insub");
+      insub.Write("insub");
+   }
+
+   {
+      TFileKeysInMemory f(filename);
+      // Only the trailer of the index of the keys is read, not the keys record
+      EXPECT_EQ(n + 2, f.GetNkeys());
+      EXPECT_EQ(0, f.GetNkeysInMemory());
+      EXPECT_LT(f.GetBytesRead(), f.GetNbytesKeys());
+
+      // A lookup reads a bucket and the entries of the index, the key and the object
+      const Int_t readCalls = f.GetReadCalls();
+      const Long64_t bytesRead = f.GetBytesRead();
+      auto str = f.Get<TObjString>("str42");
+      ASSERT_TRUE(str != nullptr);
+      EXPECT_EQ(TString("42"), str->GetString());
+      EXPECT_EQ(1, f.GetNkeysInMemory());
+      EXPECT_LE(f.GetReadCalls() - readCalls, 6);
+      EXPECT_LT(f.GetBytesRead() - bytesRead, 1000);
+
+      EXPECT_TRUE(f.Get("nosuchkey") == nullptr);
+      EXPECT_EQ(TString("again"), f.Get<TObjString>("str7")->GetString());
+      EXPECT_EQ(TString("7"), f.Get<TObjString>("str7;1")->GetString());
+      auto key = f.GetKey("str7", 1);
+      ASSERT_TRUE(key != nullptr);
+      EXPECT_EQ(1, key->GetCycle());
+      EXPECT_EQ(TString("insub"), f.Get<TObjString>("sub/insub")->GetString());
+      // str42, both cycles of str7 and sub
+      EXPECT_EQ(4, f.GetNkeysInMemory());
+      EXPECT_LT(f.GetBytesRead(), f.GetNbytesKeys());
+
+      // The whole list keeps the order of the file and the keys already looked up
+      auto keys = f.GetListOfKeys();
+      EXPECT_EQ(n + 2, keys->GetSize());
+      EXPECT_EQ(n + 2, f.GetNkeys());
+      EXPECT_EQ(key, f.GetKey("str7", 1));
+      EXPECT_EQ(TString("str0"), keys->First()->GetName());
+      EXPECT_EQ(TString("sub"), keys->Last()->GetName());
+   }
+
+   const Int_t lazy = gEnv->GetValue("TFile.LazyKeys", 1);
+   gEnv->SetValue("TFile.LazyKeys", 0);
+   {
+      TFile f(filename);
+      EXPECT_EQ(n + 2, f.GetListOfKeys()->GetSize());
+      EXPECT_EQ(TString("999"), f.Get<TObjString>("str999")->GetString());
+   }
+   gEnv->SetValue("TFile.LazyKeys", lazy);
+
+   gSystem->Unlink(filename);
+}
+
+#ifdef R__USE_IMT
+namespace {
+// Write a string spanning several compression chunks and return its compressed payload.
+std::string WriteLargeString(const TString &content, Bool_t imt)
+{
+   if (imt)
+      ROOT::EnableImplicitMT(4);
+   TMemFile f("TKeyChunks.root", "RECREATE");
+   TObjString str(content);
+   str.Write("str");
+   if (imt)
+      ROOT::DisableImplicitMT();
+
+   auto key = f.GetKey("str");
+   EXPECT_LT(key->GetNbytes() - key->GetKeylen(), key->GetObjlen());
+   std::string payload(key->GetNbytes() - key->GetKeylen(), '\0');
+   f.ReadBuffer(&payload[0], key->GetSeekKey() + key->GetKeylen(), payload.size());
+
+   if (imt)
+      ROOT::EnableImplicitMT(4);
+   auto read = static_cast<TObjString *>(key->ReadObj());
+   if (imt)
+      ROOT::DisableImplicitMT();
+   EXPECT_EQ(content, read->GetString());
+   delete read;
+   return payload;
+}
+} // namespace
+
+TEST(TFile, ParallelChunkCompression)
+{
+   // kMAXZIPBUF is 16MB, use 3 chunks.
+   TString content;
+   for (Int_t i = 0; content.Length() < 40000000; ++i)
+      content += TString::Format("%d,", i * 7919 % 100003);
+
+   EXPECT_EQ(WriteLargeString(content, kFALSE), WriteLargeString(content, kTRUE));
+}
+#endif
+
+TEST(TFileBlockCache, ReadBuffers)
+{
+   TString dir = TString::Format("%s/TFileBlockCache_%d", gSystem->TempDirectory(), gSystem->GetPid());
+   const auto filename = "TFileBlockCache.root";
+   const Int_t blockSize = 1000;
+   {
+      TFile f(filename, "RECREATE", "", 0);
+      TString content;
+      for (Int_t i = 0; i < 3000; ++i)
+         content += TString::Format("%d,", i);
+      TObjString str(content);
+      f.WriteObject(&str, "content");
+   }
+   {
+      TFile f(filename);
+      const Long64_t end = f.GetEND();
+      ASSERT_GT(end, 10 * blockSize);
+      std::vector<char> expected(end);
+      ASSERT_FALSE(f.ReadBuffer(expected.data(), 0, end));
+      const Long64_t bytesRead = f.GetBytesRead();
+      const Long64_t bytesReadExtra = f.GetBytesReadExtra();
+
+      TFileBlockCache cache(dir, 4 * blockSize, blockSize);
+      ASSERT_TRUE(cache.IsValid());
+
+      // The ranges overlap the blocks 0 to 2, which are read entirely: the
+      // bytes beyond the ranges count as read ahead.
+      Long64_t pos[2] = {100, 2500};
+      Int_t len[2] = {2000, 50};
+      std::vector<char> buf(2050);
+      ASSERT_FALSE(cache.ReadBuffers(&f, buf.data(), pos, len, 2));
+      EXPECT_TRUE(std::equal(buf.begin(), buf.begin() + 2000, expected.begin() + 100));
+      EXPECT_TRUE(std::equal(buf.begin() + 2000, buf.end(), expected.begin() + 2500));
+      EXPECT_EQ(0, cache.GetHits());
+      EXPECT_EQ(3, cache.GetMisses());
+      EXPECT_EQ(bytesRead + 2050, f.GetBytesRead());
+      EXPECT_EQ(bytesReadExtra + 3000 - 2050, f.GetBytesReadExtra());
+
+      // Other ranges of the same blocks are found in the cache and still
+      // count as read from the file.
+      Long64_t pos2 = 1500;
+      Int_t len2 = 1000;
+      ASSERT_FALSE(cache.ReadBuffers(&f, buf.data(), &pos2, &len2, 1));
+      EXPECT_TRUE(std::equal(buf.begin(), buf.begin() + 1000, expected.begin() + 1500));
+      EXPECT_EQ(2, cache.GetHits());
+      EXPECT_EQ(3, cache.GetMisses());
+      EXPECT_EQ(bytesRead + 3050, f.GetBytesRead());
+
+      // The last block is shorter than the others.
+      Long64_t pos3 = end - 10;
+      Int_t len3 = 10;
+      ASSERT_FALSE(cache.ReadBuffers(&f, buf.data(), &pos3, &len3, 1));
+      ASSERT_FALSE(cache.ReadBuffers(&f, buf.data(), &pos3, &len3, 1));
+      EXPECT_TRUE(std::equal(buf.begin(), buf.begin() + 10, expected.end() - 10));
+      EXPECT_EQ(3, cache.GetHits());
+
+      // Reading the whole file evicts the least recently used blocks.
+      std::vector<char> all(end);
+      Long64_t pos4 = 0;
+      Int_t len4 = end;
+      ASSERT_FALSE(cache.ReadBuffers(&f, all.data(), &pos4, &len4, 1));
+      EXPECT_EQ(expected, all);
+      EXPECT_GT(cache.GetBytesEvicted(), 0);
+      EXPECT_LE(cache.Shrink(4 * blockSize), 4 * blockSize);
+   }
+   gSystem->Exec(TString::Format("rm -rf %s", dir.Data()));
+   gSystem->Unlink(filename);
+}
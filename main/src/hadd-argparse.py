@@ -21,6 +21,7 @@ The prefix can be optionally followed by B whose casing is ignored, eg. 1k, 1K,
 	parser.add_argument("-v", help="Explicitly set the verbosity level: 0 request no output, 99 is the default")
 	parser.add_argument("-j", help="Parallelize the execution in multiple processes")
 	parser.add_argument("-dbg", help="Parallelize the execution in multiple processes in debug mode (Does not delete partial files stored inside working directory)")
+	parser.add_argument("-t", help="Merge the objects of each directory concurrently on 'nthreads' threads (0 or none: number of cores)")
 	parser.add_argument("-d", help="Carry out the partial multiprocess execution in the specified directory")
 	parser.add_argument("-n", help="Open at most 'maxopenedfiles' at once (use 0 to request to use the system maximum)")
 	parser.add_argument("-cachesize", help="Resize the prefetching cache use to speed up I/O operations(use 0 to disable)")
@@ -51,6 +51,11 @@
   If the option -cachesize is used, hadd will resize (or disable if 0) the
   prefetching cache use to speed up I/O operations.
 
+  If the option -t is used, the histograms and the graphs of each directory
+  are merged concurrently on the given number of threads (0 or no number: the
+  number of cores); they are still written in the same order as with a single
+  thread. The other objects, including the trees, are merged sequentially.
+
   For options that takes a size as argument, a decimal number of bytes is expected.
   If the number ends with a ``k'', ``m'', ``g'', etc., the number is multiplied
   by 1000 (1K), 1000000 (1MB), 1000000000 (1G), etc.
@@ -81,6 +86,7 @@
 #include "TClass.h"
 #include "TSystem.h"
 #include "TUUID.h"
+#include "TROOT.h"
 #include "ROOT/StringConv.hxx"
 #include <stdlib.h>
 #include <climits>
@@ -110,6 +116,8 @@ int main( int argc, char **argv )
    Bool_t keepCompressionAsIs = kFALSE;
    Bool_t useFirstInputCompression = kFALSE;
    Bool_t multiproc = kFALSE;
+   Bool_t multithread = kFALSE;
+   Int_t nThreads = 0;
    Bool_t debug = kFALSE;
    Int_t maxopenedfiles = 0;
    Int_t verbosity = 99;
@@ -184,6 +192,22 @@ int main( int argc, char **argv )
          }
          multiproc = kTRUE;
          ++ffirst;
+      } else if (strcmp(argv[a], "-t") == 0) {
+         // If the number of threads is not specified, use the default.
+         if (a + 1 != argc && argv[a + 1][0] != '-' &&
+             strspn(argv[a + 1], "0123456789") == strlen(argv[a + 1])) {
+            Long_t request = strtol(argv[a + 1], 0, 10);
+            if (request < kMaxLong && request >= 0) {
+               nThreads = (Int_t)request;
+               ++a;
+               ++ffirst;
+            } else {
+               std::cerr << "Error: could not parse the number of threads passed after -t: " << argv[a + 1]
+                         << ". We will use the default value (number of logical cores).\n";
+            }
+         }
+         multithread = kTRUE;
+         ++ffirst;
       } else if ( strcmp(argv[a],"-cachesize=") == 0 ) {
          int size;
          static const size_t arglen = strlen("-cachesize=");
@@ -485,6 +509,19 @@ int main( int argc, char **argv )
       return mergeFiles(fileMerger);
    };
 
+   // The threads are started after the processes are forked, for the final merge.
+   auto enableThreads = [&]() {
+#ifdef R__USE_IMT
+      if (multithread) {
+         ROOT::EnableImplicitMT(nThreads);
+      }
+#else
+      if (multithread) {
+         std::cerr << "hadd: -t is ignored, ROOT was built without implicit multi-threading support.\n";
+      }
+#endif
+   };
+
    Bool_t status;
 
 #ifndef R__WIN32
@@ -493,6 +530,7 @@ int main( int argc, char **argv )
       auto res = p.Map(parallelMerge, ROOT::TSeqI(ffirst, argc, step));
       status = std::accumulate(res.begin(), res.end(), 0U) == partialFiles.size();
       if (status) {
+         enableThreads();
          status = reductionFunc();
       } else {
          std::cout << "hadd failed at the parallel stage" << std::endl;
@@ -503,9 +541,11 @@ int main( int argc, char **argv )
          }
       }
    } else {
+      enableThreads();
       status = sequentialMerge(fileMerger, ffirst, filesToProcess);
    }
 #else
+   enableThreads();
    status = sequentialMerge(fileMerger, ffirst, filesToProcess);
 #endif
 
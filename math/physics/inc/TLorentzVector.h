@@ -22,6 +22,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "TMath.h"
+#include "TObjectPool.h"
 #include "TVector3.h"
 #include "TRotation.h"
 
@@ -259,6 +260,7 @@ public:
    virtual void        Print(Option_t *option="") const;
 
    ClassDef(TLorentzVector,4) // A four vector with (-,-,-,+) metric
+   R__USE_OBJECT_POOL
 };
 
 
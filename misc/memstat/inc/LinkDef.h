@@ -18,6 +18,7 @@
 
 #pragma link C++ class TMemStat;
 #pragma link C++ class Memstat::TMemStatMng;
+#pragma link C++ class TMemProfiler;
 
 
 //#pragma link C++ function Memstat::dig2bytes(Long64_t);
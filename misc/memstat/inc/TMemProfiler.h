@@ -0,0 +1,83 @@
+// @(#)root/memstat:$Id$
+
+/*************************************************************************
+* Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+* All rights reserved.                                                  *
+*                                                                       *
+* For the licensing terms see $ROOTSYS/LICENSE.                         *
+* For the list of contributors see $ROOTSYS/README/CREDITS.             *
+*************************************************************************/
+#ifndef ROOT_TMemProfiler
+#define ROOT_TMemProfiler
+
+#include "TObject.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class TString;
+
+class TMemProfiler: public TObject {
+public:
+   struct Site_t {
+      std::vector<void*> fFrames;   // return addresses, innermost first
+      Long64_t fLive = 0;           // estimated bytes currently allocated
+      Long64_t fPeak = 0;           // maximum of fLive
+      Long64_t fTotal = 0;          // estimated bytes allocated since the start
+      Long64_t fSamples = 0;        // number of sampled allocations
+   };
+
+private:
+   struct Sample_t {
+      Int_t    fSite;               // index in fSites
+      Long64_t fWeight;             // estimated bytes represented by the sample
+   };
+
+   Long64_t fInterval;              // mean number of bytes between two samples
+   Int_t    fDepth;                 // maximum number of frames recorded per sample
+   Long64_t fLive;                  // estimated bytes currently allocated
+   Long64_t fPeak;                  // maximum of fLive
+   Long64_t fSamples;               // number of sampled allocations
+   std::vector<Site_t> fSites;      //! allocation sites seen so far
+   std::unordered_map<ULong64_t, Int_t> fSiteIndex;  //! hash of the frames -> index in fSites
+   std::unordered_map<void*, Sample_t> fSampled;     //! sampled blocks not freed yet
+   mutable std::mutex fMutex;       //! protects the members above
+
+   static std::atomic<TMemProfiler*> fgInstance; // the profiler, when started
+
+   TMemProfiler(Long64_t interval, Int_t depth);
+   TMemProfiler(const TMemProfiler&) = delete;
+   TMemProfiler& operator=(const TMemProfiler&) = delete;
+
+   void AddSample(void *ptr, Long64_t weight);
+   void RemoveSample(void *ptr);
+
+   // The hooks, called for every allocation and deallocation
+   static void  MacAllocHook(void *ptr, size_t size);
+   static void  MacFreeHook(void *ptr);
+   static void  OnAlloc(void *ptr, size_t size);
+   static void  OnFree(void *ptr);
+
+public:
+   virtual ~TMemProfiler();
+
+   static Bool_t        Start(Long64_t interval = 512 * 1024, Int_t depth = 16);
+   static void          Stop();
+   static void          Close(const char *filename = 0);
+   static TMemProfiler *GetInstance() { return fgInstance; }
+   static const char   *GetSubsystem(const Site_t &site, TString *function = 0);
+
+   Long64_t GetSamplingInterval() const { return fInterval; }
+   Long64_t GetLiveBytes() const;
+   Long64_t GetPeakBytes() const;
+   Long64_t GetNSamples() const;
+   std::vector<Site_t> GetSites() const;
+   virtual void Print(Option_t *option = "") const;
+   Int_t    WriteProfile(const char *filename) const;
+
+   ClassDef(TMemProfiler, 0) // Sampling heap profiler
+};
+
+#endif
@@ -0,0 +1,115 @@
+// @(#)root/memstat:$Id$
+
+/*************************************************************************
+* Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+* All rights reserved.                                                  *
+*                                                                       *
+* For the licensing terms see $ROOTSYS/LICENSE.                         *
+* For the list of contributors see $ROOTSYS/README/CREDITS.             *
+*************************************************************************/
+
+//___________________________________________________________________________
+//
+// libMemProfiler replaces malloc, calloc, realloc and free with functions
+// forwarding to the ones of glibc (__libc_malloc, ...) and reporting the
+// allocations and deallocations to TMemProfiler while it runs (see
+// R__MemProfilerSetCallbacks). Nothing is ever uninstalled, so that all the
+// threads are seen at all times.
+//
+// It must come before the C library in the symbol lookup order: preload it
+//   LD_PRELOAD=$ROOTSYS/lib/libMemProfiler.so root.exe ...
+// or link it to the executable. It depends on no other ROOT library.
+//___________________________________________________________________________
+
+#include "MemProfilerMalloc.h"
+
+#include <atomic>
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void  __libc_free(void *ptr);
+}
+
+namespace {
+
+std::atomic<R__MemProfilerAllocCallback_t> gAllocCallback(nullptr);
+std::atomic<R__MemProfilerFreeCallback_t> gFreeCallback(nullptr);
+
+// Set while this thread runs a callback: the allocations of the profiler
+// itself are not reported. Static TLS, whose access never allocates.
+thread_local bool gInCallback __attribute__((tls_model("initial-exec"))) = false;
+
+struct TCallbackGuard {
+   TCallbackGuard() { gInCallback = true; }
+   ~TCallbackGuard() { gInCallback = false; }
+};
+
+inline void ReportAlloc(void *ptr, size_t size)
+{
+   if (!ptr || gInCallback)
+      return;
+   if (R__MemProfilerAllocCallback_t callback = gAllocCallback.load(std::memory_order_acquire)) {
+      TCallbackGuard guard;
+      callback(ptr, size);
+   }
+}
+
+inline void ReportFree(void *ptr)
+{
+   if (!ptr || gInCallback)
+      return;
+   if (R__MemProfilerFreeCallback_t callback = gFreeCallback.load(std::memory_order_acquire)) {
+      TCallbackGuard guard;
+      callback(ptr);
+   }
+}
+
+} // namespace
+
+extern "C" {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Install the callbacks of the profiler, or remove them if null.
+
+void R__MemProfilerSetCallbacks(R__MemProfilerAllocCallback_t alloc, R__MemProfilerFreeCallback_t free)
+{
+   gAllocCallback.store(alloc, std::memory_order_release);
+   gFreeCallback.store(free, std::memory_order_release);
+}
+
+void *malloc(size_t size)
+{
+   void *ptr = __libc_malloc(size);
+   ReportAlloc(ptr, size);
+   return ptr;
+}
+
+void *calloc(size_t n, size_t size)
+{
+   void *ptr = __libc_calloc(n, size);
+   ReportAlloc(ptr, n * size);
+   return ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The deallocation is reported first, as the block may be reused right away
+/// by another thread. If the reallocation fails, the old block, still
+/// allocated, is then no longer accounted for.
+
+void *realloc(void *ptr, size_t size)
+{
+   ReportFree(ptr);
+   void *result = __libc_realloc(ptr, size);
+   ReportAlloc(result, size);
+   return result;
+}
+
+void free(void *ptr)
+{
+   ReportFree(ptr);
+   __libc_free(ptr);
+}
+
+}
@@ -0,0 +1,32 @@
+// @(#)root/memstat:$Id$
+
+/*************************************************************************
+* Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+* All rights reserved.                                                  *
+*                                                                       *
+* For the licensing terms see $ROOTSYS/LICENSE.                         *
+* For the list of contributors see $ROOTSYS/README/CREDITS.             *
+*************************************************************************/
+#ifndef ROOT_MemProfilerMalloc
+#define ROOT_MemProfilerMalloc
+
+// Interface between TMemProfiler (libMemStat) and libMemProfiler, which
+// replaces malloc, calloc, realloc and free (see MemProfilerMalloc.cxx).
+
+#include <cstddef>
+
+extern "C" {
+
+// Called after each successful allocation of size bytes at ptr.
+typedef void (*R__MemProfilerAllocCallback_t)(void *ptr, size_t size);
+// Called before each deallocation of ptr.
+typedef void (*R__MemProfilerFreeCallback_t)(void *ptr);
+
+typedef void (*R__MemProfilerSetCallbacks_t)(R__MemProfilerAllocCallback_t, R__MemProfilerFreeCallback_t);
+
+// Install the callbacks, or remove them if null.
+void R__MemProfilerSetCallbacks(R__MemProfilerAllocCallback_t alloc, R__MemProfilerFreeCallback_t free);
+
+}
+
+#endif
@@ -0,0 +1,627 @@
+// @(#)root/memstat:$Id$
+
+/*************************************************************************
+* Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+* All rights reserved.                                                  *
+*                                                                       *
+* For the licensing terms see $ROOTSYS/LICENSE.                         *
+* For the list of contributors see $ROOTSYS/README/CREDITS.             *
+*************************************************************************/
+
+//___________________________________________________________________________
+//
+// TMemProfiler is a sampling heap profiler. Unlike TMemStat, which records
+// every malloc and free with its backtrace, it records on average one
+// allocation every GetSamplingInterval() bytes (512 kB by default): the
+// hooks only decrement a per thread byte counter for the other allocations,
+// and only check a small table of counters for the deallocations, so the
+// job runs at almost full speed.
+//
+// The distance between two samples is drawn from an exponential
+// distribution, and each sample accounts for the number of bytes it
+// statistically represents, so that the live and peak memory aggregated
+// per allocation site (the backtrace of the allocation) are unbiased
+// estimates.
+//
+// Each site is attributed to a ROOT subsystem (Baskets, Trees, Histograms,
+// TClass, Interpreter, Files, ...) from the innermost function of its
+// backtrace belonging to a known class, skipping the generic ones like
+// TBuffer, TString, the collections or the standard library.
+//
+// Simply do:
+//   root > TMemProfiler::Start();
+//   ...
+//   root > TMemProfiler::GetInstance()->Print();
+//   root > TMemProfiler::Close("memprofile.root");
+// or set Root.MemProfile to yes in .rootrc (see system.rootrc). The output
+// file contains:
+//   - the tree "sites", with one entry per allocation site: the estimated
+//     live, peak and total bytes, the number of samples, the subsystem,
+//     the attributed function and the symbolized backtrace;
+//   - the histograms "live" and "peak" of the memory per subsystem;
+//   - "info", with the sampling interval and the totals.
+//
+// On Linux the allocations are seen through libMemProfiler, which replaces
+// malloc, calloc, realloc and free for the whole process and must thus be
+// preloaded (LD_PRELOAD=$ROOTSYS/lib/libMemProfiler.so) or linked to the
+// executable: Start() fails otherwise. It reports all the allocations and
+// deallocations of all the threads to the profiler while it runs. On Mac OS
+// X the memory zone hooks of TMemStat are used (see TMemStatHook).
+//
+// The profiler is never deleted, as the hooks of other threads may still be
+// using it: Close() only releases the profile it collected.
+//___________________________________________________________________________
+
+#include "TMemProfiler.h"
+#include "TMemStatBacktrace.h"
+#include "TMemStatHook.h"
+#include "MemProfilerMalloc.h"
+
+#include "TDirectory.h"
+#include "TEnv.h"
+#include "TError.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TROOT.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include <ROOT/RConfig.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+#include <exception>
+#include <map>
+#include <memory>
+#include <string>
+
+#if defined(R__GNU) && (defined(R__LINUX) || defined(__APPLE__))
+#define SUPPORTS_MEMPROFILER
+#endif
+
+#if defined(__GNUC__) && !defined(__APPLE__)
+// Static TLS: the first access to a dynamic TLS block of a dlopen-ed library
+// may call malloc, i.e. the hooks.
+#define R__MEMPROFILER_TLS __attribute__((tls_model("initial-exec")))
+#else
+#define R__MEMPROFILER_TLS
+#endif
+
+ClassImp(TMemProfiler);
+
+std::atomic<TMemProfiler*> TMemProfiler::fgInstance(nullptr);
+
+namespace {
+
+struct ThreadState_t {
+   Long64_t  fBytesLeft;   // bytes to allocate before the next sample
+   ULong64_t fRandom;      // state of the random generator, 0 until the first allocation
+   Bool_t    fInHook;      // the profiler is allocating or freeing for itself
+};
+
+// Zero-initialized, so that no constructor has to run on first access.
+thread_local ThreadState_t gThreadState R__MEMPROFILER_TLS;
+
+// Mean distance between two samples, 0 when the profiler is stopped.
+std::atomic<Long64_t> gInterval(0);
+
+// Number of sampled blocks not freed yet, per hash of their address: most
+// of the deallocations are rejected by looking at a single counter.
+const Int_t kFilterBits = 16;
+std::atomic<UShort_t> gSampledFilter[1 << kFilterBits];
+
+const Int_t kMaxDepth = 64;
+
+// R__MemProfilerSetCallbacks of libMemProfiler, once found by Start().
+R__MemProfilerSetCallbacks_t gSetCallbacks = 0;
+
+// Base addresses of the libraries whose frames are dropped from the top of
+// the backtraces: this one, the C and the C++ runtime.
+void *gSkippedLibs[3] = {0, 0, 0};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keep the allocations and deallocations done by the profiler out of the
+/// profile, e.g. while holding its mutex.
+
+struct TInHookGuard {
+   Bool_t fPrevious;
+   TInHookGuard() : fPrevious(gThreadState.fInHook) { gThreadState.fInHook = kTRUE; }
+   ~TInHookGuard() { gThreadState.fInHook = fPrevious; }
+};
+
+inline UInt_t FilterSlot(const void *ptr)
+{
+   return (UInt_t)((((ULong64_t)ptr >> 4) * 0x9E3779B97F4A7C15ULL) >> (64 - kFilterBits));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of bytes to allocate before the next sample, exponentially
+/// distributed with the given mean.
+
+Long64_t DrawInterval(ThreadState_t &state, Long64_t mean)
+{
+   if (!state.fRandom)
+      state.fRandom = (ULong64_t)&state ^ 0x2545F4914F6CDD1DULL;
+   // xorshift64*
+   ULong64_t &x = state.fRandom;
+   x ^= x >> 12;
+   x ^= x << 25;
+   x ^= x >> 27;
+   const Double_t u = ((x * 0x2545F4914F6CDD1DULL) >> 11) * (1. / 9007199254740992.);
+   return (Long64_t)(-std::log(1. - u) * mean) + 1;
+}
+
+struct Rule_t {
+   const char *fPrefix;
+   const char *fSubsystem;
+};
+
+// Functions attributed to a subsystem, by prefix of their demangled name.
+const Rule_t kRules[] = {
+   {"TBasket", "Baskets"},       {"TTree", "Trees"},           {"TBranch", "Trees"},
+   {"TLeaf", "Trees"},           {"TChain", "Trees"},          {"TEntryList", "Trees"},
+   {"ROOT::RDF", "RDataFrame"},  {"ROOT::Detail::RDF", "RDataFrame"}, {"ROOT::Internal::RDF", "RDataFrame"},
+   {"TH1", "Histograms"},        {"TH2", "Histograms"},        {"TH3", "Histograms"},
+   {"THn", "Histograms"},        {"TProfile", "Histograms"},   {"TAxis", "Histograms"},
+   {"TGraph", "Graphs"},         {"TClass", "TClass"},         {"TStreamerInfo", "TClass"},
+   {"TStreamerElement", "TClass"}, {"TProtoClass", "TClass"},  {"TDataMember", "TClass"},
+   {"TBaseClass", "TClass"},     {"TListOf", "TClass"},        {"TFunction", "TClass"},
+   {"TMethod", "TClass"},        {"TCling", "Interpreter"},    {"cling::", "Interpreter"},
+   {"clang::", "Interpreter"},   {"llvm::", "Interpreter"},    {"TFile", "Files"},
+   {"TKey", "Files"},            {"TDirectoryFile", "Files"},  {"R__zip", "Compression"},
+   {"R__unzip", "Compression"},  {"TROOT", "Core"},            {"TSystem", "Core"},
+   {"TUnixSystem", "Core"},      {"TEnv", "Core"},
+};
+
+// Generic functions, attributed to their callers.
+const char *const kGeneric[] = {
+   "TStorage", "TBuffer", "TString", "TObject::operator new", "TObjArray::", "TClonesArray::", "TList::",
+   "THashList::", "THashTable::", "TCollection::", "TArray", "TRefArray::", "std::", "__gnu_cxx::",
+   "operator new", "TMemProfiler",
+};
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor, see Start().
+
+TMemProfiler::TMemProfiler(Long64_t interval, Int_t depth)
+   : fInterval(interval), fDepth(std::max(1, std::min(depth, kMaxDepth))), fLive(0), fPeak(0), fSamples(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+TMemProfiler::~TMemProfiler()
+{
+   TMemProfiler *self = this;
+   if (fgInstance.compare_exchange_strong(self, nullptr)) {
+      Stop();
+      for (auto &slot : gSampledFilter)
+         slot = 0;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start profiling the heap: on average one allocation is sampled every
+/// interval bytes, and its backtrace recorded up to depth frames. An
+/// interval of 1 samples every allocation. Return false if the profiler
+/// is already running, or not supported on this platform, or if on Linux
+/// libMemProfiler is not preloaded (see the class description).
+
+Bool_t TMemProfiler::Start(Long64_t interval, Int_t depth)
+{
+#if defined(SUPPORTS_MEMPROFILER)
+   if (fgInstance) {
+      ::Warning("TMemProfiler::Start", "the memory profiler is already started");
+      return kFALSE;
+   }
+#if !defined(__APPLE__)
+   if (!gSetCallbacks) {
+      // libMemProfiler must provide the malloc used by the whole process.
+      Dl_info callbacksInfo, mallocInfo;
+      void *setCallbacks = dlsym(RTLD_DEFAULT, "R__MemProfilerSetCallbacks");
+      if (!setCallbacks || !dladdr(setCallbacks, &callbacksInfo) ||
+          !dladdr(dlsym(RTLD_DEFAULT, "malloc"), &mallocInfo) || callbacksInfo.dli_fbase != mallocInfo.dli_fbase) {
+         ::Error("TMemProfiler::Start", "libMemProfiler must be preloaded: LD_PRELOAD=%s/libMemProfiler.so",
+                 TROOT::GetLibDir().Data());
+         return kFALSE;
+      }
+      gSetCallbacks = (R__MemProfilerSetCallbacks_t)setCallbacks;
+   }
+#endif
+   TMemProfiler *profiler = new TMemProfiler(std::max(interval, 1LL), depth);
+
+   // The first backtrace loads the unwinder, which allocates.
+   void *frames[kMaxDepth];
+   Memstat::getBacktrace(frames, kMaxDepth, kFALSE);
+
+   Dl_info info;
+   if (dladdr((void *)&TMemProfiler::OnAlloc, &info))
+      gSkippedLibs[0] = info.dli_fbase;
+   if (dladdr((void *)&malloc, &info))
+      gSkippedLibs[1] = info.dli_fbase;
+   if (dladdr((void *)(void (*)())&std::terminate, &info))
+      gSkippedLibs[2] = info.dli_fbase;
+
+   fgInstance = profiler;
+   gInterval = profiler->fInterval;
+#if defined(__APPLE__)
+   TMemStatHook::trackZoneMalloc(MacAllocHook, MacFreeHook);
+#else
+   gSetCallbacks(OnAlloc, OnFree);
+#endif
+   return kTRUE;
+#else
+   if (interval || depth) {}
+   ::Error("TMemProfiler::Start", "the memory profiler is not supported on this platform");
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop sampling. The profile collected so far stays available from
+/// GetInstance() until Close() is called.
+
+void TMemProfiler::Stop()
+{
+   if (!gInterval)
+      return;
+   gInterval = 0;
+#if defined(SUPPORTS_MEMPROFILER)
+#if defined(__APPLE__)
+   TMemStatHook::untrackZoneMalloc();
+#else
+   gSetCallbacks(nullptr, nullptr);
+#endif
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop the profiler, write its profile to filename and release it. If
+/// filename is null, Root.MemProfile.File is used, and memprofile_<pid>.root
+/// if it is not set. The profiler itself is not deleted, since other threads
+/// may still be running its hooks; only its profile is.
+
+void TMemProfiler::Close(const char *filename)
+{
+   TMemProfiler *profiler = fgInstance;
+   if (!profiler)
+      return;
+   Stop();
+   TString name = filename ? filename : gEnv->GetValue("Root.MemProfile.File", "");
+   if (name.IsNull())
+      name.Form("memprofile_%d.root", gSystem->GetPid());
+   if (profiler->WriteProfile(name) >= 0)
+      ::Info("TMemProfiler::Close", "memory profile written to %s", name.Data());
+
+   if (!fgInstance.compare_exchange_strong(profiler, nullptr))
+      return;
+   TInHookGuard guard;
+   std::lock_guard<std::mutex> lock(profiler->fMutex);
+   std::vector<Site_t>().swap(profiler->fSites);
+   std::unordered_map<ULong64_t, Int_t>().swap(profiler->fSiteIndex);
+   std::unordered_map<void*, Sample_t>().swap(profiler->fSampled);
+   profiler->fLive = profiler->fPeak = profiler->fSamples = 0;
+   for (auto &slot : gSampledFilter)
+      slot = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called after each successful allocation, by any thread: count its bytes
+/// and sample it when the distance to the next sample is reached.
+
+void TMemProfiler::OnAlloc(void *ptr, size_t size)
+{
+   if (!ptr || !size)
+      return;
+   const Long64_t interval = gInterval.load(std::memory_order_relaxed);
+   ThreadState_t &state = gThreadState;
+   if (!interval || state.fInHook)
+      return;
+   if (!state.fRandom)
+      state.fBytesLeft = DrawInterval(state, interval);
+   state.fBytesLeft -= size;
+   if (state.fBytesLeft > 0)
+      return;
+   state.fBytesLeft = DrawInterval(state, interval);
+
+   // An allocation of size bytes is sampled with probability
+   // 1 - exp(-size / interval): weight it by the inverse.
+   Long64_t weight = size;
+   if (interval > 1)
+      weight = (Long64_t)(size / (1. - std::exp(-(Double_t)size / interval)));
+
+   TInHookGuard guard;
+   if (TMemProfiler *profiler = fgInstance)
+      profiler->AddSample(ptr, weight);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called before each deallocation.
+
+void TMemProfiler::OnFree(void *ptr)
+{
+   if (!ptr || !gSampledFilter[FilterSlot(ptr)].load(std::memory_order_relaxed))
+      return;
+   if (gThreadState.fInHook)
+      return;
+   TInHookGuard guard;
+   if (TMemProfiler *profiler = fgInstance)
+      profiler->RemoveSample(ptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the backtrace of a sampled allocation and account for it in its
+/// site.
+
+void TMemProfiler::AddSample(void *ptr, Long64_t weight)
+{
+   void *frames[kMaxDepth];
+   Int_t nframes = Memstat::getBacktrace(frames, kMaxDepth, kFALSE);
+   // Drop the frames of the profiler and of the allocator
+   Int_t first = 0;
+   for (; first < nframes - 1; ++first) {
+      Dl_info info;
+      if (!dladdr(frames[first], &info) || std::find(gSkippedLibs, gSkippedLibs + 3, info.dli_fbase) == gSkippedLibs + 3)
+         break;
+   }
+   nframes = std::min(nframes - first, fDepth);
+
+   // FNV-1a of the return addresses
+   ULong64_t hash = 14695981039346656037ULL;
+   for (Int_t i = 0; i < nframes; ++i)
+      hash = (hash ^ (ULong64_t)frames[first + i]) * 1099511628211ULL;
+
+   std::lock_guard<std::mutex> lock(fMutex);
+   Int_t index;
+   auto found = fSiteIndex.find(hash);
+   if (found == fSiteIndex.end()) {
+      index = fSites.size();
+      fSiteIndex[hash] = index;
+      fSites.emplace_back();
+      fSites.back().fFrames.assign(frames + first, frames + first + nframes);
+   } else {
+      index = found->second;
+   }
+   Site_t &site = fSites[index];
+   site.fLive += weight;
+   site.fTotal += weight;
+   site.fPeak = std::max(site.fPeak, site.fLive);
+   ++site.fSamples;
+   fLive += weight;
+   fPeak = std::max(fPeak, fLive);
+   ++fSamples;
+
+   Sample_t &sample = fSampled[ptr];
+   if (sample.fWeight) {
+      // The block was freed behind our back, e.g. by an aligned allocation
+      // path which is not hooked: forget the old sample.
+      fSites[sample.fSite].fLive -= sample.fWeight;
+      fLive -= sample.fWeight;
+   } else {
+      ++gSampledFilter[FilterSlot(ptr)];
+   }
+   sample.fSite = index;
+   sample.fWeight = weight;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Account for the deallocation of ptr if it was sampled.
+
+void TMemProfiler::RemoveSample(void *ptr)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   auto found = fSampled.find(ptr);
+   if (found == fSampled.end())
+      return;
+   fSites[found->second.fSite].fLive -= found->second.fWeight;
+   fLive -= found->second.fWeight;
+   fSampled.erase(found);
+   --gSampledFilter[FilterSlot(ptr)];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Memory zone hook called after each allocation on Mac OS X.
+
+void TMemProfiler::MacAllocHook(void *ptr, size_t size)
+{
+   OnAlloc(ptr, size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Memory zone hook called on each deallocation on Mac OS X.
+
+void TMemProfiler::MacFreeHook(void *ptr)
+{
+   OnFree(ptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the subsystem to which the memory allocated at site is attributed,
+/// and in function, if not null, the function it was attributed from.
+
+const char *TMemProfiler::GetSubsystem(const Site_t &site, TString *function)
+{
+   TString info, lib, symbol;
+   for (void *frame : site.fFrames) {
+      symbol.Clear();
+      if (Memstat::getSymbols(frame, info, lib, symbol) || symbol.IsNull())
+         continue;
+      Bool_t generic = kFALSE;
+      for (const char *prefix : kGeneric) {
+         if (symbol.BeginsWith(prefix)) {
+            generic = kTRUE;
+            break;
+         }
+      }
+      if (generic)
+         continue;
+      for (const Rule_t &rule : kRules) {
+         if (symbol.BeginsWith(rule.fPrefix)) {
+            if (function)
+               *function = symbol;
+            return rule.fSubsystem;
+         }
+      }
+      // The first non generic function not belonging to a known subsystem,
+      // e.g. user code.
+      if (function && function->IsNull())
+         *function = symbol;
+   }
+   return "Other";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Estimated number of bytes currently allocated.
+
+Long64_t TMemProfiler::GetLiveBytes() const
+{
+   TInHookGuard guard;
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fLive;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Estimated maximum number of bytes allocated at the same time since the
+/// start of the profiler, not counting the memory allocated before.
+
+Long64_t TMemProfiler::GetPeakBytes() const
+{
+   TInHookGuard guard;
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fPeak;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of sampled allocations.
+
+Long64_t TMemProfiler::GetNSamples() const
+{
+   TInHookGuard guard;
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fSamples;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a copy of the allocation sites recorded so far.
+
+std::vector<TMemProfiler::Site_t> TMemProfiler::GetSites() const
+{
+   TInHookGuard guard;
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fSites;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the memory per subsystem and the top 20 allocation sites by live
+/// memory, or by peak memory if option contains "peak".
+
+void TMemProfiler::Print(Option_t *option) const
+{
+   const Bool_t byPeak = TString(option).Contains("peak", TString::kIgnoreCase);
+   auto sites = GetSites();
+   std::sort(sites.begin(), sites.end(), [byPeak](const Site_t &a, const Site_t &b) {
+      return byPeak ? a.fPeak > b.fPeak : a.fLive > b.fLive;
+   });
+
+   printf("Sampling interval: %lld bytes, %lld samples, live: %.3f MB, peak: %.3f MB\n", fInterval, GetNSamples(),
+          GetLiveBytes() / 1e6, GetPeakBytes() / 1e6);
+
+   std::map<std::string, std::pair<Long64_t, Long64_t>> subsystems;
+   std::vector<std::pair<const char *, TString>> attributions;
+   for (const auto &site : sites) {
+      TString function;
+      const char *subsystem = GetSubsystem(site, &function);
+      subsystems[subsystem].first += site.fLive;
+      subsystems[subsystem].second += site.fPeak;
+      attributions.emplace_back(subsystem, function);
+   }
+   printf("%-14s %12s %12s\n", "Subsystem", "Live [MB]", "Peak [MB]");
+   for (const auto &subsystem : subsystems)
+      printf("%-14s %12.3f %12.3f\n", subsystem.first.c_str(), subsystem.second.first / 1e6,
+             subsystem.second.second / 1e6);
+
+   printf("%4s %12s %12s %9s %-14s %s\n", "Rank", "Live [MB]", "Peak [MB]", "Samples", "Subsystem", "Function");
+   for (size_t i = 0; i < sites.size() && i < 20; ++i)
+      printf("%4zu %12.3f %12.3f %9lld %-14s %s\n", i + 1, sites[i].fLive / 1e6, sites[i].fPeak / 1e6,
+             sites[i].fSamples, attributions[i].first, attributions[i].second.Data());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the profile to the ROOT file filename (see the class description).
+/// Return the number of allocation sites written, or -1 on error.
+
+Int_t TMemProfiler::WriteProfile(const char *filename) const
+{
+   auto sites = GetSites();
+
+   TDirectory::TContext context;
+   std::unique_ptr<TFile> file(TFile::Open(filename, "RECREATE"));
+   if (!file || file->IsZombie()) {
+      Error("WriteProfile", "cannot create %s", filename);
+      return -1;
+   }
+
+   Long64_t live, peak, total, samples;
+   std::string subsystem, function, stack;
+   TTree *tree = new TTree("sites", "Sampled allocation sites");
+   tree->Branch("live", &live, "live/L");
+   tree->Branch("peak", &peak, "peak/L");
+   tree->Branch("total", &total, "total/L");
+   tree->Branch("samples", &samples, "samples/L");
+   tree->Branch("subsystem", &subsystem);
+   tree->Branch("function", &function);
+   tree->Branch("stack", &stack);
+
+   std::map<std::string, std::pair<Long64_t, Long64_t>> subsystems;
+   for (const auto &site : sites) {
+      live = site.fLive;
+      peak = site.fPeak;
+      total = site.fTotal;
+      samples = site.fSamples;
+      TString func;
+      subsystem = GetSubsystem(site, &func);
+      function = func.Data();
+      stack.clear();
+      for (void *frame : site.fFrames) {
+         TString info, lib, symbol;
+         Memstat::getSymbols(frame, info, lib, symbol);
+         if (symbol.IsNull())
+            symbol.Form("%p", frame);
+         stack += Form("%s (%s)\n", symbol.Data(), gSystem->BaseName(lib));
+      }
+      tree->Fill();
+      subsystems[subsystem].first += live;
+      subsystems[subsystem].second += peak;
+   }
+   tree->Write();
+
+   const Int_t n = subsystems.size();
+   TH1D hLive("live", "Estimated live memory per subsystem;;bytes", n, 0, n);
+   TH1D hPeak("peak", "Sum of the peak memory of the allocation sites per subsystem;;bytes", n, 0, n);
+   hLive.SetDirectory(0);
+   hPeak.SetDirectory(0);
+   Int_t bin = 1;
+   for (const auto &entry : subsystems) {
+      hLive.GetXaxis()->SetBinLabel(bin, entry.first.c_str());
+      hPeak.GetXaxis()->SetBinLabel(bin, entry.first.c_str());
+      hLive.SetBinContent(bin, entry.second.first);
+      hPeak.SetBinContent(bin, entry.second.second);
+      ++bin;
+   }
+   file->WriteTObject(&hLive);
+   file->WriteTObject(&hPeak);
+
+   TNamed info("info", Form("interval=%lld samples=%lld live=%lld peak=%lld", fInterval, GetNSamples(),
+                            GetLiveBytes(), GetPeakBytes()));
+   file->WriteTObject(&info);
+   return sites.size();
+}
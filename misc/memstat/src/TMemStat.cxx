@@ -13,6 +13,8 @@
 // TMemStat records all the calls to malloc and free and write a TTree
 // with the position where the memory is allocated/freed , as well as
 // the number of bytes.
+// This slows the job down considerably: to profile production jobs, use
+// the sampling profiler TMemProfiler instead.
 //
 // To use the class TMemStat, add the following statement at the beginning
 // of your script or program
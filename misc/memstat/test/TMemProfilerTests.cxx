@@ -0,0 +1,138 @@
+#include "TMemProfiler.h"
+
+#include "TFile.h"
+#include "TH1.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+// Called through volatile pointers so that the allocations cannot be elided
+void *(*volatile gMalloc)(size_t) = malloc;
+void (*volatile gFree)(void *) = free;
+} // namespace
+
+TEST(TMemProfiler, SampleAll)
+{
+   const Int_t n = 100;
+   const Long64_t size = 1000;
+   const auto filename = "TMemProfilerSampleAll.root";
+   std::vector<void *> blocks(2 * n);
+
+   // Sample every allocation, each one then weighs its size
+   ASSERT_TRUE(TMemProfiler::Start(1, 8));
+   TMemProfiler *profiler = TMemProfiler::GetInstance();
+   ASSERT_TRUE(profiler != nullptr);
+   EXPECT_EQ(1, profiler->GetSamplingInterval());
+   const Long64_t samples = profiler->GetNSamples();
+   const Long64_t live = profiler->GetLiveBytes();
+
+   std::thread worker([&blocks]() {
+      for (Int_t i = 0; i < n; ++i)
+         blocks[i] = gMalloc(size);
+   });
+   worker.join();
+   for (Int_t i = n; i < 2 * n; ++i)
+      blocks[i] = gMalloc(size);
+
+   const Long64_t allocated = profiler->GetLiveBytes();
+   EXPECT_LE(samples + 2 * n, profiler->GetNSamples());
+   EXPECT_LE(live + 2 * n * size, allocated);
+   EXPECT_LE(allocated, profiler->GetPeakBytes());
+
+   // Including the blocks of the worker, freed by another thread
+   for (auto block : blocks)
+      gFree(block);
+   EXPECT_LE(profiler->GetLiveBytes(), allocated - 2 * n * size);
+   EXPECT_LE(allocated, profiler->GetPeakBytes());
+
+   TMemProfiler::Close(filename);
+   EXPECT_TRUE(TMemProfiler::GetInstance() == nullptr);
+
+   std::unique_ptr<TFile> file(TFile::Open(filename));
+   ASSERT_TRUE(file && !file->IsZombie());
+   auto sites = file->Get<TTree>("sites");
+   ASSERT_TRUE(sites != nullptr);
+   EXPECT_LT(0, sites->GetEntries());
+   Long64_t total = 0, sum = 0;
+   sites->SetBranchAddress("total", &total);
+   for (Long64_t entry = 0; entry < sites->GetEntries(); ++entry) {
+      sites->GetEntry(entry);
+      sum += total;
+   }
+   EXPECT_LE(2 * n * size, sum);
+   EXPECT_TRUE(file->Get<TH1>("live") != nullptr);
+   EXPECT_TRUE(file->Get<TH1>("peak") != nullptr);
+   file.reset();
+   gSystem->Unlink(filename);
+
+   // The profiler can be started again
+   ASSERT_TRUE(TMemProfiler::Start(1, 8));
+   EXPECT_TRUE(TMemProfiler::GetInstance() != nullptr);
+   TMemProfiler::Close(filename);
+   gSystem->Unlink(filename);
+}
+
+TEST(TMemProfiler, ConcurrentAllocFree)
+{
+   const Int_t nThreads = 4;
+   const Int_t n = 1000;
+   const Long64_t size = 100;
+   std::vector<std::vector<void *>> blocks(nThreads, std::vector<void *>(n));
+
+   ASSERT_TRUE(TMemProfiler::Start(1, 4));
+   TMemProfiler *profiler = TMemProfiler::GetInstance();
+   ASSERT_TRUE(profiler != nullptr);
+   const Long64_t samples = profiler->GetNSamples();
+   const Long64_t live = profiler->GetLiveBytes();
+
+   // Run the threads at the same time, each one freeing the blocks of the
+   // next one: none of the allocations and deallocations may be missed.
+   auto runThreads = [&](std::function<void(Int_t)> work) {
+      std::atomic<Int_t> ready(0);
+      std::vector<std::thread> threads;
+      for (Int_t t = 0; t < nThreads; ++t) {
+         threads.emplace_back([&, t]() {
+            ++ready;
+            while (ready < nThreads) {
+            }
+            work(t);
+         });
+      }
+      for (auto &thread : threads)
+         thread.join();
+   };
+   runThreads([&](Int_t t) {
+      for (Int_t i = 0; i < n; ++i) {
+         blocks[t][i] = gMalloc(size);
+         gFree(gMalloc(size));
+      }
+   });
+   const Long64_t allocated = profiler->GetLiveBytes();
+   EXPECT_LE(samples + 2 * nThreads * n, profiler->GetNSamples());
+   EXPECT_LE(live + nThreads * n * size, allocated);
+
+   runThreads([&](Int_t t) {
+      for (auto block : blocks[(t + 1) % nThreads])
+         gFree(block);
+   });
+   EXPECT_LE(profiler->GetLiveBytes(), allocated - nThreads * n * size);
+   EXPECT_LE(allocated, profiler->GetPeakBytes());
+
+   TMemProfiler::Stop();
+   const Long64_t stopped = profiler->GetNSamples();
+   gFree(gMalloc(size));
+   EXPECT_EQ(stopped, profiler->GetNSamples());
+
+   const auto filename = "TMemProfilerConcurrentAllocFree.root";
+   TMemProfiler::Close(filename);
+   gSystem->Unlink(filename);
+}
@@ -613,6 +613,13 @@ void TDavixFile::Seek(Long64_t offset, ERelativeTo pos)
 Bool_t TDavixFile::ReadBuffer(char *buf, Int_t len)
 {
    TLockGuard guard(&(d_ptr->positionLock));
+   Int_t st;
+   if ((st = ReadBufferViaBlockCache(buf, len))) {
+      if (st == 2)
+         return kTRUE;
+      return kFALSE;
+   }
+
    Davix_fd *fd;
    if ((fd = d_ptr->getDavixFileInstance()) == NULL)
       return kTRUE;
@@ -631,6 +638,13 @@ Bool_t TDavixFile::ReadBuffer(char *buf, Int_t len)
 
 Bool_t TDavixFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
+   Int_t st;
+   if ((st = ReadBuffersViaBlockCache(buf, &pos, &len, 1))) {
+      if (st == 2)
+         return kTRUE;
+      return kFALSE;
+   }
+
    Davix_fd *fd;
    if ((fd = d_ptr->getDavixFileInstance()) == NULL)
       return kTRUE;
@@ -665,6 +679,13 @@ Bool_t TDavixFile::ReadBufferAsync(Long64_t offs, Int_t len)
 
 Bool_t TDavixFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
 {
+   Int_t st;
+   if ((st = ReadBuffersViaBlockCache(buf, pos, len, nbuf))) {
+      if (st == 2)
+         return kTRUE;
+      return kFALSE;
+   }
+
    Davix_fd *fd;
    if ((fd = d_ptr->getDavixFileInstance()) == NULL)
       return kTRUE;
@@ -388,6 +388,13 @@ Bool_t TNetFile::ReadBuffers(char *buf,  Long64_t *pos, Int_t *len, Int_t nbuf)
 {
    if (!fSocket) return kTRUE;
 
+   Int_t st;
+   if ((st = ReadBuffersViaBlockCache(buf, pos, len, nbuf))) {
+      if (st == 2)
+         return kTRUE;
+      return kFALSE;
+   }
+
    // If it's an old version of the protocol try the default TFile::ReadBuffers
    if (fProtocol < 17)
       return TFile::ReadBuffers(buf, pos, len, nbuf);
@@ -305,6 +305,13 @@ Bool_t TS3WebFile::ReadBuffers(char* buf, Long64_t* pos, Int_t* len, Int_t nbuf)
    // single HTTP request with a muti-range header or we generate multiple
    // requests with a single range each.
 
+   Int_t st;
+   if ((st = ReadBuffersViaBlockCache(buf, pos, len, nbuf))) {
+      if (st == 2)
+         return kTRUE;
+      return kFALSE;
+   }
+
    // Does this server support multi-range GET requests?
    if (fUseMultiRange)
       return TWebFile::ReadBuffers(buf, pos, len, nbuf);
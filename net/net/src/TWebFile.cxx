@@ -498,6 +498,13 @@ Bool_t TWebFile::ReadBuffer10(char *buf, Int_t len)
 
 Bool_t TWebFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
 {
+   Int_t st;
+   if ((st = ReadBuffersViaBlockCache(buf, pos, len, nbuf))) {
+      if (st == 2)
+         return kTRUE;
+      return kFALSE;
+   }
+
    if (!fHasModRoot)
       return ReadBuffers10(buf, pos, len, nbuf);
 
@@ -470,6 +470,13 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
    if (!IsUseable())
       return kTRUE;
 
+   Int_t cacheStatus;
+   if ((cacheStatus = ReadBuffersViaBlockCache(buffer, position, length, nbuffs))) {
+      if (cacheStatus == 2)
+         return kTRUE;
+      return kFALSE;
+   }
+
    std::vector<ChunkList>      chunkLists;
    ChunkList                   chunks;
    std::vector<XRootDStatus*> *statuses;
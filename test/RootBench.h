@@ -0,0 +1,341 @@
+// @(#)root/test:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// Minimal benchmark harness used by rootbench.cxx.
+//
+// A benchmark is a function taking a RootBench::State, which times the body
+// of its `while (state.KeepRunning())` loop. The runner chooses the number of
+// iterations so that a run lasts at least --benchmark_min_time seconds, then
+// repeats the run --benchmark_repetitions times and reports the mean, median
+// and standard deviation of the time per iteration. The command line options
+// and the JSON written with --benchmark_out follow the conventions of Google
+// Benchmark, so that its tools (e.g. compare.py) can be used to compare two
+// result files.
+
+#ifndef ROOT_RootBench
+#define ROOT_RootBench
+
+#include "TDatime.h"
+#include "TROOT.h"
+#include "TSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RootBench {
+
+class State {
+private:
+   Long64_t fIterations;
+   Long64_t fDone = 0;
+   bool fStarted = false;
+   bool fRunning = false;
+   std::chrono::steady_clock::time_point fRealStart;
+   std::clock_t fCpuStart = 0;
+   double fRealTime = 0; // seconds
+   double fCpuTime = 0;  // seconds
+   double fBytes = 0;
+   double fItems = 0;
+   std::map<std::string, double> fCounters;
+
+public:
+   explicit State(Long64_t iterations) : fIterations(iterations) {}
+
+   /// Return true as long as the body of the benchmark must be run again.
+   /// The time is measured from the first call to the last one.
+   bool KeepRunning()
+   {
+      if (!fStarted) {
+         fStarted = true;
+         ResumeTiming();
+      }
+      if (fDone < fIterations) {
+         ++fDone;
+         return true;
+      }
+      PauseTiming();
+      return false;
+   }
+
+   /// Stop the clocks, e.g. around the preparation of the next iteration.
+   void PauseTiming()
+   {
+      if (!fRunning)
+         return;
+      fRealTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - fRealStart).count();
+      fCpuTime += double(std::clock() - fCpuStart) / CLOCKS_PER_SEC;
+      fRunning = false;
+   }
+
+   void ResumeTiming()
+   {
+      if (fRunning)
+         return;
+      fRealStart = std::chrono::steady_clock::now();
+      fCpuStart = std::clock();
+      fRunning = true;
+   }
+
+   Long64_t GetIterations() const { return fIterations; }
+   /// Total number of bytes processed by all the iterations.
+   void SetBytesProcessed(double bytes) { fBytes = bytes; }
+   /// Total number of items (entries, calls...) processed by all the iterations.
+   void SetItemsProcessed(double items) { fItems = items; }
+   /// A named quantity reported as is, e.g. a cache efficiency.
+   double &Counter(const std::string &name) { return fCounters[name]; }
+
+   double GetRealTime() const { return fRealTime; }
+   double GetCpuTime() const { return fCpuTime; }
+   double GetBytes() const { return fBytes; }
+   double GetItems() const { return fItems; }
+   const std::map<std::string, double> &GetCounters() const { return fCounters; }
+};
+
+class Runner {
+private:
+   struct Benchmark_t {
+      std::string fName;
+      std::function<void(State &)> fFunc;
+   };
+   struct Result_t {
+      std::string fName;
+      std::string fAggregate; // empty for a single run
+      Int_t fRepetition = 0;
+      Long64_t fIterations = 0;
+      double fRealTime = 0; // ms per iteration
+      double fCpuTime = 0;  // ms per iteration
+      double fBytesPerSecond = 0;
+      double fItemsPerSecond = 0;
+      std::map<std::string, double> fCounters;
+   };
+
+   std::vector<Benchmark_t> fBenchmarks;
+   std::string fExecutable;
+   std::string fFilter = ".*";
+   std::string fOut;
+   Int_t fRepetitions = 3;
+   double fMinTime = 0.5;
+   bool fList = false;
+
+   static Result_t ToResult(const std::string &name, const State &state)
+   {
+      Result_t result;
+      result.fName = name;
+      result.fIterations = state.GetIterations();
+      result.fRealTime = 1e3 * state.GetRealTime() / state.GetIterations();
+      result.fCpuTime = 1e3 * state.GetCpuTime() / state.GetIterations();
+      if (state.GetRealTime() > 0) {
+         result.fBytesPerSecond = state.GetBytes() / state.GetRealTime();
+         result.fItemsPerSecond = state.GetItems() / state.GetRealTime();
+      }
+      result.fCounters = state.GetCounters();
+      return result;
+   }
+
+   /// Mean, median or standard deviation of each quantity of runs.
+   static Result_t Aggregate(const std::vector<Result_t> &runs, const std::string &what)
+   {
+      Result_t result = runs.front();
+      result.fAggregate = what;
+      auto stat = [&runs, &what](std::function<double(const Result_t &)> get) {
+         std::vector<double> values;
+         for (const auto &run : runs)
+            values.push_back(get(run));
+         double mean = 0;
+         for (double v : values)
+            mean += v;
+         mean /= values.size();
+         if (what == "mean")
+            return mean;
+         if (what == "median") {
+            std::sort(values.begin(), values.end());
+            const auto n = values.size();
+            return n % 2 ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+         }
+         double var = 0;
+         for (double v : values)
+            var += (v - mean) * (v - mean);
+         return values.size() > 1 ? std::sqrt(var / (values.size() - 1)) : 0.;
+      };
+      result.fRealTime = stat([](const Result_t &r) { return r.fRealTime; });
+      result.fCpuTime = stat([](const Result_t &r) { return r.fCpuTime; });
+      result.fBytesPerSecond = stat([](const Result_t &r) { return r.fBytesPerSecond; });
+      result.fItemsPerSecond = stat([](const Result_t &r) { return r.fItemsPerSecond; });
+      for (auto &counter : result.fCounters) {
+         const std::string name = counter.first;
+         counter.second = stat([&name](const Result_t &r) { return r.fCounters.at(name); });
+      }
+      return result;
+   }
+
+   static std::string Human(double perSecond, const char *unit)
+   {
+      const char *prefixes[] = {"", "k", "M", "G", "T"};
+      Int_t i = 0;
+      while (perSecond >= 1000 && i < 4) {
+         perSecond /= 1000;
+         ++i;
+      }
+      char buf[64];
+      snprintf(buf, sizeof(buf), "%.3g %s%s/s", perSecond, prefixes[i], unit);
+      return buf;
+   }
+
+   static void Print(const Result_t &result)
+   {
+      std::string name = result.fName;
+      if (!result.fAggregate.empty())
+         name += "_" + result.fAggregate;
+      printf("%-60s %12.4f ms %12.4f ms %10lld", name.c_str(), result.fRealTime, result.fCpuTime,
+             result.fIterations);
+      if (result.fBytesPerSecond > 0)
+         printf(" %14s", Human(result.fBytesPerSecond, "B").c_str());
+      if (result.fItemsPerSecond > 0)
+         printf(" %14s", Human(result.fItemsPerSecond, "").c_str());
+      for (const auto &counter : result.fCounters)
+         printf(" %s=%g", counter.first.c_str(), counter.second);
+      printf("\n");
+   }
+
+   void WriteJSON(const std::vector<Result_t> &results) const
+   {
+      FILE *out = fopen(fOut.c_str(), "w");
+      if (!out) {
+         fprintf(stderr, "rootbench: cannot write %s\n", fOut.c_str());
+         return;
+      }
+      TDatime now;
+      fprintf(out, "{\n  \"context\": {\n");
+      fprintf(out, "    \"date\": \"%s\",\n", now.AsSQLString());
+      fprintf(out, "    \"host_name\": \"%s\",\n", gSystem->HostName());
+      fprintf(out, "    \"executable\": \"%s\",\n", fExecutable.c_str());
+      fprintf(out, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+      fprintf(out, "    \"root_version\": \"%s\",\n", gROOT->GetVersion());
+      fprintf(out, "    \"root_git_commit\": \"%s\",\n", gROOT->GetGitCommit());
+      fprintf(out, "    \"compiler\": \"%s\"\n", gSystem->GetBuildCompilerVersion());
+      fprintf(out, "  },\n  \"benchmarks\": [");
+      for (size_t i = 0; i < results.size(); ++i) {
+         const Result_t &r = results[i];
+         const bool aggregate = !r.fAggregate.empty();
+         const std::string name = aggregate ? r.fName + "_" + r.fAggregate : r.fName;
+         fprintf(out, "%s\n    {\n", i ? "," : "");
+         fprintf(out, "      \"name\": \"%s\",\n", name.c_str());
+         fprintf(out, "      \"run_name\": \"%s\",\n", r.fName.c_str());
+         fprintf(out, "      \"run_type\": \"%s\",\n", aggregate ? "aggregate" : "iteration");
+         fprintf(out, "      \"repetitions\": %d,\n", fRepetitions);
+         if (aggregate)
+            fprintf(out, "      \"aggregate_name\": \"%s\",\n", r.fAggregate.c_str());
+         else
+            fprintf(out, "      \"repetition_index\": %d,\n", r.fRepetition);
+         fprintf(out, "      \"iterations\": %lld,\n", r.fIterations);
+         fprintf(out, "      \"real_time\": %.9g,\n", r.fRealTime);
+         fprintf(out, "      \"cpu_time\": %.9g,\n", r.fCpuTime);
+         if (r.fBytesPerSecond > 0)
+            fprintf(out, "      \"bytes_per_second\": %.9g,\n", r.fBytesPerSecond);
+         if (r.fItemsPerSecond > 0)
+            fprintf(out, "      \"items_per_second\": %.9g,\n", r.fItemsPerSecond);
+         for (const auto &counter : r.fCounters)
+            fprintf(out, "      \"%s\": %.9g,\n", counter.first.c_str(), counter.second);
+         fprintf(out, "      \"time_unit\": \"ms\"\n    }");
+      }
+      fprintf(out, "\n  ]\n}\n");
+      fclose(out);
+      printf("Results written to %s\n", fOut.c_str());
+   }
+
+public:
+   /// Parse the options --benchmark_filter=<regex>, --benchmark_out=<file.json>,
+   /// --benchmark_repetitions=<n>, --benchmark_min_time=<seconds> and
+   /// --benchmark_list_tests.
+   Runner(int argc, char **argv) : fExecutable(argc ? argv[0] : "rootbench")
+   {
+      for (int i = 1; i < argc; ++i) {
+         std::string arg = argv[i];
+         auto value = [&arg]() { return arg.substr(arg.find('=') + 1); };
+         if (arg.find("--benchmark_filter=") == 0)
+            fFilter = value();
+         else if (arg.find("--benchmark_out=") == 0)
+            fOut = value();
+         else if (arg.find("--benchmark_repetitions=") == 0)
+            fRepetitions = std::max(1, atoi(value().c_str()));
+         else if (arg.find("--benchmark_min_time=") == 0)
+            fMinTime = atof(value().c_str());
+         else if (arg == "--benchmark_list_tests" || arg == "--benchmark_list_tests=true")
+            fList = true;
+         else
+            fprintf(stderr, "rootbench: ignoring unknown option %s\n", arg.c_str());
+      }
+   }
+
+   void Add(const std::string &name, std::function<void(State &)> func) { fBenchmarks.push_back({name, func}); }
+
+   /// Run the selected benchmarks and return the exit code of the program.
+   int Run()
+   {
+      const std::regex filter(fFilter);
+      std::vector<Result_t> results;
+      if (!fList)
+         printf("%-60s %15s %15s %10s\n", "Benchmark", "Time", "CPU", "Iterations");
+      for (const auto &benchmark : fBenchmarks) {
+         if (!std::regex_search(benchmark.fName, filter))
+            continue;
+         if (fList) {
+            printf("%s\n", benchmark.fName.c_str());
+            continue;
+         }
+
+         // Find the number of iterations lasting at least fMinTime
+         Long64_t iterations = 1;
+         while (true) {
+            State state(iterations);
+            benchmark.fFunc(state);
+            const double time = state.GetRealTime();
+            if (time >= fMinTime || iterations >= 1000000000LL)
+               break;
+            const double factor = time > 0 ? 1.4 * fMinTime / time : 10.;
+            iterations = std::max(iterations + 1, Long64_t(iterations * std::min(factor, 10.)));
+         }
+
+         std::vector<Result_t> runs;
+         for (Int_t rep = 0; rep < fRepetitions; ++rep) {
+            State state(iterations);
+            benchmark.fFunc(state);
+            runs.push_back(ToResult(benchmark.fName, state));
+            runs.back().fRepetition = rep;
+            Print(runs.back());
+         }
+         results.insert(results.end(), runs.begin(), runs.end());
+         if (fRepetitions > 1) {
+            for (const char *what : {"mean", "median", "stddev"}) {
+               results.push_back(Aggregate(runs, what));
+               Print(results.back());
+            }
+         }
+      }
+      if (!fOut.empty())
+         WriteJSON(results);
+      return 0;
+   }
+};
+
+} // namespace RootBench
+
+#endif
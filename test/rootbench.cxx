@@ -0,0 +1,472 @@
+// @(#)root/test:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// rootbench: micro- and macro-benchmarks of the I/O and analysis hot paths
+//
+// Covers TTree writing and reading per branch type and compression
+// algorithm, the efficiency of the TTreeCache, the event rate of RDataFrame
+// as a function of the number of threads, RNTuple writing and reading,
+// histogram filling, Minuit2 fits and TFormula evaluation.
+//
+// Usage:
+//   rootbench [--benchmark_filter=<regex>] [--benchmark_out=<file.json>]
+//             [--benchmark_repetitions=<n>] [--benchmark_min_time=<seconds>]
+//             [--benchmark_list_tests]
+//
+// The JSON output has the format of Google Benchmark; two result files, e.g.
+// before and after a change, can be compared with its tools/compare.py:
+//   rootbench --benchmark_out=before.json
+//   ... rebuild ...
+//   rootbench --benchmark_out=after.json
+//   compare.py benchmarks before.json after.json
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RootBench.h"
+
+#include "Compression.h"
+#include "TError.h"
+#include "TF1.h"
+#include "TFile.h"
+#include "TFitResult.h"
+#include "TFormula.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TMemFile.h"
+#include "TRandom3.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+#include "Math/MinimizerOptions.h"
+
+#ifdef ROOTBENCH_WITH_DATAFRAME
+#include "ROOT/RDataFrame.hxx"
+#endif
+#ifdef ROOTBENCH_WITH_NTUPLE
+#include "ROOT/RNTuple.hxx"
+#include "ROOT/RNTupleModel.hxx"
+#endif
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using RootBench::State;
+
+namespace {
+
+const Long64_t kNEntries = 500000;
+const Int_t kNCacheBranches = 20;
+
+struct Compression_t {
+   const char *fName;
+   Int_t fSettings;
+};
+
+const Compression_t kCompressions[] = {{"none", 0},
+                                       {"zlib1", ROOT::CompressionSettings(ROOT::kZLIB, 1)},
+                                       {"lz4_4", ROOT::CompressionSettings(ROOT::kLZ4, 4)},
+                                       {"lzma7", ROOT::CompressionSettings(ROOT::kLZMA, 7)}};
+
+enum EBranchType { kInt, kFloat, kDouble, kVectorFloat };
+const char *const kBranchTypeNames[] = {"int", "float", "double", "vector_float"};
+
+std::string TempPath(const char *name)
+{
+   return std::string(gSystem->TempDirectory()) + "/rootbench_" + std::to_string(gSystem->GetPid()) + "_" + name;
+}
+
+/// Files created by the benchmarks, removed at exit.
+struct TempFiles_t {
+   std::vector<std::string> fPaths;
+   ~TempFiles_t()
+   {
+      for (const auto &path : fPaths)
+         gSystem->Unlink(path.c_str());
+   }
+} gTempFiles;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill tree with kNEntries entries of a single branch "x" of the given type.
+
+void FillTree(TTree &tree, EBranchType type)
+{
+   TRandom3 rnd(1);
+   Int_t i = 0;
+   Float_t f = 0;
+   Double_t d = 0;
+   std::vector<float> v;
+   switch (type) {
+   case kInt: tree.Branch("x", &i, "x/I"); break;
+   case kFloat: tree.Branch("x", &f, "x/F"); break;
+   case kDouble: tree.Branch("x", &d, "x/D"); break;
+   case kVectorFloat: tree.Branch("x", &v); break;
+   }
+   for (Long64_t entry = 0; entry < kNEntries; ++entry) {
+      switch (type) {
+      case kInt: i = rnd.Poisson(10); break;
+      case kFloat: f = rnd.Gaus(); break;
+      case kDouble: d = rnd.Gaus(); break;
+      case kVectorFloat:
+         v.resize(rnd.Integer(10));
+         for (auto &x : v)
+            x = rnd.Gaus();
+         break;
+      }
+      tree.Fill();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Path of a file holding the tree "t" filled by FillTree, created on first use.
+
+const std::string &GetTreeFile(EBranchType type, const Compression_t &comp)
+{
+   static std::map<std::string, std::string> files;
+   const std::string key = std::string(kBranchTypeNames[type]) + "_" + comp.fName;
+   auto it = files.find(key);
+   if (it != files.end())
+      return it->second;
+   const std::string path = TempPath((key + ".root").c_str());
+   TFile file(path.c_str(), "RECREATE", "", comp.fSettings);
+   TTree tree("t", "rootbench");
+   FillTree(tree, type);
+   file.Write();
+   gTempFiles.fPaths.push_back(path);
+   return files[key] = path;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Path of a file with kNCacheBranches double branches x0, x1..., created on
+/// first use.
+
+const std::string &GetWideTreeFile()
+{
+   static std::string path;
+   if (!path.empty())
+      return path;
+   path = TempPath("wide.root");
+   TFile file(path.c_str(), "RECREATE");
+   TTree tree("t", "rootbench");
+   std::vector<Double_t> x(kNCacheBranches);
+   for (Int_t b = 0; b < kNCacheBranches; ++b)
+      tree.Branch(("x" + std::to_string(b)).c_str(), &x[b], ("x" + std::to_string(b) + "/D").c_str());
+   TRandom3 rnd(1);
+   for (Long64_t entry = 0; entry < kNEntries / 5; ++entry) {
+      for (auto &v : x)
+         v = rnd.Gaus();
+      tree.Fill();
+   }
+   file.Write();
+   gTempFiles.fPaths.push_back(path);
+   return path;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the tree to a TMemFile, so that only serialization and compression
+/// are measured.
+
+void BM_TTreeWrite(State &state, EBranchType type, const Compression_t &comp)
+{
+   Long64_t bytes = 0;
+   while (state.KeepRunning()) {
+      TMemFile file("rootbench_write.root", "RECREATE", "", comp.fSettings);
+      TTree tree("t", "rootbench");
+      FillTree(tree, type);
+      file.Write();
+      bytes += tree.GetTotBytes();
+   }
+   state.SetBytesProcessed(bytes);
+   state.SetItemsProcessed(double(kNEntries) * state.GetIterations());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read all the entries of the tree; the rate is in uncompressed bytes.
+
+void BM_TTreeRead(State &state, EBranchType type, const Compression_t &comp)
+{
+   const std::string &path = GetTreeFile(type, comp);
+   Long64_t bytes = 0;
+   while (state.KeepRunning()) {
+      std::unique_ptr<TFile> file(TFile::Open(path.c_str()));
+      auto tree = file->Get<TTree>("t");
+      for (Long64_t entry = 0; entry < kNEntries; ++entry)
+         tree->GetEntry(entry);
+      bytes += tree->GetTotBytes();
+   }
+   state.SetBytesProcessed(bytes);
+   state.SetItemsProcessed(double(kNEntries) * state.GetIterations());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read nbranches branches of the wide tree with or without TTreeCache and
+/// report the number of read calls and the efficiency of the cache.
+
+void BM_TTreeCache(State &state, bool useCache, Int_t nbranches)
+{
+   const std::string &path = GetWideTreeFile();
+   Double_t readCalls = 0, efficiency = 0, efficiencyRel = 0;
+   while (state.KeepRunning()) {
+      std::unique_ptr<TFile> file(TFile::Open(path.c_str()));
+      auto tree = file->Get<TTree>("t");
+      tree->SetCacheSize(useCache ? 30000000 : 0);
+      tree->SetBranchStatus("*", false);
+      for (Int_t b = 0; b < nbranches; ++b) {
+         const std::string name = "x" + std::to_string(b);
+         tree->SetBranchStatus(name.c_str(), true);
+         if (useCache)
+            tree->AddBranchToCache(name.c_str());
+      }
+      const Long64_t n = tree->GetEntries();
+      for (Long64_t entry = 0; entry < n; ++entry)
+         tree->GetEntry(entry);
+      readCalls += file->GetReadCalls();
+      if (auto cache = dynamic_cast<TTreeCache *>(file->GetCacheRead(tree))) {
+         efficiency += cache->GetEfficiency();
+         efficiencyRel += cache->GetEfficiencyRel();
+      }
+   }
+   state.Counter("read_calls") = readCalls / state.GetIterations();
+   state.Counter("efficiency") = efficiency / state.GetIterations();
+   state.Counter("efficiency_rel") = efficiencyRel / state.GetIterations();
+   state.SetItemsProcessed(double(kNEntries / 5) * state.GetIterations());
+}
+
+#ifdef ROOTBENCH_WITH_DATAFRAME
+////////////////////////////////////////////////////////////////////////////////
+/// Event rate of RDataFrame with nthreads threads (0 disables the implicit
+/// multi-threading), on an empty source or on a TTree.
+
+void BM_RDataFrame(State &state, bool fromTree, UInt_t nthreads)
+{
+#ifdef R__USE_IMT
+   if (nthreads)
+      ROOT::EnableImplicitMT(nthreads);
+#endif
+   const std::string &path = GetTreeFile(kDouble, kCompressions[2]);
+   Long64_t entries = 0;
+   while (state.KeepRunning()) {
+      if (fromTree) {
+         ROOT::RDataFrame df("t", path);
+         auto h = df.Filter([](double x) { return x > -1; }, {"x"}).Histo1D("x");
+         h->GetEntries();
+         entries += kNEntries;
+      } else {
+         ROOT::RDataFrame df(kNEntries * 4);
+         auto sum = df.Define("x", [](ULong64_t e) { return std::sqrt(double(e)); }, {"rdfentry_"}).Sum<double>("x");
+         *sum;
+         entries += kNEntries * 4;
+      }
+   }
+#ifdef R__USE_IMT
+   if (nthreads)
+      ROOT::DisableImplicitMT();
+#endif
+   state.SetItemsProcessed(entries);
+}
+#endif
+
+#ifdef ROOTBENCH_WITH_NTUPLE
+////////////////////////////////////////////////////////////////////////////////
+/// Write and read a float field, as the TTree benchmarks do for a branch.
+
+void BM_RNTupleWrite(State &state)
+{
+   using namespace ROOT::Experimental;
+   const std::string path = TempPath("ntuple_write.root");
+   while (state.KeepRunning()) {
+      auto model = RNTupleModel::Create();
+      auto x = model->MakeField<float>("x");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "t", path);
+      TRandom3 rnd(1);
+      for (Long64_t entry = 0; entry < kNEntries; ++entry) {
+         *x = rnd.Gaus();
+         ntuple->Fill();
+      }
+   }
+   gSystem->Unlink(path.c_str());
+   state.SetBytesProcessed(double(kNEntries) * sizeof(float) * state.GetIterations());
+   state.SetItemsProcessed(double(kNEntries) * state.GetIterations());
+}
+
+void BM_RNTupleRead(State &state)
+{
+   using namespace ROOT::Experimental;
+   static std::string path;
+   if (path.empty()) {
+      path = TempPath("ntuple_read.root");
+      auto model = RNTupleModel::Create();
+      auto x = model->MakeField<float>("x");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "t", path);
+      TRandom3 rnd(1);
+      for (Long64_t entry = 0; entry < kNEntries; ++entry) {
+         *x = rnd.Gaus();
+         ntuple->Fill();
+      }
+      gTempFiles.fPaths.push_back(path);
+   }
+   double sum = 0;
+   while (state.KeepRunning()) {
+      auto ntuple = RNTupleReader::Open("t", path);
+      auto view = ntuple->GetView<float>("x");
+      for (auto entry : ntuple->GetViewRange())
+         sum += view(entry);
+   }
+   state.Counter("checksum") = sum / state.GetIterations();
+   state.SetBytesProcessed(double(kNEntries) * sizeof(float) * state.GetIterations());
+   state.SetItemsProcessed(double(kNEntries) * state.GetIterations());
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Histogram filling, one value at a time or with FillN.
+
+void BM_TH1Fill(State &state, bool useFillN)
+{
+   const Int_t n = 1000000;
+   std::vector<Double_t> x(n);
+   TRandom3 rnd(1);
+   for (auto &v : x)
+      v = rnd.Gaus();
+   TH1D h("h", "rootbench", 100, -5, 5);
+   h.SetDirectory(nullptr);
+   while (state.KeepRunning()) {
+      if (useFillN) {
+         h.FillN(n, x.data(), nullptr);
+      } else {
+         for (Int_t i = 0; i < n; ++i)
+            h.Fill(x[i]);
+      }
+   }
+   state.SetItemsProcessed(double(n) * state.GetIterations());
+}
+
+void BM_TH2Fill(State &state)
+{
+   const Int_t n = 1000000;
+   std::vector<Double_t> x(n), y(n);
+   TRandom3 rnd(1);
+   for (Int_t i = 0; i < n; ++i)
+      rnd.Rannor(x[i], y[i]);
+   TH2D h("h2", "rootbench", 100, -5, 5, 100, -5, 5);
+   h.SetDirectory(nullptr);
+   while (state.KeepRunning()) {
+      for (Int_t i = 0; i < n; ++i)
+         h.Fill(x[i], y[i]);
+   }
+   state.SetItemsProcessed(double(n) * state.GetIterations());
+}
+
+#ifdef ROOTBENCH_WITH_MINUIT2
+////////////////////////////////////////////////////////////////////////////////
+/// Fit of a histogram with Minuit2; option "L" selects the likelihood fit.
+
+void BM_Fit(State &state, const char *formula, const char *option)
+{
+   ROOT::Math::MinimizerOptions::SetDefaultMinimizer("Minuit2");
+   TH1D h("hfit", "rootbench", 200, -5, 5);
+   h.SetDirectory(nullptr);
+   TRandom3 rnd(1);
+   for (Int_t i = 0; i < 100000; ++i)
+      h.Fill(rnd.Gaus(0.5, 1.2));
+   const std::string opt = std::string("Q0N") + option;
+   Double_t ncalls = 0;
+   while (state.KeepRunning()) {
+      TF1 f("f", formula, -5, 5);
+      if (f.GetNpar() == 3)
+         f.SetParameters(h.GetMaximum(), 0, 1);
+      auto result = h.Fit(&f, (opt + "S").c_str());
+      ncalls += result->NCalls();
+   }
+   state.Counter("ncalls") = ncalls / state.GetIterations();
+   state.SetItemsProcessed(state.GetIterations());
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluation of a TFormula, at a point or with explicit parameters.
+
+void BM_TFormulaEval(State &state, bool withParams)
+{
+   TFormula f("f", "[0]*exp(-0.5*((x-[1])/[2])^2)+[3]*x");
+   Double_t params[] = {10, 0.5, 1.2, 0.1};
+   f.SetParameters(params);
+   const Int_t n = 1000000;
+   Double_t sum = 0;
+   while (state.KeepRunning()) {
+      for (Int_t i = 0; i < n; ++i) {
+         Double_t x = -5 + 10. * i / n;
+         sum += withParams ? f.EvalPar(&x, params) : f.Eval(x);
+      }
+   }
+   state.Counter("checksum") = sum / state.GetIterations();
+   state.SetItemsProcessed(double(n) * state.GetIterations());
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+   gErrorIgnoreLevel = kWarning;
+   RootBench::Runner runner(argc, argv);
+
+   for (Int_t type = kInt; type <= kVectorFloat; ++type) {
+      for (const auto &comp : kCompressions) {
+         const std::string suffix = std::string(kBranchTypeNames[type]) + "/" + comp.fName;
+         const EBranchType btype = EBranchType(type);
+         runner.Add("TTreeWrite/" + suffix, [btype, &comp](State &s) { BM_TTreeWrite(s, btype, comp); });
+         runner.Add("TTreeRead/" + suffix, [btype, &comp](State &s) { BM_TTreeRead(s, btype, comp); });
+      }
+   }
+
+   runner.Add("TTreeCache/off/all", [](State &s) { BM_TTreeCache(s, false, kNCacheBranches); });
+   runner.Add("TTreeCache/on/all", [](State &s) { BM_TTreeCache(s, true, kNCacheBranches); });
+   runner.Add("TTreeCache/off/subset", [](State &s) { BM_TTreeCache(s, false, kNCacheBranches / 4); });
+   runner.Add("TTreeCache/on/subset", [](State &s) { BM_TTreeCache(s, true, kNCacheBranches / 4); });
+
+#ifdef ROOTBENCH_WITH_DATAFRAME
+   std::vector<UInt_t> nthreads = {0};
+#ifdef R__USE_IMT
+   const UInt_t ncores = std::max(1u, std::thread::hardware_concurrency());
+   for (UInt_t n = 1; n < ncores; n *= 2)
+      nthreads.push_back(n);
+   nthreads.push_back(ncores);
+#endif
+   for (UInt_t n : nthreads) {
+      const std::string threads = "/threads:" + std::to_string(n);
+      runner.Add("RDataFrame/empty" + threads, [n](State &s) { BM_RDataFrame(s, false, n); });
+      runner.Add("RDataFrame/tree" + threads, [n](State &s) { BM_RDataFrame(s, true, n); });
+   }
+#endif
+
+#ifdef ROOTBENCH_WITH_NTUPLE
+   runner.Add("RNTupleWrite/float", BM_RNTupleWrite);
+   runner.Add("RNTupleRead/float", BM_RNTupleRead);
+#endif
+
+   runner.Add("TH1Fill/Fill", [](State &s) { BM_TH1Fill(s, false); });
+   runner.Add("TH1Fill/FillN", [](State &s) { BM_TH1Fill(s, true); });
+   runner.Add("TH2Fill/Fill", BM_TH2Fill);
+
+#ifdef ROOTBENCH_WITH_MINUIT2
+   runner.Add("Fit/chi2/gaus", [](State &s) { BM_Fit(s, "gaus", ""); });
+   runner.Add("Fit/likelihood/gaus", [](State &s) { BM_Fit(s, "gaus", "L"); });
+   runner.Add("Fit/chi2/pol6", [](State &s) { BM_Fit(s, "pol6", ""); });
+#endif
+
+   runner.Add("TFormula/Eval", [](State &s) { BM_TFormulaEval(s, false); });
+   runner.Add("TFormula/EvalPar", [](State &s) { BM_TFormulaEval(s, true); });
+
+   return runner.Run();
+}
@@ -29,6 +29,7 @@
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RMakeUnique.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
+#include "ROOT/TThreadedObject.hxx" // for TreeMerge
 #include "ROOT/TypeTraits.hxx"
 #include "ROOT/RDF/RDisplay.hxx"
 #include "RtypesCore.h"
@@ -418,15 +419,10 @@ public:
 
    void Finalize()
    {
-      auto resObj = fObjects[0];
-      const auto nSlots = fObjects.size();
-      TList l;
-      l.SetOwner(); // The list will free the memory associated to its elements upon destruction
-      for (unsigned int slot = 1; slot < nSlots; ++slot) {
-         l.Add(fObjects[slot]);
-      }
-
-      resObj->Merge(&l);
+      // Merge pairwise, in parallel if the implicit multi-threading is enabled
+      ROOT::Internal::TThreadedObjectUtils::TreeMerge(fObjects);
+      for (unsigned int slot = 1; slot < fObjects.size(); ++slot)
+         delete fObjects[slot];
    }
 
    HIST &PartialUpdate(unsigned int slot) { return *fObjects[slot]; }
@@ -485,14 +481,10 @@ public:
 
    void Finalize()
    {
-      const auto nSlots = fGraphs.size();
-      auto resGraph = fGraphs[0];
-      TList l;
-      l.SetOwner(); // The list will free the memory associated to its elements upon destruction
-      for (unsigned int slot = 1; slot < nSlots; ++slot) {
-         l.Add(fGraphs[slot]);
-      }
-      resGraph->Merge(&l);
+      // Merge pairwise, in parallel if the implicit multi-threading is enabled
+      ROOT::Internal::TThreadedObjectUtils::TreeMerge(fGraphs);
+      for (unsigned int slot = 1; slot < fGraphs.size(); ++slot)
+         delete fGraphs[slot];
    }
 
    std::string GetActionName() { return "Graph"; }
@@ -23,6 +23,8 @@
 
 #include "TBranch.h"
 
+#include <vector>
+
 namespace ROOT {
 namespace Experimental {
 namespace Internal {
@@ -33,9 +35,11 @@ class TBulkBranchRead {
 
 public:
    Int_t  GetBulkEntries(Long64_t evt, TBuffer& user_buf);
+   Int_t  GetBulkEntriesWithOffsets(Long64_t evt, TBuffer& user_buf, std::vector<Int_t>& offsets);
    Int_t  GetEntriesSerialized(Long64_t evt, TBuffer& user_buf);
    Int_t  GetEntriesSerialized(Long64_t evt, TBuffer& user_buf, TBuffer* count_buf);
    Bool_t SupportsBulkRead() const;
+   Bool_t SupportsBulkReadWithOffsets() const;
 
 private:
    TBulkBranchRead(TBranch &parent)
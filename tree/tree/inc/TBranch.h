@@ -24,6 +24,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <memory>
+#include <vector>
 
 #include "Compression.h"
 
@@ -147,10 +148,13 @@ protected:
 
    TString  GetRealFileName() const;
 
+   virtual Bool_t GetBulkLayoutWithOffsets(EDataType &type, Int_t &headerSize) const;
+
 private:
    Int_t    GetBasketAndFirst(TBasket*& basket, Long64_t& first, TBuffer* user_buffer);
    TBasket *GetBasketImpl(Int_t basket, TBuffer* user_buffer);
    Int_t    GetBulkEntries(Long64_t, TBuffer&);
+   Int_t    GetBulkEntriesWithOffsets(Long64_t, TBuffer&, std::vector<Int_t>&);
    Int_t    GetEntriesSerialized(Long64_t N, TBuffer& user_buf) {return GetEntriesSerialized(N, user_buf, nullptr);}
    Int_t    GetEntriesSerialized(Long64_t, TBuffer&, TBuffer*);
    Int_t    FillEntryBuffer(TBasket* basket,TBuffer* buf, Int_t& lnew);
@@ -255,6 +259,7 @@ public:
    virtual void      SetTree(TTree *tree) { fTree = tree;}
    virtual void      SetupAddresses();
            Bool_t    SupportsBulkRead() const;
+           Bool_t    SupportsBulkReadWithOffsets() const;
    virtual void      UpdateAddress() {;}
    virtual void      UpdateFile();
 
@@ -120,6 +120,7 @@ protected:
    virtual void             InitInfo();
    Bool_t                   IsMissingCollection() const;
    TStreamerInfo           *FindOnfileInfo(TClass *valueClass, const TObjArray &branches) const;
+   virtual Bool_t           GetBulkLayoutWithOffsets(EDataType &type, Int_t &headerSize) const;
    TClass                  *GetParentClass(); // Class referenced by fParentName
    TStreamerInfo           *GetInfoImp() const;
    void                     ReleaseObject();
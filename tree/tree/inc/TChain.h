@@ -53,6 +53,7 @@ private:
 protected:
    void InvalidateCurrentTree();
    void ReleaseChainProof();
+   void UpdateTreeOffsets();
 
 public:
    // TChain constants
@@ -119,6 +120,7 @@ public:
            Int_t     GetTreeOffsetLen() const { return fTreeOffsetLen; }
    virtual Double_t  GetWeight() const;
    virtual Int_t     LoadBaskets(Long64_t maxmemory);
+   virtual Int_t     LoadMetadata(const char *filename);
    virtual Long64_t  LoadTree(Long64_t entry);
            void      Lookup(Bool_t force = kFALSE);
    virtual void      Loop(Option_t *option="", Long64_t nentries=kMaxEntries, Long64_t firstentry=0); // *MENU*
@@ -136,7 +138,9 @@ public:
    virtual void      ResetAfterMerge(TFileMergeInfo *);
    virtual void      ResetBranchAddress(TBranch *);
    virtual void      ResetBranchAddresses();
+   virtual Int_t     SaveMetadata(const char *filename);
    virtual void      SavePrimitive (std::ostream &out, Option_t *option="");
+   virtual Long64_t  ScanMetadata(Bool_t clusters = kTRUE);
    virtual Long64_t  Scan(const char *varexp="", const char *selection="", Option_t *option="", Long64_t nentries=kMaxEntries, Long64_t firstentry=0); // *MENU*
    virtual void      SetAutoDelete(Bool_t autodel=kTRUE);
    virtual Int_t     SetBranchAddress(const char *bname,void *add, TBranch **ptr = 0);
@@ -55,6 +55,7 @@ class TEntryListBlock:public TObject
    Int_t    fLastIndexReturned; ///<! to optimize GetEntry() in a loop
 
    void Transform(Bool_t dir, UShort_t *indexnew);
+   void FillBits(UShort_t *bits) const;
 
  public:
 
@@ -69,6 +70,7 @@ class TEntryListBlock:public TObject
    Int_t   Contains(Int_t entry);
    void    OptimizeStorage();
    Int_t   Merge(TEntryListBlock *block);
+   Int_t   Subtract(TEntryListBlock *block);
    Int_t   Next();
    Int_t   GetEntry(Int_t entry);
    void    ResetIndices() {fLastIndexQueried = -1, fLastIndexReturned = -1;}
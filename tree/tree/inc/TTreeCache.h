@@ -69,6 +69,8 @@ protected:
    Bool_t       fAutoCreated{kFALSE}; ///<! true if cache was automatically created
 
    Bool_t       fLearnPrefilling{kFALSE}; ///<! true if we are in the process of executing LearnPrefill
+   TString      fLearnFile;              ///<! file where the learned branches are persisted (see LoadLearnedBranches)
+   Bool_t       fLearnedFromFile{kFALSE}; ///<! true if the branches in the cache were loaded from a file
 
    // These members hold cached data for missed branches when miss optimization
    // is enabled.  Pointers are only initialized if the miss cache is enabled.
@@ -140,6 +142,7 @@ public:
    virtual void         Enable() {fEnabled = kTRUE;}
    Bool_t               GetOptimizeMisses() const { return fOptimizeMisses; }
    const TObjArray     *GetCachedBranches() const { return fBranches; }
+   TString              GetConfiguredLearnFile() const;
    EPrefillType         GetConfiguredPrefillType() const;
    Double_t             GetEfficiency() const;
    Double_t             GetEfficiencyRel() const;
@@ -157,6 +160,7 @@ public:
    virtual Bool_t       FillBuffer();
    virtual Int_t        LearnBranch(TBranch *b, Bool_t subgbranches = kFALSE);
    virtual void         LearnPrefill();
+   virtual Int_t        LoadLearnedBranches(const char *filename);
 
    virtual void         Print(Option_t *option="") const;
    virtual Int_t        ReadBuffer(char *buf, Long64_t pos, Int_t len);
@@ -164,10 +168,12 @@ public:
    virtual Int_t        ReadBufferPrefetch(char *buf, Long64_t pos, Int_t len);
    virtual void         ResetCache();
    void                 ResetMissCache(); // Reset the miss cache.
+   virtual Int_t        SaveLearnedBranches(const char *filename) const;
    void                 SetAutoCreated(Bool_t val) {fAutoCreated = val;}
    virtual Int_t        SetBufferSize(Int_t buffersize);
    virtual void         SetEntryRange(Long64_t emin,   Long64_t emax);
    virtual void         SetFile(TFile *file, TFile::ECacheAction action=TFile::kDisconnect);
+   void                 SetLearnFile(const char *filename) { fLearnFile = filename; }
    virtual void         SetLearnPrefill(EPrefillType type = kNoPrefill);
    static void          SetLearnEntries(Int_t n = 10);
    void                 SetOptimizeMisses(Bool_t opt);
@@ -48,6 +48,7 @@ class TTreeCloner {
    TObjArray  fToBranches;
 
    UInt_t     fMaxBaskets;
+   UInt_t     fNBaskets;         ///< Number of baskets collected for the current copy.
    UInt_t    *fBasketBranchNum;  ///<[fMaxBaskets] Index of the branch(es) of the basket.
    UInt_t    *fBasketNum;        ///<[fMaxBaskets] index of the basket within the branch.
 
@@ -59,6 +60,9 @@ class TTreeCloner {
 
    UInt_t     fCloneMethod;      ///< Indicates which cloning method was selected.
    Long64_t   fToStartEntries;   ///< Number of entries in the target tree before any addition.
+   Long64_t   fFirstEntry;       ///< First entry of the range being copied (0 for a full copy).
+   Long64_t   fLastEntry;        ///< Last entry (exclusive) of the range being copied (-1 for a full copy).
+   Bool_t     fRangeSetupDone;   ///< True once the one-time steps of the range copies were executed.
 
    Int_t           fCacheSize;   ///< Requested size of the file cache
    TFileCacheRead *fFileCache;   ///< File Cache used to reduce the number of individual reads
@@ -89,6 +93,7 @@ class TTreeCloner {
    friend class CompareEntry;
 
    void ImportClusterRanges();
+   void ImportClusterRange();
    void CreateCache();
    UInt_t FillCache(UInt_t from);
    void RestoreCache();
@@ -118,6 +123,8 @@ public:
    void   CopyProcessIds();
    const char *GetWarning() const { return fWarningMsg; }
    Bool_t Exec();
+   Bool_t ExecRange(Long64_t first, Long64_t last);
+   Bool_t IsRangeCloneable(Long64_t first, Long64_t last) const;
    Bool_t IsValid() { return fIsValid; }
    Bool_t NeedConversion() { return fNeedConversion; }
    void   SetCacheSize(Int_t size);
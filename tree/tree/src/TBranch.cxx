@@ -1478,6 +1478,164 @@ Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf)
    return N;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if this branch supports bulk IO of variable-size entries
+/// (see GetBulkEntriesWithOffsets), false otherwise.
+
+Bool_t TBranch::SupportsBulkReadWithOffsets() const {
+   EDataType type;
+   Int_t headerSize;
+   return GetBulkLayoutWithOffsets(type, headerSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Describe the on-disk layout of a variable-size entry of this branch for
+/// bulk IO: the primitive type of the elements and the number of bytes
+/// preceding the elements in each entry.
+///
+/// Returns false if the entries of this branch are not a plain (possibly
+/// empty) sequence of primitive elements.  The base implementation handles
+/// leaflist arrays with a count leaf, such as `f[n]/F`.
+
+Bool_t TBranch::GetBulkLayoutWithOffsets(EDataType &type, Int_t &headerSize) const
+{
+   if (fNleaves != 1) return kFALSE;
+   TLeaf *leaf = static_cast<TLeaf*>(fLeaves.UncheckedAt(0));
+   if (!leaf->GetLeafCount()) return kFALSE;
+   TDataType *dt = gROOT->GetType(leaf->GetTypeName());
+   if (!dt) return kFALSE;
+   type = (EDataType)dt->GetType();
+   headerSize = 0;
+   switch (type) {
+      case kChar_t: case kUChar_t: case kBool_t:
+      case kShort_t: case kUShort_t:
+      case kInt_t: case kUInt_t: case kFloat_t:
+      case kLong64_t: case kULong64_t: case kDouble_t:
+         return kTRUE;
+      default:
+         return kFALSE;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read all the entries of the basket starting at `entry` into the given
+/// buffer, for branches whose entries hold a variable number of primitive
+/// elements (leaflist arrays with a count leaf, std::vector of a fundamental
+/// type, data members of a split STL collection).
+///
+/// Returns -1 in case of a failure.  On success, returns the (non-zero) number
+/// of entries read.  The elements of all these entries are then stored
+/// contiguously and in native byte order in buf, accessible as
+///
+/// static_cast<T*>(buf.GetCurrent())
+///
+/// and the elements of entry `entry + i` are at indices [offsets[i], offsets[i+1]);
+/// offsets is resized to the number of entries plus one.
+///
+/// The per-entry headers are stripped and the elements are compacted in place
+/// in the basket buffer, then byte-swapped in a single pass.
+///
+/// NOTES:
+/// - This interface is meant to be used by higher-level, type-safe wrappers, not
+///   by end-users.
+/// - As for GetBulkEntries, `entry` must be the first entry of a basket.
+
+Int_t TBranch::GetBulkEntriesWithOffsets(Long64_t entry, TBuffer &user_buf, std::vector<Int_t> &offsets)
+{
+   EDataType type;
+   Int_t headerSize;
+   if (R__unlikely(!GetBulkLayoutWithOffsets(type, headerSize))) return -1;
+   const Int_t elemSize = TDataType::GetDataType(type)->Size();
+
+   // Remember which entry we are reading.
+   fReadEntry = entry;
+
+   Bool_t enabled = !TestBit(kDoNotProcess);
+   if (R__unlikely(!enabled)) return -1;
+   TBasket *basket = nullptr;
+   Long64_t first;
+   Int_t result = GetBasketAndFirst(basket, first, &user_buf);
+   if (R__unlikely(result <= 0)) return -1;
+   // Only support reading from full clusters.
+   if (R__unlikely(entry != first)) {
+      return -1;
+   }
+
+   basket->PrepareBasket(entry);
+   TBuffer* buf = basket->GetBufferRef();
+
+   // Test for very old ROOT files.
+   if (R__unlikely(!buf)) {
+      Error("GetBulkEntriesWithOffsets", "Failed to get a new buffer.\n");
+      return -1;
+   }
+   // Test for displacements, which aren't supported in fast mode.
+   if (R__unlikely(basket->GetDisplacement())) {
+      Error("GetBulkEntriesWithOffsets", "Basket has displacement.\n");
+      return -1;
+   }
+   Int_t *entryOffset = basket->GetEntryOffset();
+   if (R__unlikely(!entryOffset)) {
+      Error("GetBulkEntriesWithOffsets", "Basket has no entry offsets.\n");
+      return -1;
+   }
+
+   Int_t N = ((fNextBasketEntry < 0) ? fEntryNumber : fNextBasketEntry) - first;
+   Int_t bufbegin = basket->GetKeylen();
+   Int_t last = basket->GetLast();
+   char *data = buf->Buffer();
+   char *dest = data + bufbegin;
+
+   offsets.resize(N + 1);
+   offsets[0] = 0;
+   for (Int_t idx = 0; idx < N; ++idx) {
+      Int_t begin = entryOffset[idx];
+      Int_t end = (idx + 1 < N) ? entryOffset[idx + 1] : last;
+      Int_t nbytes = end - begin - headerSize;
+      char *src = data + begin;
+      if (headerSize) {
+         // Objectwise streamed collection: byte count, class version, size.
+         const UInt_t kByteCountMask = 0x40000000;
+         UInt_t bytecount;
+         Version_t version;
+         Int_t nelem;
+         char *hdr = src;
+         frombuf(hdr, &bytecount);
+         frombuf(hdr, &version);
+         frombuf(hdr, &nelem);
+         if (R__unlikely(!(bytecount & kByteCountMask) ||
+                         (Int_t)(bytecount & ~kByteCountMask) != end - begin - (Int_t)sizeof(UInt_t) ||
+                         nelem * elemSize != nbytes)) {
+            Error("GetBulkEntriesWithOffsets", "Unexpected layout for entry %lld.\n", entry + idx);
+            return -1;
+         }
+         src += headerSize;
+      }
+      if (R__unlikely(nbytes < 0 || nbytes % elemSize)) {
+         Error("GetBulkEntriesWithOffsets", "Unexpected size for entry %lld.\n", entry + idx);
+         return -1;
+      }
+      // Entries only shrink, so the destination never overtakes the source.
+      if (dest != src) memmove(dest, src, nbytes);
+      dest += nbytes;
+      offsets[idx + 1] = offsets[idx] + nbytes / elemSize;
+   }
+
+   buf->SetBufferOffset(bufbegin);
+   if (elemSize > 1 && R__unlikely(!buf->ByteSwapBuffer(offsets[N], type))) {
+      Error("GetBulkEntriesWithOffsets", "Failed to byte-swap the elements.\n");
+      return -1;
+   }
+   user_buf.SetBufferOffset(bufbegin);
+
+   fCurrentBasket = nullptr;
+   fBaskets[fReadBasket] = nullptr;
+   fExtraBasket = basket;
+   basket->DisownBuffer();
+
+   return N;
+}
+
 // TODO: Template this and the call above; only difference is the TLeaf function (ReadBasketFast vs
 // ReadBasketSerialized
 Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *count_buf)
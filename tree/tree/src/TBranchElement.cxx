@@ -2703,6 +2703,52 @@ Int_t TBranchElement::GetExpectedType(TClass *&expectedClass,EDataType &expected
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Describe the on-disk layout of a variable-size entry for bulk IO.
+///
+/// Supported are the data members of fundamental type (or fixed-size arrays
+/// thereof) of a split STL collection, whose entries hold the plain elements,
+/// and unsplit top-level std::vector of a fundamental type, whose entries are
+/// prefixed by the byte count, the class version and the size of the vector.
+
+Bool_t TBranchElement::GetBulkLayoutWithOffsets(EDataType &type, Int_t &headerSize) const
+{
+   if (fType == 41) {
+      TVirtualCollectionProxy *proxy = fBranchCount ? fBranchCount->GetCollectionProxy() : nullptr;
+      if (!proxy || proxy->HasPointers()) {
+         return kFALSE;
+      }
+      Int_t bareType = fStreamerType;
+      if (bareType > TVirtualStreamerInfo::kOffsetL && bareType < TVirtualStreamerInfo::kOffsetP) {
+         bareType -= TVirtualStreamerInfo::kOffsetL;
+      }
+      type = (EDataType)bareType;
+      headerSize = 0;
+   } else if (fType == 0 && fID == -1 && fStreamerType == -1 && fSTLtype == ROOT::kSTLvector) {
+      TClass *cl = fBranchClass.GetClass();
+      TVirtualCollectionProxy *proxy = cl ? cl->GetCollectionProxy() : nullptr;
+      if (!proxy || proxy->GetValueClass()) {
+         return kFALSE;
+      }
+      type = proxy->GetType();
+      if (type == kBool_t) {
+         return kFALSE; // std::vector<bool> is streamed element by element.
+      }
+      headerSize = sizeof(UInt_t) + sizeof(Version_t) + sizeof(Int_t);
+   } else {
+      return kFALSE;
+   }
+   switch (type) {
+      case kChar_t: case kUChar_t: case kBool_t:
+      case kShort_t: case kUShort_t:
+      case kInt_t: case kUInt_t: case kFloat_t:
+      case kLong64_t: case kULong64_t: case kDouble_t:
+         return kTRUE;
+      default:
+         return kFALSE;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return icon name depending on type of branch element.
 
@@ -22,6 +22,28 @@ to Draw,Scan,etc.
 
 Use TChain::SetBranchStatus to activate one or more branches for all
 the trees in the chain.
+
+### Chain metadata
+
+Knowing the number of entries of each file (for example to call
+TChain::GetEntries or to jump to an entry in a late file) normally requires
+opening the files one after the other. For large datasets on high-latency
+storage this can be avoided:
+  - TChain::ScanMetadata opens the files whose number of entries is not yet
+    known, in parallel when implicit multi-threading is enabled, and records
+    their number of entries and cluster boundaries. TChain::GetEntries uses it
+    automatically when implicit multi-threading is enabled.
+  - TChain::SaveMetadata writes this information to a small text file that
+    can be stored next to the dataset; TChain::LoadMetadata reads it back so
+    that no file needs to be opened at all.
+~~~ {.cpp}
+    TChain chain("T");
+    chain.Add("/data/run*.root");
+    if (chain.LoadMetadata("/data/run.chainmeta") < chain.GetNtrees())
+       chain.SaveMetadata("/data/run.chainmeta");
+~~~
+ROOT::TTreeProcessorMT reuses the cluster boundaries recorded in the chain
+instead of opening each file once more to compute them.
 */
 
 #include "TChain.h"
@@ -56,6 +78,17 @@ the trees in the chain.
 #include "TFilePrefetch.h"
 #include "TVirtualMutex.h"
 
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 ClassImp(TChain);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -522,10 +555,11 @@ Int_t TChain::AddFile(const char* name, Long64_t nentries /* = TTree::kMaxEntrie
    }
 
    if (nentries > 0) {
-      if (nentries != TTree::kMaxEntries) {
+      if (nentries != TTree::kMaxEntries && fTreeOffset[fNtrees] != TTree::kMaxEntries) {
          fTreeOffset[fNtrees+1] = fTreeOffset[fNtrees] + nentries;
          fEntries += nentries;
       } else {
+         // The number of entries of this file or of a previous one is unknown.
          fTreeOffset[fNtrees+1] = TTree::kMaxEntries;
          fEntries = TTree::kMaxEntries;
       }
@@ -947,7 +981,13 @@ Long64_t TChain::GetEntries() const
       return fProofChain->GetEntries();
    }
    if (fEntries == TTree::kMaxEntries) {
-      const_cast<TChain*>(this)->LoadTree(TTree::kMaxEntries-1);
+#ifdef R__USE_IMT
+      // Open the files concurrently instead of one after the other.
+      if (ROOT::IsImplicitMTEnabled() && fNtrees > 1)
+         const_cast<TChain*>(this)->ScanMetadata(kFALSE);
+#endif
+      if (fEntries == TTree::kMaxEntries)
+         const_cast<TChain*>(this)->LoadTree(TTree::kMaxEntries-1);
    }
    return fEntries;
 }
@@ -1253,6 +1293,74 @@ Int_t TChain::LoadBaskets(Long64_t /*maxmemory*/)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the number of entries and the cluster boundaries of the files of this
+/// chain from a metadata file written by TChain::SaveMetadata.
+///
+/// Files of the chain are matched by file and tree name; files not described
+/// in the metadata file are left untouched. The tree offsets of the chain are
+/// updated, so that TChain::GetEntries and TChain::LoadTree do not need to
+/// open the described files anymore.
+///
+/// Returns the number of files of the chain for which metadata was found,
+/// or -1 if the metadata file cannot be read.
+
+Int_t TChain::LoadMetadata(const char *filename)
+{
+   if (!filename || !filename[0])
+      return -1;
+   TString path(filename);
+   gSystem->ExpandPathName(path);
+   std::ifstream in(path.Data());
+   if (!in) {
+      Error("LoadMetadata", "Cannot open metadata file %s", path.Data());
+      return -1;
+   }
+
+   struct FileMetadata {
+      Long64_t fEntries;
+      std::vector<Long64_t> fClusterStarts;
+   };
+   // Key is the tree name and the file name, separated by a new line.
+   std::unordered_map<std::string, FileMetadata> metadata;
+   std::string line;
+   while (std::getline(in, line)) {
+      if (line.empty() || line[0] == '#')
+         continue;
+      // Format: <entries> <nclusters> <cluster starts...> <tree name> <file name>
+      std::istringstream fields(line);
+      FileMetadata md;
+      std::size_t nclusters = 0;
+      std::string treename;
+      if (!(fields >> md.fEntries >> nclusters))
+         continue;
+      md.fClusterStarts.resize(nclusters);
+      for (auto &start : md.fClusterStarts)
+         fields >> start;
+      fields >> treename >> std::ws;
+      std::string file;
+      std::getline(fields, file);
+      if (fields.fail() || treename.empty() || file.empty() || md.fEntries < 0) {
+         Warning("LoadMetadata", "Skipping malformed line in %s: %s", path.Data(), line.c_str());
+         continue;
+      }
+      metadata[treename + '\n' + file] = std::move(md);
+   }
+
+   Int_t nfound = 0;
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      auto element = static_cast<TChainElement *>(fFiles->UncheckedAt(i));
+      auto it = metadata.find(std::string(element->GetName()) + '\n' + element->GetTitle());
+      if (it == metadata.end())
+         continue;
+      element->SetNumberEntries(it->second.fEntries);
+      element->SetClusterStarts(it->second.fClusterStarts);
+      ++nfound;
+   }
+   UpdateTreeOffsets();
+   return nfound;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Find the tree which contains entry, and set it as the current tree.
 ///
@@ -1298,15 +1406,9 @@ Long64_t TChain::LoadTree(Long64_t entry)
    Int_t treenum = fTreeNumber;
    if ((fTreeNumber == -1) || (entry < fTreeOffset[fTreeNumber]) || (entry >= fTreeOffset[fTreeNumber+1]) || (entry==TTree::kMaxEntries-1)) {
       // -- Entry is *not* in the chain's current tree.
-      // Do a linear search of the tree offset array.
-      // FIXME: We could be smarter by starting at the
-      //        current tree number and going forwards,
-      //        then wrapping around at the end.
-      for (treenum = 0; treenum < fNtrees; treenum++) {
-         if (entry < fTreeOffset[treenum+1]) {
-            break;
-         }
-      }
+      // Do a binary search of the tree offset array, which is sorted
+      // (unknown offsets are set to TTree::kMaxEntries up to the end).
+      treenum = std::upper_bound(fTreeOffset + 1, fTreeOffset + fNtrees + 1, entry) - (fTreeOffset + 1);
    }
 
    // Calculate the entry number relative to the found tree.
@@ -2307,6 +2409,59 @@ void TChain::ResetAfterMerge(TFileMergeInfo *info)
    TTree::ResetAfterMerge(info);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write the number of entries and the cluster boundaries of the files of this
+/// chain to a metadata file that can be read back by TChain::LoadMetadata.
+///
+/// Files whose metadata is not known yet are opened first, see
+/// TChain::ScanMetadata. Files which cannot be opened are not written.
+/// The metadata file is a small text file with one line per file of the
+/// chain; it is replaced atomically.
+///
+/// Returns the number of files described, or -1 in case of error.
+
+Int_t TChain::SaveMetadata(const char *filename)
+{
+   if (!filename || !filename[0])
+      return -1;
+   ScanMetadata(kTRUE);
+
+   TString path(filename);
+   gSystem->ExpandPathName(path);
+   TString tmpPath = TString::Format("%s.tmp%d", path.Data(), gSystem->GetPid());
+   Int_t nwritten = 0;
+   {
+      std::ofstream out(tmpPath.Data());
+      if (!out) {
+         Error("SaveMetadata", "Cannot create metadata file %s", tmpPath.Data());
+         return -1;
+      }
+      out << "# TChain metadata: <entries> <nclusters> <cluster starts...> <tree name> <file name>\n";
+      for (Int_t i = 0; i < fNtrees; ++i) {
+         auto element = static_cast<TChainElement *>(fFiles->UncheckedAt(i));
+         if (element->GetEntries() == TTree::kMaxEntries || element->GetLoadResult() < 0)
+            continue;
+         const auto &starts = element->GetClusterStarts();
+         out << element->GetEntries() << ' ' << starts.size();
+         for (auto start : starts)
+            out << ' ' << start;
+         out << ' ' << element->GetName() << ' ' << element->GetTitle() << '\n';
+         ++nwritten;
+      }
+      if (!out) {
+         Error("SaveMetadata", "Cannot write metadata file %s", tmpPath.Data());
+         gSystem->Unlink(tmpPath);
+         return -1;
+      }
+   }
+   if (gSystem->Rename(tmpPath, path)) {
+      Error("SaveMetadata", "Cannot rename %s to %s", tmpPath.Data(), path.Data());
+      gSystem->Unlink(tmpPath);
+      return -1;
+   }
+   return nwritten;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Save TChain as a C++ statements on output stream out.
 /// With the option "friend" save the description of all the 
@@ -2389,6 +2544,69 @@ Long64_t TChain::Scan(const char* varexp, const char* selection, Option_t* optio
    return TTree::Scan(varexp, selection, option, nentries, firstentry);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Open the files of this chain whose number of entries (or, if clusters is
+/// true, whose cluster boundaries) are not known yet and record them in the
+/// corresponding TChainElement.
+///
+/// When implicit multi-threading is enabled the files are opened concurrently,
+/// which avoids paying the latency of each file open one after the other.
+/// Files which cannot be opened are counted as having no entries, as
+/// TChain::LoadTree does. The tree offsets of the chain are updated, but the
+/// current tree is not changed.
+///
+/// Returns the total number of entries of the chain.
+
+Long64_t TChain::ScanMetadata(Bool_t clusters)
+{
+   std::vector<TChainElement *> elements;
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      auto element = static_cast<TChainElement *>(fFiles->UncheckedAt(i));
+      const Long64_t nentries = element->GetEntries();
+      if (nentries == TTree::kMaxEntries || (clusters && nentries > 0 && element->GetClusterStarts().empty()))
+         elements.emplace_back(element);
+   }
+
+   auto scanFile = [clusters](TChainElement *element) {
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> file(TFile::Open(element->GetTitle()));
+      TTree *tree = nullptr; // owned by file
+      if (file && !file->IsZombie())
+         file->GetObject(element->GetName(), tree);
+      if (!tree) {
+         ::Error("TChain::ScanMetadata", "Cannot find tree with name %s in file %s", element->GetName(),
+                 element->GetTitle());
+         element->SetNumberEntries(0);
+         element->SetLoadResult(file && !file->IsZombie() ? -4 : -3);
+         return;
+      }
+      const Long64_t nentries = tree->GetEntries();
+      element->SetNumberEntries(nentries);
+      if (clusters) {
+         std::vector<Long64_t> starts;
+         auto clusterIter = tree->GetClusterIterator(0);
+         Long64_t start;
+         while ((start = clusterIter()) < nentries)
+            starts.emplace_back(start);
+         element->SetClusterStarts(starts);
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && elements.size() > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(scanFile, elements);
+   } else
+#endif
+   {
+      for (auto element : elements)
+         scanFile(element);
+   }
+
+   UpdateTreeOffsets();
+   return fEntries;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the global branch kAutoDelete bit.
 ///
@@ -2976,6 +3194,24 @@ void TChain::Streamer(TBuffer& b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Recompute the tree offsets and the number of entries of the chain from the
+/// number of entries of its elements. The offsets after the first element with
+/// an unknown number of entries are set to TTree::kMaxEntries.
+
+void TChain::UpdateTreeOffsets()
+{
+   fTreeOffset[0] = 0;
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      const Long64_t nentries = static_cast<TChainElement *>(fFiles->UncheckedAt(i))->GetEntries();
+      if (fTreeOffset[i] == TTree::kMaxEntries || nentries == TTree::kMaxEntries)
+         fTreeOffset[i + 1] = TTree::kMaxEntries;
+      else
+         fTreeOffset[i + 1] = fTreeOffset[i] + nentries;
+   }
+   fEntries = fTreeOffset[fNtrees];
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Dummy function kept for back compatibility.
 /// The cache is now activated automatically when processing TTrees/TChain.
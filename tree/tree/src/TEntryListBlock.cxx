@@ -38,6 +38,8 @@ End_Macro
  - __Merge__() - adds all entries from one block to the other. If the first block
              uses array representation, it's changed to bits representation only
              if the total number of passing entries is still less than kBlockSize
+ - __Subtract__() - removes all entries of one block from the other.
+ - Both operations work on whole 16-bit words of the bit representation.
  - __GetEntry(n)__ - returns n-th non-zero entry.
  - __Next__()      - return next non-zero entry. In case of representation 1), Next()
                  is faster than GetEntry()
@@ -46,8 +48,27 @@ End_Macro
 #include "TEntryListBlock.h"
 #include "TString.h"
 
+#include <algorithm>
+#include <bitset>
+
 ClassImp(TEntryListBlock);
 
+namespace {
+
+/// Number of bits set in word.
+inline Int_t CountBits(UShort_t word)
+{
+   return std::bitset<16>(word).count();
+}
+
+/// Position of the lowest bit set in word, which must not be 0.
+inline Int_t LowestBit(UShort_t word)
+{
+   return CountBits((word & -word) - 1);
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default c-tor
 
@@ -206,34 +227,16 @@ Int_t TEntryListBlock::Contains(Int_t entry)
       Bool_t result = (fIndices[i] & (1<<j))!=0;
       return result;
    }
-   //list
-   if (entry < fCurrent) fCurrent = 0;
+   //list, sorted
    if (fPassing && fIndices){
-      for (Int_t i = fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
+      return std::binary_search(fIndices, fIndices + fNPassed, (UShort_t)entry);
    } else {
       if (!fIndices || fNPassed==0){
          //all entries pass
          return kTRUE;
       }
-      if (entry > fIndices[fNPassed-1])
-         return kTRUE;
-      for (Int_t i= fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kFALSE;
-         }
-         if (fIndices[i]>entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
+      return !std::binary_search(fIndices, fIndices + fNPassed, (UShort_t)entry);
    }
-   return 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -259,35 +262,17 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
       return fNPassed;
    }
    if (fType==0){
-      //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
-         }
-      } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
-         }
+      //stored as bits, or the words of the two bit representations
+      UShort_t other[kBlockSize];
+      const UShort_t *bits = block->fIndices;
+      if (block->fType != 0) {
+         block->FillBits(other);
+         bits = other;
+      }
+      fNPassed = 0;
+      for (i=0; i<kBlockSize; i++){
+         fIndices[i] |= bits[i];
+         fNPassed += CountBits(fIndices[i]);
       }
    } else {
       //stored as a list
@@ -334,16 +319,18 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
             UShort_t *newlist = new UShort_t[newsize];
             Int_t newpos, current;
             newpos = current = 0;
-            for (i=0; i<kBlockSize*16; i++){
-               if (!block->Contains(i)) continue;
-               while(current < fNPassed && fIndices[current]<i){
-                  newlist[newpos] = fIndices[current];
-                  current++;
+            for (j=0; j<kBlockSize; j++){
+               for (UShort_t word = block->fIndices[j]; word; word &= word - 1) {
+                  i = j*16 + LowestBit(word);
+                  while(current < fNPassed && fIndices[current]<i){
+                     newlist[newpos] = fIndices[current];
+                     current++;
+                     newpos++;
+                  }
+                  if (current < fNPassed && fIndices[current]==i) current++;
+                  newlist[newpos] = i;
                   newpos++;
                }
-               if (fIndices[current]==i) current++;
-               newlist[newpos] = i;
-               newpos++;
             }
             while(current<fNPassed){
                newlist[newpos] = fIndices[current];
@@ -363,6 +350,35 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    return GetNPassed();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the entries of the other block from this block.
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Subtract(TEntryListBlock *block)
+{
+   if (GetNPassed() == 0 || block->GetNPassed() == 0) return GetNPassed();
+   if (fType != 0) {
+      //change to bits
+      UShort_t *bits = new UShort_t[kBlockSize];
+      Transform(1, bits);
+   }
+   UShort_t other[kBlockSize];
+   const UShort_t *bits = block->fIndices;
+   if (block->fType != 0) {
+      block->FillBits(other);
+      bits = other;
+   }
+   fNPassed = 0;
+   for (Int_t i=0; i<kBlockSize; i++){
+      fIndices[i] &= (UShort_t)~bits[i];
+      fNPassed += CountBits(fIndices[i]);
+   }
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   OptimizeStorage();
+   return GetNPassed();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of entries, passing the selection.
 /// In case, when the block stores entries that pass (fPassing=1) returns fNPassed
@@ -387,14 +403,17 @@ Int_t TEntryListBlock::GetEntry(Int_t entry)
    else {
       Int_t i=0; Int_t j=0; Int_t entries_found=0;
       if (fType==0){
-         if ((fIndices[i] & (1<<j))!=0)
-            entries_found++;
-         while (entries_found<entry+1){
-            if (j==15){i++; j=0;}
-            else j++;
-            if ((fIndices[i] & (1<<j))!=0)
-               entries_found++;
+         //find the word holding the entry, then the bit in the word
+         Int_t nbits;
+         while (i<kBlockSize && entries_found + (nbits = CountBits(fIndices[i])) <= entry){
+            entries_found += nbits;
+            i++;
          }
+         if (i==kBlockSize) return -1;
+         UShort_t word = fIndices[i];
+         for (; entries_found<entry; entries_found++)
+            word &= word - 1;
+         j = LowestBit(word);
          fLastIndexQueried = entry;
          fLastIndexReturned = i*16+j;
          return fLastIndexReturned;
@@ -454,18 +473,12 @@ Int_t TEntryListBlock::Next()
 
    if (fType==0) {
       //bits
-      Int_t i=0;
-      Int_t j=0;
       fLastIndexReturned++;
-      i = fLastIndexReturned>>4;
-      j = fLastIndexReturned & 15;
-      Bool_t result=(fIndices[i] & (1<<j))!=0;
-      while (result==0){
-         if (j==15) {j=0; i++;}
-         else j++;
-         result = (fIndices[i] & (1<<j))!=0;
-      }
-      fLastIndexReturned = i*16+j;
+      Int_t i = fLastIndexReturned>>4;
+      UShort_t word = fIndices[i] & (UShort_t)(0xFFFF << (fLastIndexReturned & 15));
+      while (!word)
+         word = fIndices[++i];
+      fLastIndexReturned = i*16 + LowestBit(word);
       fLastIndexQueried++;
       return fLastIndexReturned;
 
@@ -567,18 +580,11 @@ void TEntryListBlock::Transform(Bool_t dir, UShort_t *indexnew)
    Int_t ilist = 0;
    Int_t ibite, ibit;
    if (!dir) {
-         for (i=0; i<kBlockSize*16; i++){
-            ibite = i >> 4;
-            ibit = i & 15;
-            Bool_t result = (fIndices[ibite] & (1<<ibit))!=0;
-            if (result && fPassing){
-               //fill with the entries that pass
-               indexnew[ilist] = i;
-               ilist++;
-            }
-            else if (!result && !fPassing){
-               //fill with the entries that don't pass
-               indexnew[ilist] = i;
+         for (i=0; i<kBlockSize; i++){
+            //fill with the entries that pass or with the entries that don't pass
+            UShort_t word = fPassing ? fIndices[i] : (UShort_t)~fIndices[i];
+            for (; word; word &= word - 1) {
+               indexnew[ilist] = i*16 + LowestBit(word);
                ilist++;
             }
          }
@@ -618,3 +624,21 @@ void TEntryListBlock::Transform(Bool_t dir, UShort_t *indexnew)
    fPassing = 1;
    return;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill bits (kBlockSize words) with the bits representation of the block,
+/// whatever its current representation.
+
+void TEntryListBlock::FillBits(UShort_t *bits) const
+{
+   if (fType==0 && fIndices){
+      std::copy(fIndices, fIndices + kBlockSize, bits);
+      return;
+   }
+   std::fill(bits, bits + kBlockSize, fPassing ? 0 : 0xFFFF);
+   if (fType==1 && fIndices){
+      //the listed entries are all distinct: flip their bits
+      for (Int_t i=0; i<fNPassed; i++)
+         bits[fIndices[i]>>4] ^= 1<<(fIndices[i] & 15);
+   }
+}
@@ -3523,6 +3523,123 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
    return nbytes;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the entries of the given tree (or chain) selected by an entry list to
+/// this tree.
+/// As for the other CopyEntries, the branches intended to be copied are
+/// assumed to be already connected, typically because this tree was created
+/// using tree->CloneTree(0).
+///
+/// If the entry list has sub-lists, each of them selects the entries of the
+/// matching tree of the chain; otherwise the list holds global entry numbers.
+///
+/// If 'option' contains the word 'fast', the clusters of the input trees
+/// whose entries are all selected are copied without unzipping or
+/// unstreaming their baskets (see TTreeCloner::ExecRange), and only the
+/// clusters that are partially selected are read and filled again. This
+/// makes skims that keep most of the entries, or contiguous ranges of entries,
+/// almost as cheap as a fast clone. The basket sorting orders of
+/// CopyEntries(TTree*,Long64_t,Option_t*) are supported.
+///
+/// The TTreeIndex of the input trees are not copied, use BuildIndex on
+/// the output tree if needed.
+///
+/// Returns number of bytes copied to this tree.
+
+Long64_t TTree::CopyEntries(TTree* tree, TEntryList &entries, Option_t* option /* = "" */)
+{
+   if (!tree) {
+      return 0;
+   }
+   TString opt = option;
+   opt.ToLower();
+   Bool_t fastClone = opt.Contains("fast");
+
+   // Without sub-lists, the list holds global entry numbers.
+   std::vector<Long64_t> globalEntries;
+   if (!entries.GetLists()) {
+      Long64_t n = entries.GetN();
+      globalEntries.reserve(n);
+      for (Long64_t i = 0; i < n; ++i) {
+         globalEntries.push_back(entries.GetEntry(i));
+      }
+   }
+   auto nextGlobal = globalEntries.cbegin();
+
+   Long64_t totbytes = GetTotBytes();
+   std::vector<Long64_t> selected;
+   Long64_t start = 0;
+   Long64_t local;
+   while ((local = tree->LoadTree(start)) >= 0) {
+      TTree *localtree = tree->GetTree();
+      Long64_t offset = start - local;
+      Long64_t tentries = localtree->GetEntries();
+      start = offset + tentries;
+
+      // The selected entries of this tree, in local entry numbers.
+      selected.clear();
+      if (entries.GetLists()) {
+         TFile *file = localtree->GetCurrentFile();
+         TEntryList *sublist = file ? entries.GetEntryList(localtree->GetName(), file->GetName()) : nullptr;
+         if (sublist) {
+            Long64_t n = sublist->GetN();
+            selected.reserve(n);
+            for (Long64_t i = 0; i < n; ++i) {
+               selected.push_back(sublist->GetEntry(i));
+            }
+         }
+      } else {
+         for (; nextGlobal != globalEntries.cend() && *nextGlobal < start; ++nextGlobal) {
+            if (*nextGlobal >= offset) {
+               selected.push_back(*nextGlobal - offset);
+            }
+         }
+      }
+      if (selected.empty()) {
+         continue;
+      }
+
+      if (this->GetDirectory()) {
+         TFile* file2 = this->GetDirectory()->GetFile();
+         if (file2 && (file2->GetEND() > TTree::GetMaxTreeSize())) {
+            if (this->GetDirectory() == (TDirectory*) file2) {
+               this->ChangeFile(file2);
+            }
+         }
+      }
+      std::unique_ptr<TTreeCloner> cloner;
+      if (fastClone) {
+         cloner.reset(new TTreeCloner(localtree, this, option, TTreeCloner::kNoWarnings));
+         if (!cloner->IsValid()) {
+            if (gDebug > 0) {
+               Info("CopyEntries", "%s", cloner->GetWarning());
+            }
+            cloner.reset();
+         }
+      }
+
+      auto sel = selected.cbegin();
+      TClusterIterator clusterIter = localtree->GetClusterIterator(*sel);
+      Long64_t clusterStart;
+      while (sel != selected.cend() && (clusterStart = clusterIter()) < tentries) {
+         Long64_t clusterEnd = std::min(clusterIter.GetNextEntry(), tentries);
+         auto clusterSel = std::lower_bound(sel, selected.cend(), clusterEnd);
+         if (cloner && (clusterSel - sel) == (clusterEnd - clusterStart) &&
+             cloner->ExecRange(clusterStart, clusterEnd)) {
+            sel = clusterSel;
+            continue;
+         }
+         for (; sel != clusterSel; ++sel) {
+            if (tree->GetEntry(offset + *sel) <= 0) {
+               return GetTotBytes() - totbytes;
+            }
+            this->Fill();
+         }
+      }
+   }
+   return GetTotBytes() - totbytes;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy a tree with selection.
 ///
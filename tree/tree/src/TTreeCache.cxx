@@ -20,6 +20,7 @@
 - [General Description](#description)
 - [Changes in behaviour](#changesbehaviour)
 - [Self-optimization](#cachemisses)
+- [Persisting the learned branches](#learnfile)
 - [Examples of usage](#examples)
 - [Check performance and stats](#checkPerf)
 
@@ -125,6 +126,20 @@ Additionally, on the first miss of an event, we must iterate through all the
 This can be potentially a CPU-expensive operation compared to, e.g., the
 latency of a SSD.  This is why the miss cache is currently disabled by default.
 
+## <a name="learnfile"></a>Persisting the learned branches
+
+The branches learnt during the learning phase can be saved to a small text file
+and reused by the next job reading the same tree, which then prefetches from
+the first entry onward instead of reading the first fgLearnEntries entries
+branch by branch. The file is configured with TTreeCache::SetLearnFile, the
+environment variable `ROOT_TTREECACHE_LEARNFILE` or the resource variable
+`TTreeCache.LearnFile`: it is read when the cache is created and written at the
+end of the learning phase if it did not list any branch of the tree. A file
+written for a different set of branches of the tree is ignored and disables the
+learning phase, the branches to cache must then be added explicitly. The file
+can also be handled explicitly with TTreeCache::SaveLearnedBranches and
+TTreeCache::LoadLearnedBranches.
+
 ## <a name="examples"></a>Example usages of TTreeCache
 
 A few use cases are discussed below. A cache may be created with automatic
@@ -295,6 +310,13 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TVirtualPerfStats.h"
 #include <limits.h>
 
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
 Int_t TTreeCache::fgLearnEntries = 100;
 
 ClassImp(TTreeCache);
@@ -316,6 +338,9 @@ TTreeCache::TTreeCache(TTree *tree, Int_t buffersize)
    fEntryNext = fEntryMin + fgLearnEntries;
    Int_t nleaves = tree->GetListOfLeaves()->GetEntries();
    fBranches = new TObjArray(nleaves);
+   fLearnFile = GetConfiguredLearnFile();
+   if (!fLearnFile.IsNull())
+      LoadLearnedBranches(fLearnFile);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1769,10 +1794,29 @@ Bool_t TTreeCache::FillBuffer()
          fFirstTime = kFALSE;
       }
    }
+   if (fIsLearning && !fLearnPrefilling && !fLearnedFromFile && !fLearnFile.IsNull())
+      SaveLearnedBranches(fLearnFile);
    fIsLearning = kFALSE;
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of the file in which the learned branches are persisted
+/// from the environment variable ROOT_TTREECACHE_LEARNFILE or the resource
+/// variable TTreeCache.LearnFile. An empty name (the default) disables the
+/// persistence, see LoadLearnedBranches.
+
+TString TTreeCache::GetConfiguredLearnFile() const
+{
+   const char *stcp;
+
+   if (!(stcp = gSystem->Getenv("ROOT_TTREECACHE_LEARNFILE")) || !*stcp) {
+      stcp = gEnv->GetValue("TTreeCache.LearnFile", "");
+   }
+
+   return stcp;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the desired prefill type from the environment or resource variable
 /// - 0 - No prefill
@@ -1855,6 +1899,111 @@ Int_t TTreeCache::GetLearnEntries()
    return fgLearnEntries;
 }
 
+namespace {
+////////////////////////////////////////////////////////////////////////////////
+/// Line of a learn file recording the set of branches of a tree, see
+/// GetBranchListSignature.
+
+const char *const kLearnFileSignatureTag = "@branches";
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of leaves and checksum of the names of their branches, used to
+/// detect a learn file written for a tree with a different set of branches.
+
+std::string GetBranchListSignature(TTree *tree)
+{
+   TString names;
+   TIter next(tree->GetListOfLeaves());
+   while (auto leaf = static_cast<TLeaf *>(next())) {
+      names += leaf->GetBranch()->GetName();
+      names += ';';
+   }
+   std::ostringstream sig;
+   sig << tree->GetListOfLeaves()->GetEntries() << ' ' << names.Hash();
+   return sig.str();
+}
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add to the cache the branches of the current tree listed for it in filename,
+/// as written by SaveLearnedBranches, and stop the learning phase so that the
+/// cache prefetches these branches from the first entry onward.
+///
+/// The file is checked against the branches of the tree: if one of the listed
+/// branches does not exist, or if the tree had a different set of branches when
+/// the file was written, the file is considered stale. No branch is then added,
+/// the learning phase is stopped and the cache is set in manual mode (as after
+/// StopLearningPhase) so that the stale file is not overwritten; the branches
+/// to cache must then be added with AddBranch.
+///
+/// If a learn file is configured (see SetLearnFile, the environment variable
+/// ROOT_TTREECACHE_LEARNFILE or the resource variable TTreeCache.LearnFile),
+/// it is loaded when the cache is created and, if it did not list any branch
+/// of this tree, the branches used during the learning phase are saved into it
+/// when the learning phase ends. The next job reading the same tree thus skips
+/// the learning phase.
+///
+/// Returns:
+///  - the number of branches added to the cache (0 if filename is stale)
+///  - -1 if filename cannot be read
+
+Int_t TTreeCache::LoadLearnedBranches(const char *filename)
+{
+   std::ifstream in(filename);
+   if (!in)
+      return -1;
+
+   // For a TChain, the names are those of the branches of the current tree.
+   TTree *tree = fTree ? fTree->GetTree() : nullptr;
+   if (!tree)
+      return 0;
+   const std::string treeName = tree->GetName();
+   std::vector<TBranch *> branches;
+   Bool_t stale = kFALSE;
+   std::string line;
+   while (!stale && std::getline(in, line)) {
+      std::istringstream fields(line);
+      std::string tname, bname;
+      if (!(fields >> tname >> bname) || tname != treeName)
+         continue;
+      if (bname == kLearnFileSignatureTag) {
+         std::string sig;
+         std::getline(fields >> std::ws, sig);
+         stale = sig != GetBranchListSignature(tree);
+         continue;
+      }
+      TBranch *b = tree->GetBranch(bname.c_str());
+      if (!b)
+         stale = kTRUE;
+      else
+         branches.push_back(b);
+   }
+   if (stale) {
+      Warning("LoadLearnedBranches", "%s was written for a different set of branches of %s: it is ignored and "
+              "the learning phase is disabled, use AddBranch to select the branches to cache",
+              filename, treeName.c_str());
+      fIsLearning = kFALSE;
+      fIsManual = kTRUE;
+      fEntryNext = -1;
+      return 0;
+   }
+   Int_t nb = 0;
+   for (auto b : branches) {
+      if (AddBranch(b) >= 0)
+         ++nb;
+   }
+   if (nb > 0) {
+      // Same as when the branches were learnt on a previous file of a TChain.
+      fIsLearning = kFALSE;
+      fIsManual = kTRUE;
+      fEntryNext = -1;
+      fLearnedFromFile = kTRUE;
+      if (gDebug > 0)
+         Info("LoadLearnedBranches", "%d branches of %s loaded from %s", nb, treeName.c_str(), filename);
+   }
+   return nb;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print cache statistics. Like:
 ///
@@ -2026,6 +2175,65 @@ void TTreeCache::ResetCache()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write the names of the branches in the cache to filename, one line
+/// `<tree name> <branch name>` per branch, to be read back by
+/// LoadLearnedBranches. They are preceded by a line `<tree name> @branches
+/// <signature>` identifying the set of branches of the tree, against which
+/// LoadLearnedBranches checks the file. The lines of filename belonging to
+/// other trees are kept. The file is replaced atomically so that concurrent jobs never see a
+/// partially written file.
+///
+/// Returns:
+///  - the number of branches written
+///  - -1 on error
+
+Int_t TTreeCache::SaveLearnedBranches(const char *filename) const
+{
+   TTree *tree = fTree ? fTree->GetTree() : nullptr;
+   if (!tree || !fBrNames)
+      return -1;
+
+   const std::string treeName = tree->GetName();
+   std::string otherTrees;
+   {
+      std::ifstream in(filename);
+      std::string line;
+      while (std::getline(in, line)) {
+         std::istringstream fields(line);
+         std::string tname;
+         if ((fields >> tname) && tname != treeName)
+            otherTrees += line + '\n';
+      }
+   }
+
+   TString tmpName;
+   tmpName.Form("%s.%d.%lu", filename, gSystem->GetPid(),
+                (unsigned long)std::hash<std::thread::id>()(std::this_thread::get_id()));
+   Int_t nb = 0;
+   {
+      std::ofstream out(tmpName.Data());
+      out << otherTrees;
+      out << treeName << ' ' << kLearnFileSignatureTag << ' ' << GetBranchListSignature(tree) << '\n';
+      TIter next(fBrNames);
+      while (TObject *os = next()) {
+         out << treeName << ' ' << os->GetName() << '\n';
+         ++nb;
+      }
+      if (!out) {
+         Error("SaveLearnedBranches", "Cannot write %s", tmpName.Data());
+         nb = -1;
+      }
+   }
+   if (nb < 0 || gSystem->Rename(tmpName, filename)) {
+      if (nb >= 0)
+         Error("SaveLearnedBranches", "Cannot rename %s to %s", tmpName.Data(), filename);
+      gSystem->Unlink(tmpName);
+      return -1;
+   }
+   return nb;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Change the underlying buffer size of the cache.
 /// If the change of size means some cache content is lost, or if the buffer
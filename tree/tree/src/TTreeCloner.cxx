@@ -112,6 +112,7 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t option
    fFromBranches( from ? from->GetListOfLeaves()->GetEntries()+1 : 0),
    fToBranches( to ? to->GetListOfLeaves()->GetEntries()+1 : 0),
    fMaxBaskets(CollectBranches()),
+   fNBaskets(0),
    fBasketBranchNum(new UInt_t[fMaxBaskets]),
    fBasketNum(new UInt_t[fMaxBaskets]),
    fBasketSeek(new Long64_t[fMaxBaskets]),
@@ -120,6 +121,9 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t option
    fPidOffset(0),
    fCloneMethod(TTreeCloner::kDefault),
    fToStartEntries(0),
+   fFirstEntry(0),
+   fLastEntry(-1),
+   fRangeSetupDone(kFALSE),
    fCacheSize(0LL),
    fFileCache(nullptr),
    fPrevCache(nullptr)
@@ -211,6 +215,90 @@ Bool_t TTreeCloner::Exec()
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Execute the cloning of the entries [first, last) of the input tree,
+/// appending them to the output tree.
+///
+/// This is used to copy the fully selected clusters of a skim without
+/// unzipping them; it requires that the baskets of every branch start at
+/// 'first' and end at 'last' (see IsRangeCloneable), which is the case for
+/// the cluster boundaries of trees written with kOnlyFlushAtCluster or with
+/// the default auto-flush settings. The method can be called several times,
+/// for increasing ranges, on the same TTreeCloner object.
+///
+/// Returns kFALSE if the range can not be copied as is; in that case
+/// neither tree was modified and the entries must be copied by unzipping them.
+
+Bool_t TTreeCloner::ExecRange(Long64_t first, Long64_t last)
+{
+   if (!IsValid() || !IsRangeCloneable(first, last)) {
+      return kFALSE;
+   }
+   CreateCache();
+   if (!fRangeSetupDone) {
+      CopyStreamerInfos();
+      CopyProcessIds();
+      fRangeSetupDone = kTRUE;
+   }
+   fFirstEntry = first;
+   fLastEntry = last;
+   fToStartEntries = fToTree->GetEntries();
+   CloseOutWriteBaskets();
+   ImportClusterRange();
+   CollectBaskets();
+   SortBaskets();
+   WriteBaskets();
+   for (Int_t i = 0; i < fToBranches.GetEntries(); ++i) {
+      TBranch *from = (TBranch *)fFromBranches.UncheckedAt(i);
+      TBranch *to = (TBranch *)fToBranches.UncheckedAt(i);
+      to->AddLastBasket(fToStartEntries + last - first);
+      // Non-terminal 'object' branches have no baskets but still count entries.
+      if (from->GetEntries() != 0 && from->GetWriteBasket() == 0) {
+         to->SetEntries(to->GetEntries() + last - first);
+      }
+   }
+   // Give back the cache, the entries in between ranges are read the usual way.
+   RestoreCache();
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the entries [first, last) of the input tree are stored in
+/// a set of complete, on-file baskets for every branch, i.e. if they can be
+/// copied by ExecRange without unzipping any basket.
+
+Bool_t TTreeCloner::IsRangeCloneable(Long64_t first, Long64_t last) const
+{
+   if (first < 0 || last <= first) {
+      return kFALSE;
+   }
+   for (Int_t i = 0; i < fFromBranches.GetEntries(); ++i) {
+      TBranch *from = (TBranch *)fFromBranches.UncheckedAt(i);
+      Int_t nbaskets = from->GetWriteBasket();
+      if (nbaskets == 0) {
+         // Non-terminal 'object' branches have no (or only empty) baskets,
+         // any other branch has its data in memory.
+         TBasket *basket = from->GetListOfBaskets()->GetEntries() ? from->GetBasket(0) : nullptr;
+         if (!basket || basket->GetNevBuf() == 0) {
+            continue;
+         }
+         return kFALSE;
+      }
+      // fBasketEntry[nbaskets] is the first entry of the (in memory) write basket.
+      const Long64_t *entries = from->GetBasketEntry();
+      const Long64_t *end = entries + nbaskets + 1;
+      const Long64_t *lo = std::lower_bound(entries, end, first);
+      if (lo == end || *lo != first) {
+         return kFALSE;
+      }
+      const Long64_t *hi = std::lower_bound(lo, end, last);
+      if (hi == end || *hi != last) {
+         return kFALSE;
+      }
+   }
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TTreeCloner destructor
 
@@ -420,17 +508,27 @@ void TTreeCloner::CollectBaskets()
 {
    UInt_t len = fFromBranches.GetEntries();
 
-   for(UInt_t i=0,bi=0; i<len; ++i) {
+   UInt_t bi = 0;
+   for(UInt_t i=0; i<len; ++i) {
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt(i);
-      for(Int_t b=0; b<from->GetWriteBasket(); ++b,++bi) {
+      for(Int_t b=0; b<from->GetWriteBasket(); ++b) {
+         if (fLastEntry >= 0) {
+            // Only the baskets of the range being copied.
+            Long64_t start = from->GetBasketEntry()[b];
+            if (start < fFirstEntry || start >= fLastEntry) {
+               continue;
+            }
+         }
          fBasketBranchNum[bi] = i;
          fBasketNum[bi] = b;
          fBasketSeek[bi] = from->GetBasketSeek(b);
          //fprintf(stderr,"For %s %d %lld\n",from->GetName(),bi,fBasketSeek[bi]);
          fBasketEntry[bi] = from->GetBasketEntry()[b];
          fBasketIndex[bi] = bi;
+         ++bi;
       }
    }
+   fNBaskets = bi;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -569,8 +667,13 @@ void TTreeCloner::CreateCache()
       fPrevCache = prev;
       // Remove the previous cache if any.
       if (prev) f->SetCacheRead(nullptr, fFromTree);
-      // The constructor attach the new cache.
-      fFileCache = new TFileCacheRead(f, fCacheSize, fFromTree);
+      if (fFileCache) {
+         // Re-attach the cache used by a previous ExecRange.
+         f->SetCacheRead(fFileCache, fFromTree);
+      } else {
+         // The constructor attach the new cache.
+         fFileCache = new TFileCacheRead(f, fCacheSize, fFromTree);
+      }
    }
 }
 
@@ -586,7 +689,7 @@ void TTreeCloner::RestoreCache() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Set the entries and import the cluster range of the
+/// Set the entries and import the cluster range of the input tree.
 
 void TTreeCloner::ImportClusterRanges()
 {
@@ -605,6 +708,22 @@ void TTreeCloner::ImportClusterRanges()
    fToTree->SetEntries(fToTree->GetEntries() + fFromTree->GetTree()->GetEntries());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the entries and record the range being copied by ExecRange as a
+/// single cluster of the output tree.
+
+void TTreeCloner::ImportClusterRange()
+{
+   TTree *to = fToTree;
+   // Close the cluster holding the entries that were filled so far.
+   if (to->fEntries && (to->fNClusterRange == 0 || to->fClusterRangeEnd[to->fNClusterRange - 1] != to->fEntries - 1)) {
+      to->MarkEventCluster();
+   }
+   to->SetEntries(to->GetEntries() + fLastEntry - fFirstEntry);
+   to->MarkEventCluster();
+   to->fClusterSize[to->fNClusterRange - 1] = fLastEntry - fFirstEntry;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the TFile cache size to be used.
 /// Note that the default is to use the same size as the default TTreeCache for
@@ -639,14 +758,14 @@ void TTreeCloner::SortBaskets()
          // nothing to do, it is already sorted.
          break;
       case kSortBasketsByEntry: {
-         for(UInt_t i = 0; i < fMaxBaskets; ++i) { fBasketIndex[i] = i; }
-         std::sort(fBasketIndex, fBasketIndex+fMaxBaskets, CompareEntry( this) );
+         for(UInt_t i = 0; i < fNBaskets; ++i) { fBasketIndex[i] = i; }
+         std::sort(fBasketIndex, fBasketIndex+fNBaskets, CompareEntry( this) );
          break;
       }
       case kSortBasketsByOffset:
       default: {
-         for(UInt_t i = 0; i < fMaxBaskets; ++i) { fBasketIndex[i] = i; }
-         std::sort(fBasketIndex, fBasketIndex+fMaxBaskets, CompareSeek( this) );
+         for(UInt_t i = 0; i < fNBaskets; ++i) { fBasketIndex[i] = i; }
+         std::sort(fBasketIndex, fBasketIndex+fNBaskets, CompareSeek( this) );
          break;
       }
    }
@@ -663,7 +782,7 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
    // Reset the cache
    fFileCache->Prefetch(0, 0);
    Long64_t size = 0;
-   for (UInt_t j = from; j < fMaxBaskets; ++j) {
+   for (UInt_t j = from; j < fNBaskets; ++j) {
       TBranch *frombr = (TBranch *) fFromBranches.UncheckedAt(fBasketBranchNum[fBasketIndex[j]]);
 
 
@@ -678,7 +797,7 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
          fFileCache->Prefetch(pos,len);
       }
    }
-   return fMaxBaskets;
+   return fNBaskets;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -687,7 +806,7 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
 void TTreeCloner::WriteBaskets()
 {
    TBasket *basket = new TBasket();
-   for(UInt_t j = 0, notCached = 0; j<fMaxBaskets; ++j) {
+   for(UInt_t j = 0, notCached = 0; j<fNBaskets; ++j) {
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
       TBranch *to   = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
 
@@ -709,13 +828,13 @@ void TTreeCloner::WriteBaskets()
          basket->LoadBasketBuffers(pos,len,fromfile,fFromTree);
          basket->IncrementPidOffset(fPidOffset);
          basket->CopyTo(tofile);
-         to->AddBasket(*basket,kTRUE,fToStartEntries + from->GetBasketEntry()[index]);
+         to->AddBasket(*basket,kTRUE,fToStartEntries - fFirstEntry + from->GetBasketEntry()[index]);
       } else {
          TBasket *frombasket = from->GetBasket( index );
          if (frombasket && frombasket->GetNevBuf()>0) {
             TBasket *tobasket = (TBasket*)frombasket->Clone();
             tobasket->SetBranch(to);
-            to->AddBasket(*tobasket, kFALSE, fToStartEntries+from->GetBasketEntry()[index]);
+            to->AddBasket(*tobasket, kFALSE, fToStartEntries - fFirstEntry + from->GetBasketEntry()[index]);
             to->FlushOneBasket(to->GetWriteBasket());
          }
       }
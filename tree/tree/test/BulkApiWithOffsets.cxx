@@ -0,0 +1,163 @@
+#include <vector>
+
+#include "SillyStruct.h"
+#include "TBranch.h"
+#include "TBufferFile.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "ROOT/TBulkBranchRead.hxx"
+
+#include "gtest/gtest.h"
+
+class BulkApiWithOffsetsTest : public ::testing::Test {
+public:
+   static constexpr Long64_t fClusterSize = 1e4;
+   static constexpr Long64_t fEventCount = 2e5;
+   const std::string fFileName = "BulkApiTestWithOffsets.root";
+
+protected:
+   virtual void SetUp()
+   {
+      auto hfile = new TFile(fFileName.c_str(), "RECREATE", "TTree variable-size bulk IO ROOT file");
+      hfile->SetCompressionLevel(0); // No compression at all.
+
+      auto tree = new TTree("T", "A ROOT tree of variable-size branches.");
+      tree->SetBit(TTree::kOnlyFlushAtCluster);
+      tree->SetAutoFlush(fClusterSize);
+
+      float f[10];
+      double d[10];
+      int myLen = 0;
+      std::vector<float> vf;
+      auto vfPtr = &vf;
+      std::vector<SillyStruct> vs;
+      auto vsPtr = &vs;
+
+      tree->Branch("myLen", &myLen, "myLen/I", 32000);
+      tree->Branch("f", &f, "f[myLen]/F", 32000);
+      tree->Branch("d", &d, "d[myLen]/D", 32000);
+      tree->Branch("vf", &vfPtr, 32000, 0);
+      tree->Branch("vs", &vsPtr, 32000, 99);
+      float f_counter = 0;
+      for (Long64_t ev = 1; ev < fEventCount + 1; ev++) {
+         myLen = ev % 10;
+         vf.clear();
+         vs.resize(myLen);
+         for (Int_t idx = 0; idx < myLen; idx++) {
+            f[idx] = f_counter;
+            d[idx] = f_counter + 1;
+            vs[idx].f = f_counter;
+            vs[idx].i = (int)f_counter;
+            vs[idx].d = f_counter + 1;
+            vf.push_back(f_counter++);
+         }
+         tree->Fill();
+      }
+      hfile = tree->GetCurrentFile();
+      hfile->Write();
+
+      delete hfile;
+   }
+};
+
+constexpr Long64_t BulkApiWithOffsetsTest::fClusterSize;
+constexpr Long64_t BulkApiWithOffsetsTest::fEventCount;
+
+TEST_F(BulkApiWithOffsetsTest, offsetsRead)
+{
+   std::unique_ptr<TFile> hfile(TFile::Open(fFileName.c_str()));
+   auto tree = dynamic_cast<TTree*>(hfile->Get("T"));
+   ASSERT_TRUE(tree);
+   auto branchFloat = tree->GetBranch("f");
+   ASSERT_TRUE(branchFloat);
+   auto branchDouble = tree->GetBranch("d");
+   ASSERT_TRUE(branchDouble);
+   auto branchVector = tree->GetBranch("vf");
+   ASSERT_TRUE(branchVector);
+
+   EXPECT_FALSE(tree->GetBranch("myLen")->GetBulkRead().SupportsBulkReadWithOffsets());
+   ASSERT_TRUE(branchFloat->GetBulkRead().SupportsBulkReadWithOffsets());
+   ASSERT_TRUE(branchDouble->GetBulkRead().SupportsBulkReadWithOffsets());
+   ASSERT_TRUE(branchVector->GetBulkRead().SupportsBulkReadWithOffsets());
+
+   TBufferFile floatBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile doubleBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile vectorBuf(TBuffer::kWrite, 32*1024);
+   std::vector<Int_t> floatOffsets, doubleOffsets, vectorOffsets;
+
+   float idx_f = 0;
+   Long64_t evt_idx = 0;
+   while (evt_idx < fEventCount) {
+      auto count = branchFloat->GetBulkRead().GetBulkEntriesWithOffsets(evt_idx, floatBuf, floatOffsets);
+      ASSERT_GT(count, 0);
+      ASSERT_EQ(count, branchDouble->GetBulkRead().GetBulkEntriesWithOffsets(evt_idx, doubleBuf, doubleOffsets));
+      ASSERT_EQ(count, branchVector->GetBulkRead().GetBulkEntriesWithOffsets(evt_idx, vectorBuf, vectorOffsets));
+      ASSERT_EQ(floatOffsets, doubleOffsets);
+      ASSERT_EQ(floatOffsets, vectorOffsets);
+
+      auto floats = reinterpret_cast<float*>(floatBuf.GetCurrent());
+      auto doubles = reinterpret_cast<double*>(doubleBuf.GetCurrent());
+      auto vectors = reinterpret_cast<float*>(vectorBuf.GetCurrent());
+      for (Int_t idx = 0; idx < count; idx++) {
+         ASSERT_EQ(floatOffsets[idx + 1] - floatOffsets[idx], (evt_idx + idx + 1) % 10);
+         for (Int_t elem = floatOffsets[idx]; elem < floatOffsets[idx + 1]; elem++) {
+            ASSERT_EQ(floats[elem], idx_f);
+            ASSERT_EQ(doubles[elem], idx_f + 1);
+            ASSERT_EQ(vectors[elem], idx_f);
+            idx_f++;
+         }
+      }
+      evt_idx += count;
+   }
+   ASSERT_EQ(evt_idx, fEventCount);
+}
+
+TEST_F(BulkApiWithOffsetsTest, splitCollectionRead)
+{
+   std::unique_ptr<TFile> hfile(TFile::Open(fFileName.c_str()));
+   auto tree = dynamic_cast<TTree*>(hfile->Get("T"));
+   ASSERT_TRUE(tree);
+   auto branchFloat = tree->GetBranch("vs.f");
+   ASSERT_TRUE(branchFloat);
+   auto branchInt = tree->GetBranch("vs.i");
+   ASSERT_TRUE(branchInt);
+   auto branchDouble = tree->GetBranch("vs.d");
+   ASSERT_TRUE(branchDouble);
+
+   // The collection itself holds no elements, its data members do.
+   EXPECT_FALSE(tree->GetBranch("vs")->GetBulkRead().SupportsBulkReadWithOffsets());
+   ASSERT_TRUE(branchFloat->GetBulkRead().SupportsBulkReadWithOffsets());
+   ASSERT_TRUE(branchInt->GetBulkRead().SupportsBulkReadWithOffsets());
+   ASSERT_TRUE(branchDouble->GetBulkRead().SupportsBulkReadWithOffsets());
+
+   TBufferFile floatBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile intBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile doubleBuf(TBuffer::kWrite, 32*1024);
+   std::vector<Int_t> floatOffsets, intOffsets, doubleOffsets;
+
+   float idx_f = 0;
+   Long64_t evt_idx = 0;
+   while (evt_idx < fEventCount) {
+      auto count = branchFloat->GetBulkRead().GetBulkEntriesWithOffsets(evt_idx, floatBuf, floatOffsets);
+      ASSERT_GT(count, 0);
+      ASSERT_EQ(count, branchInt->GetBulkRead().GetBulkEntriesWithOffsets(evt_idx, intBuf, intOffsets));
+      ASSERT_EQ(count, branchDouble->GetBulkRead().GetBulkEntriesWithOffsets(evt_idx, doubleBuf, doubleOffsets));
+      ASSERT_EQ(floatOffsets, intOffsets);
+      ASSERT_EQ(floatOffsets, doubleOffsets);
+
+      auto floats = reinterpret_cast<float*>(floatBuf.GetCurrent());
+      auto ints = reinterpret_cast<int*>(intBuf.GetCurrent());
+      auto doubles = reinterpret_cast<double*>(doubleBuf.GetCurrent());
+      for (Int_t idx = 0; idx < count; idx++) {
+         ASSERT_EQ(floatOffsets[idx + 1] - floatOffsets[idx], (evt_idx + idx + 1) % 10);
+         for (Int_t elem = floatOffsets[idx]; elem < floatOffsets[idx + 1]; elem++) {
+            ASSERT_EQ(floats[elem], idx_f);
+            ASSERT_EQ(ints[elem], (int)idx_f);
+            ASSERT_EQ(doubles[elem], idx_f + 1);
+            idx_f++;
+         }
+      }
+      evt_idx += count;
+   }
+   ASSERT_EQ(evt_idx, fEventCount);
+}
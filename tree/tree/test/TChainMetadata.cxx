@@ -0,0 +1,103 @@
+#include "TChain.h"
+#include "TChainElement.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+class TChainMetadataTest : public ::testing::Test {
+protected:
+   const std::vector<std::string> fFileNames{"TChainMetadata_0.root", "TChainMetadata_1.root",
+                                              "TChainMetadata_2.root"};
+   const std::vector<Long64_t> fEntries{100, 250, 30};
+   const std::string fMetadataFile = "TChainMetadata.txt";
+
+   virtual void SetUp()
+   {
+      for (auto i = 0u; i < fFileNames.size(); ++i) {
+         TFile f(fFileNames[i].c_str(), "RECREATE");
+         TTree t("t", "t");
+         Long64_t x = 0;
+         t.Branch("x", &x);
+         t.SetAutoFlush(40);
+         for (x = 0; x < fEntries[i]; ++x)
+            t.Fill();
+         t.Write();
+      }
+   }
+
+   virtual void TearDown()
+   {
+      for (const auto &name : fFileNames)
+         gSystem->Unlink(name.c_str());
+      gSystem->Unlink(fMetadataFile.c_str());
+   }
+};
+
+TEST_F(TChainMetadataTest, ScanMetadata)
+{
+   TChain chain("t");
+   for (const auto &name : fFileNames)
+      chain.Add(name.c_str());
+   EXPECT_EQ(chain.GetEntriesFast(), TTree::kMaxEntries);
+
+   EXPECT_EQ(chain.ScanMetadata(), 380);
+   EXPECT_EQ(chain.GetEntriesFast(), 380);
+   EXPECT_EQ(chain.GetTree(), nullptr);
+
+   auto element = static_cast<TChainElement *>(chain.GetListOfFiles()->At(1));
+   EXPECT_EQ(element->GetEntries(), 250);
+   const std::vector<Long64_t> expectedStarts{0, 40, 80, 120, 160, 200, 240};
+   EXPECT_EQ(element->GetClusterStarts(), expectedStarts);
+
+   EXPECT_EQ(chain.LoadTree(360), 10);
+   EXPECT_EQ(chain.GetTreeNumber(), 2);
+}
+
+TEST_F(TChainMetadataTest, SaveAndLoad)
+{
+   {
+      TChain chain("t");
+      for (const auto &name : fFileNames)
+         chain.Add(name.c_str());
+      EXPECT_EQ(chain.SaveMetadata(fMetadataFile.c_str()), 3);
+   }
+
+   TChain chain("t");
+   for (const auto &name : fFileNames)
+      chain.Add(name.c_str());
+   chain.Add("TChainMetadata_missing.root");
+   EXPECT_EQ(chain.LoadMetadata(fMetadataFile.c_str()), 3);
+   // The last file is not described: the total stays unknown.
+   EXPECT_EQ(chain.GetEntriesFast(), TTree::kMaxEntries);
+   EXPECT_EQ(chain.GetTreeOffset()[3], 380);
+   EXPECT_EQ(chain.GetTree(), nullptr);
+
+   // Jumping to the last described file does not need to open the others.
+   EXPECT_EQ(chain.LoadTree(105), 5);
+   EXPECT_EQ(chain.GetTreeNumber(), 1);
+
+   auto element = static_cast<TChainElement *>(chain.GetListOfFiles()->At(2));
+   const std::vector<Long64_t> expectedStarts{0};
+   EXPECT_EQ(element->GetClusterStarts(), expectedStarts);
+
+   EXPECT_EQ(chain.LoadMetadata("TChainMetadata_nonexistent.txt"), -1);
+}
+
+TEST_F(TChainMetadataTest, KnownEntriesAfterUnknown)
+{
+   TChain chain("t");
+   chain.Add(fFileNames[0].c_str());
+   chain.Add(fFileNames[1].c_str(), fEntries[1]);
+   // The offsets stay unknown after a file with an unknown number of entries.
+   EXPECT_EQ(chain.GetTreeOffset()[1], TTree::kMaxEntries);
+   EXPECT_EQ(chain.GetTreeOffset()[2], TTree::kMaxEntries);
+   EXPECT_EQ(chain.GetEntriesFast(), TTree::kMaxEntries);
+
+   EXPECT_EQ(chain.ScanMetadata(), 350);
+   EXPECT_EQ(chain.GetTreeOffset()[2], 350);
+}
@@ -0,0 +1,72 @@
+#include <set>
+#include <vector>
+
+#include "TEntryList.h"
+#include "TEntryListBlock.h"
+
+#include "gtest/gtest.h"
+
+// Entry patterns exercising the three block representations:
+// sparse (list of passing entries), dense (bits) and almost full (list of
+// non passing entries).
+static std::set<Long64_t> MakeEntries(Long64_t nentries, Long64_t step, Long64_t offset, bool invert)
+{
+   std::set<Long64_t> entries;
+   for (Long64_t entry = 0; entry < nentries; ++entry) {
+      const bool selected = (entry + offset) % step == 0;
+      if (selected != invert)
+         entries.insert(entry);
+   }
+   return entries;
+}
+
+static void FillList(TEntryList &elist, const std::set<Long64_t> &entries)
+{
+   for (auto entry : entries)
+      elist.Enter(entry);
+   elist.OptimizeStorage();
+}
+
+static void ExpectSameEntries(TEntryList &elist, const std::set<Long64_t> &entries)
+{
+   ASSERT_EQ(elist.GetN(), (Long64_t)entries.size());
+   Int_t index = 0;
+   for (auto entry : entries) {
+      ASSERT_EQ(elist.GetEntry(index++), entry);
+   }
+   // Random access, not in a loop.
+   std::vector<Long64_t> sorted(entries.begin(), entries.end());
+   for (std::size_t i = sorted.size(); i > 0; i /= 3)
+      EXPECT_EQ(elist.GetEntry(i - 1), sorted[i - 1]);
+}
+
+TEST(TEntryListSetOps, AddAndSubtract)
+{
+   const Long64_t nentries = 5 * 64000 + 123;
+   const std::vector<std::set<Long64_t>> patterns{MakeEntries(nentries, 37, 0, false), MakeEntries(nentries, 3, 1, false),
+                                                  MakeEntries(nentries, 101, 5, true), MakeEntries(nentries, 2, 0, false)};
+   for (const auto &first : patterns) {
+      for (const auto &second : patterns) {
+         TEntryList union1("union1", "");
+         TEntryList union2("union2", "");
+         FillList(union1, first);
+         FillList(union2, second);
+         union1.Add(&union2);
+         std::set<Long64_t> expected(first);
+         expected.insert(second.begin(), second.end());
+         ExpectSameEntries(union1, expected);
+
+         TEntryList difference1("difference1", "");
+         TEntryList difference2("difference2", "");
+         FillList(difference1, first);
+         FillList(difference2, second);
+         difference1.Subtract(&difference2);
+         expected = first;
+         for (auto entry : second)
+            expected.erase(entry);
+         ExpectSameEntries(difference1, expected);
+         for (Long64_t entry = 0; entry < nentries; entry += 7)
+            EXPECT_EQ(difference1.Contains(entry) != 0, expected.count(entry) != 0) << entry;
+      }
+   }
+}
@@ -0,0 +1,143 @@
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+
+#include "gtest/gtest.h"
+
+class TTreeCacheLearnFileTest : public ::testing::Test {
+protected:
+   const char *fFileName = "TTreeCacheLearnFile.root";
+   const char *fLearnFileName = "TTreeCacheLearnFile.txt";
+
+   virtual void SetUp()
+   {
+      TFile file(fFileName, "RECREATE");
+      TTree tree("T", "tree for the learn file test");
+      tree.SetAutoFlush(100);
+      Int_t a = 0, b = 0, c = 0;
+      tree.Branch("a", &a);
+      tree.Branch("b", &b);
+      tree.Branch("c", &c);
+      for (Int_t i = 0; i < 1000; ++i) {
+         a = i;
+         b = 2 * i;
+         c = 3 * i;
+         tree.Fill();
+      }
+      file.Write();
+      gSystem->Unlink(fLearnFileName);
+   }
+
+   virtual void TearDown()
+   {
+      gSystem->Unlink(fFileName);
+      gSystem->Unlink(fLearnFileName);
+   }
+};
+
+TEST_F(TTreeCacheLearnFileTest, SaveAtEndOfLearning)
+{
+   {
+      std::ofstream other(fLearnFileName);
+      other << "otherTree x\n";
+   }
+   std::unique_ptr<TFile> file(TFile::Open(fFileName));
+   auto tree = file->Get<TTree>("T");
+   ASSERT_NE(tree, nullptr);
+   tree->SetCacheSize(10000000);
+   auto cache = dynamic_cast<TTreeCache *>(file->GetCacheRead(tree));
+   ASSERT_NE(cache, nullptr);
+   cache->SetLearnFile(fLearnFileName);
+
+   tree->SetBranchStatus("*", 0);
+   tree->SetBranchStatus("a", 1);
+   tree->SetBranchStatus("b", 1);
+   for (Long64_t i = 0; i < tree->GetEntries(); ++i)
+      tree->GetEntry(i);
+   EXPECT_FALSE(cache->IsLearning());
+
+   std::ifstream in(fLearnFileName);
+   std::string header, content;
+   std::getline(in, header);
+   EXPECT_EQ(header, "otherTree x");
+   std::getline(in, header);
+   EXPECT_EQ(header.compare(0, 12, "T @branches "), 0);
+   content.assign((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+   EXPECT_EQ(content, "T a\nT b\n");
+
+   // The saved file is loaded back by the next job.
+   file.reset(TFile::Open(fFileName));
+   tree = file->Get<TTree>("T");
+   ASSERT_NE(tree, nullptr);
+   tree->SetCacheSize(10000000);
+   cache = dynamic_cast<TTreeCache *>(file->GetCacheRead(tree));
+   ASSERT_NE(cache, nullptr);
+   EXPECT_EQ(cache->LoadLearnedBranches(fLearnFileName), 2);
+   EXPECT_FALSE(cache->IsLearning());
+}
+
+TEST_F(TTreeCacheLearnFileTest, LoadSkipsLearning)
+{
+   {
+      std::ofstream learned(fLearnFileName);
+      learned << "T a\notherTree x\nT c\notherTree nonexistent\n";
+   }
+   std::unique_ptr<TFile> file(TFile::Open(fFileName));
+   auto tree = file->Get<TTree>("T");
+   ASSERT_NE(tree, nullptr);
+   tree->SetCacheSize(10000000);
+   auto cache = dynamic_cast<TTreeCache *>(file->GetCacheRead(tree));
+   ASSERT_NE(cache, nullptr);
+   ASSERT_TRUE(cache->IsLearning());
+
+   EXPECT_EQ(cache->LoadLearnedBranches(fLearnFileName), 2);
+   EXPECT_FALSE(cache->IsLearning());
+   ASSERT_EQ(cache->GetCachedBranches()->GetEntriesFast(), 2);
+   EXPECT_EQ(cache->GetCachedBranches()->At(0), tree->GetBranch("a"));
+   EXPECT_EQ(cache->GetCachedBranches()->At(1), tree->GetBranch("c"));
+
+   EXPECT_EQ(cache->LoadLearnedBranches("TTreeCacheLearnFile_missing.txt"), -1);
+}
+
+TEST_F(TTreeCacheLearnFileTest, StaleFileDisablesLearning)
+{
+   std::unique_ptr<TFile> file(TFile::Open(fFileName));
+   auto tree = file->Get<TTree>("T");
+   ASSERT_NE(tree, nullptr);
+   tree->SetCacheSize(10000000);
+   auto cache = dynamic_cast<TTreeCache *>(file->GetCacheRead(tree));
+   ASSERT_NE(cache, nullptr);
+
+   // A branch which does not exist in the tree.
+   {
+      std::ofstream learned(fLearnFileName);
+      learned << "T a\nT nonexistent\n";
+   }
+   ASSERT_TRUE(cache->IsLearning());
+   EXPECT_EQ(cache->LoadLearnedBranches(fLearnFileName), 0);
+   EXPECT_FALSE(cache->IsLearning());
+   EXPECT_EQ(cache->GetCachedBranches()->GetEntriesFast(), 0);
+
+   // A file written for a different set of branches.
+   {
+      std::ofstream learned(fLearnFileName);
+      learned << "T @branches 2 12345\nT a\n";
+   }
+   cache->StartLearningPhase();
+   ASSERT_TRUE(cache->IsLearning());
+   EXPECT_EQ(cache->LoadLearnedBranches(fLearnFileName), 0);
+   EXPECT_FALSE(cache->IsLearning());
+   EXPECT_EQ(cache->GetCachedBranches()->GetEntriesFast(), 0);
+
+   // The stale file is not overwritten.
+   for (Long64_t i = 0; i < tree->GetEntries(); ++i)
+      tree->GetEntry(i);
+   std::ifstream in(fLearnFileName);
+   std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+   EXPECT_EQ(content, "T @branches 2 12345\nT a\n");
+}
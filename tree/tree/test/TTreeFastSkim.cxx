@@ -0,0 +1,103 @@
+#include "TEntryList.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class TTreeFastSkimTest : public ::testing::Test {
+protected:
+   const std::string fInputName = "TTreeFastSkim_in.root";
+   const std::string fOutputName = "TTreeFastSkim_out.root";
+
+   virtual void SetUp()
+   {
+      TFile f(fInputName.c_str(), "RECREATE");
+      TTree t("t", "t");
+      Long64_t x = 0;
+      double y = 0.;
+      t.Branch("x", &x);
+      t.Branch("y", &y);
+      t.SetAutoFlush(100);
+      for (x = 0; x < 1000; ++x) {
+         y = 0.5 * x;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   virtual void TearDown()
+   {
+      gSystem->Unlink(fInputName.c_str());
+      gSystem->Unlink(fOutputName.c_str());
+   }
+
+   // Skim the input with the given list and return the copied values of x.
+   std::vector<Long64_t> Skim(TEntryList &elist, Option_t *option, std::vector<Long64_t> &clusterStarts)
+   {
+      std::unique_ptr<TFile> in(TFile::Open(fInputName.c_str()));
+      auto intree = in->Get<TTree>("t");
+      {
+         TFile out(fOutputName.c_str(), "RECREATE");
+         auto outtree = intree->CloneTree(0);
+         EXPECT_GT(outtree->CopyEntries(intree, elist, option), 0);
+         outtree->Write();
+      }
+      std::vector<Long64_t> values;
+      std::unique_ptr<TFile> out(TFile::Open(fOutputName.c_str()));
+      auto outtree = out->Get<TTree>("t");
+      Long64_t x = 0;
+      double y = 0.;
+      outtree->SetBranchAddress("x", &x);
+      outtree->SetBranchAddress("y", &y);
+      for (Long64_t i = 0; i < outtree->GetEntries(); ++i) {
+         outtree->GetEntry(i);
+         EXPECT_EQ(y, 0.5 * x);
+         values.push_back(x);
+      }
+      auto clusters = outtree->GetClusterIterator(0);
+      Long64_t start;
+      while ((start = clusters()) < outtree->GetEntries())
+         clusterStarts.push_back(start);
+      return values;
+   }
+};
+
+TEST_F(TTreeFastSkimTest, FullAndPartialClusters)
+{
+   // Clusters [0,300) and [600,800) fully selected, every third entry of [300,400).
+   TEntryList elist("elist", "elist");
+   std::vector<Long64_t> expected;
+   for (Long64_t i = 0; i < 1000; ++i) {
+      if (i < 300 || (i >= 300 && i < 400 && i % 3 == 0) || (i >= 600 && i < 800)) {
+         elist.Enter(i);
+         expected.push_back(i);
+      }
+   }
+
+   std::vector<Long64_t> fastClusters;
+   EXPECT_EQ(Skim(elist, "fast", fastClusters), expected);
+   std::vector<Long64_t> slowClusters;
+   EXPECT_EQ(Skim(elist, "", slowClusters), expected);
+
+   // The fully selected clusters were copied as is, and kept as separate clusters.
+   const std::vector<Long64_t> expectedFastClusters{0, 100, 200, 300, 334, 434};
+   EXPECT_EQ(fastClusters, expectedFastClusters);
+}
+
+TEST_F(TTreeFastSkimTest, PartialClustersOnly)
+{
+   // No cluster is fully selected, everything goes through the slow path.
+   TEntryList elist("elist", "elist");
+   std::vector<Long64_t> expected;
+   for (Long64_t i = 150; i < 260; ++i) {
+      elist.Enter(i);
+      expected.push_back(i);
+   }
+   std::vector<Long64_t> clusters;
+   EXPECT_EQ(Skim(elist, "fast", clusters), expected);
+}
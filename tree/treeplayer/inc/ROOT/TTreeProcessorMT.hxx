@@ -56,6 +56,13 @@ struct FriendInfo {
    std::vector<std::vector<std::string>> fFriendFileNames;
 };
 
+/// Number of entries and cluster boundaries of a file, as cached by a TChain (see TChain::ScanMetadata).
+/// fEntries is negative if they are not known.
+struct FileMetadata {
+   Long64_t fEntries;
+   std::vector<Long64_t> fClusterStarts;
+};
+
 class TTreeView {
 public:
    using TreeReaderEntryListPair = std::pair<std::unique_ptr<TTreeReader>, std::unique_ptr<TEntryList>>;
@@ -88,6 +95,8 @@ private:
    /// User-defined selection of entry numbers to be processed, empty if none was provided
    const TEntryList fEntryList; // const to be sure to avoid race conditions among TTreeViews
    const Internal::FriendInfo fFriendInfo;
+   /// Cached number of entries and clusters of each file, empty if none was available
+   const std::vector<Internal::FileMetadata> fFileMetadata;
 
    ROOT::TThreadedObject<ROOT::Internal::TTreeView> fTreeView; ///<! Thread-local TreeViews
 
@@ -27,6 +27,7 @@ class TTreeFormula;
 class TTreeFormulaManager;
 class TH1;
 class TEntryListArray;
+class TTreeReader;
 
 class TSelectorDraw : public TSelector {
 
@@ -60,6 +61,10 @@ protected:
    Bool_t         fCleanElist;     //  true if original Tree elist must be saved
    Bool_t         fObjEval;        //  true if fVar1 returns an object (or pointer to).
    Long64_t       fCurrentSubEntry; // Current subentry when fSelectMultiple is true. Used to fill TEntryListArray
+   TString        fVarExp;         //! Variable expression compiled by Begin
+   TString        fSelection;      //! Selection compiled by Begin
+   Bool_t         fGlobalWeight;   //! true if fWeight applies to all the trees (parallel workers)
+   Int_t          fNMergedWorkers; //! number of parallel workers merged since Begin
 
 protected:
    virtual void      ClearFormula();
@@ -75,6 +80,7 @@ public:
    virtual ~TSelectorDraw();
 
    virtual void      Begin(TTree *tree);
+   virtual Bool_t    CanProcessParallel() const;
    virtual Int_t     GetAction() const {return fAction;}
    virtual Bool_t    GetCleanElist() const {return fCleanElist;}
    virtual Int_t     GetDimension() const {return fDimension;}
@@ -83,6 +89,7 @@ public:
    Int_t             GetMultiplicity() const   {return fMultiplicity;}
    virtual Int_t     GetNfill() const {return fNfill;}
    TH1              *GetOldHistogram() const {return fOldHistogram;}
+   Int_t             GetNMergedWorkers() const {return fNMergedWorkers;}
    TTreeFormula     *GetSelect() const    {return fSelect;}
    virtual Long64_t  GetSelectedRows() const {return fSelectedRows;}
    TTree            *GetTree() const {return fTree;}
@@ -105,11 +112,14 @@ public:
    // See TSelectorDraw::GetVal
    virtual Double_t *GetV4() const   {return GetVal(3);}
    virtual Double_t *GetW() const    {return fW;}
+   virtual void      InitParallelWorker(const TSelectorDraw &master);
+   virtual void      MergeParallelWorker(TSelectorDraw &worker);
    virtual Bool_t    Notify();
    virtual Bool_t    Process(Long64_t /*entry*/) { return kFALSE; }
    virtual void      ProcessFill(Long64_t entry);
    virtual void      ProcessFillMultiple(Long64_t entry);
    virtual void      ProcessFillObject(Long64_t entry);
+   virtual Long64_t  ProcessParallelRange(TTreeReader &reader, Long64_t &end);
    virtual void      SetEstimate(Long64_t n);
    virtual UInt_t    SplitNames(const TString &varexp, std::vector<TString> &names);
    virtual void      TakeAction();
@@ -131,6 +131,13 @@ protected:
 
    RealInstanceCache fRealInstanceCache; //! Cache accelerating the GetRealInstance function
 
+   typedef Double_t (*JitFunction_t)(void * const *);
+   JitFunction_t        fJitFunction = nullptr; //! Natively compiled version of the expression (see JitCompile)
+   std::vector<void*>   fJitAddresses;          //! Addresses of the leaf values passed to fJitFunction
+   Bool_t               fJitRequested = kFALSE; //! True if JIT compilation was enabled when the formula was created
+
+   static Bool_t        fgJitCompilation;       // True if new formulas are natively compiled when possible
+
    TTreeFormula(const char *name, const char *formula, TTree *tree, const std::vector<std::string>& aliases);
    void Init(const char *name, const char *formula);
    Bool_t      BranchHasMethod(TLeaf* leaf, TBranch* branch, const char* method,const char* params, Long64_t readentry) const;
@@ -149,6 +156,7 @@ protected:
    virtual void*     GetValuePointerFromMethod(Int_t i, TLeaf *leaf) const;
    Int_t             GetRealInstance(Int_t instance, Int_t codeindex);
 
+   Double_t          EvalJitted();
    void              LoadBranches();
    Bool_t            LoadCurrentDim();
    void              ResetDimensions();
@@ -198,8 +206,10 @@ public:
    //the mutable keyword.
    //NOTE: Also modify the code in PrintValue which current goes around this limitation :(
    virtual Bool_t      IsInteger(Bool_t fast=kTRUE) const;
+           Bool_t      IsJitted() const { return fJitFunction != nullptr; }
            Bool_t      IsQuickLoad() const { return fQuickLoad; }
    virtual Bool_t      IsString() const;
+           Bool_t      JitCompile();
    virtual Bool_t      Notify() { UpdateFormulaLeaves(); return kTRUE; }
    virtual char       *PrintValue(Int_t mode=0) const;
    virtual char       *PrintValue(Int_t mode, Int_t instance, const char *decform = "9.9") const;
@@ -210,6 +220,9 @@ public:
    virtual TTree*      GetTree() const {return fTree;}
    virtual void        UpdateFormulaLeaves();
 
+   static  Bool_t      GetJitCompilation() { return fgJitCompilation; }
+   static  void        SetJitCompilation(Bool_t jit = kTRUE) { fgJitCompilation = jit; }
+
    ClassDef(TTreeFormula, 10);  //The Tree formula
 };
 
@@ -25,6 +25,8 @@
 #include "TVirtualIndex.h"
 #include "TTreeFormula.h"
 
+#include <atomic>
+
 class TTreeIndex : public TVirtualIndex {
 
 protected:
@@ -38,6 +40,7 @@ protected:
    TTreeFormula  *fMinorFormula;        //! Pointer to minor TreeFormula
    TTreeFormula  *fMajorFormulaParent;  //! Pointer to major TreeFormula in Parent tree (if any)
    TTreeFormula  *fMinorFormulaParent;  //! Pointer to minor TreeFormula in Parent tree (if any)
+   mutable std::atomic<Long64_t> fLastPos; //! Position found by the last lookup, tried first by the next one
 
 private:
    TTreeIndex(const TTreeIndex&);            // Not implemented.
@@ -28,6 +28,7 @@ A specialized TSelector for TTree::Draw.
 #include "TEnv.h"
 #include "TTree.h"
 #include "TCut.h"
+#include "TChain.h"
 #include "TEntryList.h"
 #include "TEventList.h"
 #include "TEntryListArray.h"
@@ -35,6 +36,11 @@ A specialized TSelector for TTree::Draw.
 #include "TStyle.h"
 #include "TClass.h"
 #include "TColor.h"
+#include "TList.h"
+#include "TTreeReader.h"
+#include "TMath.h"
+
+#include <mutex>
 
 ClassImp(TSelectorDraw);
 
@@ -77,6 +83,8 @@ TSelectorDraw::TSelectorDraw()
    fWeight         = 1;
    fCurrentSubEntry = -1;
    fTreeElistArray  = 0;
+   fGlobalWeight    = kFALSE;
+   fNMergedWorkers  = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -107,6 +115,7 @@ void TSelectorDraw::Begin(TTree *tree)
    ResetAbort();
    ResetBit(kCustomHistogram);
    fSelectedRows   = 0;
+   fNMergedWorkers = 0;
    fTree = tree;
    fDimension = 0;
    fAction = 0;
@@ -482,6 +491,8 @@ void TSelectorDraw::Begin(TTree *tree)
       delete[] varexp;
       return;
    }
+   fVarExp = varexp;
+   fSelection = realSelection.GetTitle();
    if (fDimension > 4 && !(optpara || optcandle || opt5d || opt.Contains("goff"))) {
       Abort("Too many variables. Use the option \"para\", \"gl5d\" or \"candle\" to display more than 4 variables.");
       delete[] varexp;
@@ -935,6 +946,35 @@ void TSelectorDraw::Begin(TTree *tree)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the entry loop started by Begin can be split among parallel
+/// workers (see InitParallelWorker) whose results are merged at the end.
+///
+/// This is the case when an existing or fixed-binning histogram or profile is
+/// filled: the output object does not depend on the order in which the entries
+/// are seen. The histograms created by Begin have a negative action, which asks
+/// TakeAction for the estimate pass; it only fills them when their axes cannot
+/// be extended. Auto-binned histograms (which need the estimate pass), graphs,
+/// polymarkers, entry lists and expressions depending on the global entry
+/// number (Entry$, Entries$) are always processed sequentially.
+
+Bool_t TSelectorDraw::CanProcessParallel() const
+{
+   const Int_t action = TMath::Abs(fAction);
+   if (action != 1 && action != 2 && action != 3 && action != 4 && action != 23)
+      return kFALSE;
+   if (fObjEval || fTreeElist || fVarExp.IsNull())
+      return kFALSE;
+   TH1 *hist = dynamic_cast<TH1*>(fObject);
+   if (!hist || hist->GetXaxis()->CanExtend() || hist->GetYaxis()->CanExtend() || hist->GetZaxis()->CanExtend())
+      return kFALSE;
+   for (const TString *expr : {&fVarExp, &fSelection}) {
+      if (expr->Contains("Entry$") || expr->Contains("Entries$"))
+         return kFALSE;
+   }
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Delete internal buffers.
 
@@ -1118,6 +1158,56 @@ void TSelectorDraw::InitArrays(Int_t newsize)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare this selector to fill, on behalf of master, a private copy of the
+/// master's histogram. The master must have been initialized by Begin and
+/// CanProcessParallel must have returned kTRUE.
+/// The entries are then processed via ProcessParallelRange and the result is
+/// collected with master.MergeParallelWorker(*this).
+
+void TSelectorDraw::InitParallelWorker(const TSelectorDraw &master)
+{
+   // The axes cannot be extended: the estimate pass is not needed
+   fAction = TMath::Abs(master.fAction);
+   fOption = master.fOption;
+   fVarExp = master.fVarExp;
+   fSelection = master.fSelection;
+   fWeight = master.fWeight;
+   // The weight of a single tree or the global weight of a chain must be applied
+   // to the chains of the workers, the weights of the trees are read from the files.
+   fGlobalWeight = master.fTree->IsA() != TChain::Class() || master.fTree->TestBit(TChain::kGlobalWeight);
+   fSelectedRows = 0;
+   fNfill = 0;
+
+   TDirectory::TContext ctxt(nullptr);
+   TH1 *hist = (TH1*)master.fObject->Clone();
+   hist->SetDirectory(nullptr);
+   hist->Reset();
+   fObject = hist;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the histogram filled by worker (see InitParallelWorker) to the one of
+/// this selector and take ownership of its selected rows.
+
+void TSelectorDraw::MergeParallelWorker(TSelectorDraw &worker)
+{
+   if (!worker.fObject)
+      return;
+   TList list;
+   list.Add(worker.fObject);
+   ((TH1*)fObject)->Merge(&list);
+   // The workers skip the estimate pass (see InitParallelWorker): flip the
+   // action as TakeAction does at the first fill, DrawSelect relies on it.
+   if (fAction < 0 && worker.fSelectedRows)
+      fAction = -fAction;
+   fSelectedRows += worker.fSelectedRows;
+   ++fNMergedWorkers;
+   delete worker.fObject;
+   worker.fObject = 0;
+   worker.fSelectedRows = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Build Index array for names in varexp.
 /// This will allocated a C style array of TString and Ints
@@ -1337,6 +1427,66 @@ void TSelectorDraw::ProcessFillObject(Long64_t /*entry*/)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram of this parallel worker (see InitParallelWorker) with the
+/// entries of the range of reader. The formulas are compiled for the tree of
+/// the reader when its first entry is loaded and updated when the reader moves
+/// to the next tree of a chain.
+/// Return the entry number, in the tree of the reader, of the first entry of
+/// the range, or -1 if the range is empty or the formulas cannot be compiled.
+/// end is set to the entry number following the last entry of the range.
+
+Long64_t TSelectorDraw::ProcessParallelRange(TTreeReader &reader, Long64_t &end)
+{
+   TTree *tree = reader.GetTree();
+   if (fGlobalWeight)
+      tree->SetWeight(fWeight, "global");
+
+   Long64_t first = -1;
+   end = -1;
+   Bool_t compiled = kFALSE;
+   Int_t treeNumber = -1;
+   while (reader.Next()) {
+      if (!compiled) {
+         // The construction of TTreeFormula goes through shared state (e.g.
+         // the list of functions and aliases), serialize it.
+         static std::mutex compileMutex;
+         std::lock_guard<std::mutex> lock(compileMutex);
+         fTree = tree;
+         if (!CompileVariables(fVarExp, fSelection)) {
+            Error("ProcessParallelRange", "Variable compilation failed: {%s,%s}", fVarExp.Data(), fSelection.Data());
+            return -1;
+         }
+         for (Int_t i = 0; i < fValSize; ++i)
+            fVarMultiple[i] = fVar[i] && fVar[i]->GetMultiplicity();
+         fSelectMultiple = fSelect && fSelect->GetMultiplicity();
+         fForceRead = fTree->TestBit(TTree::kForceRead);
+         for (Int_t i = 0; i < fDimension; ++i) {
+            if (!fVal[i] && fVar[i])
+               fVal[i] = new Double_t[(Int_t)fTree->GetEstimate()];
+         }
+         if (!fW)
+            fW = new Double_t[(Int_t)fTree->GetEstimate()];
+         compiled = kTRUE;
+         first = tree->GetReadEntry();
+      }
+      if (tree->GetTreeNumber() != treeNumber) {
+         treeNumber = tree->GetTreeNumber();
+         Notify();
+      }
+      ProcessFill(tree->GetTree()->GetReadEntry());
+      end = tree->GetReadEntry() + 1;
+   }
+   if (fNfill) {
+      TakeAction();
+      fNfill = 0;
+   }
+   // The formulas refer to the tree of the reader, which is not ours.
+   ClearFormula();
+   fTree = 0;
+   return first;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set number of entries to estimate variable limits.
 
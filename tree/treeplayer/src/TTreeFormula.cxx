@@ -18,6 +18,12 @@
 #include "TClonesArray.h"
 #include "TLeafB.h"
 #include "TLeafC.h"
+#include "TLeafD.h"
+#include "TLeafF.h"
+#include "TLeafI.h"
+#include "TLeafL.h"
+#include "TLeafO.h"
+#include "TLeafS.h"
 #include "TLeafObject.h"
 #include "TDataMember.h"
 #include "TMethodCall.h"
@@ -36,6 +42,7 @@
 #include "TString.h"
 #include "TTimeStamp.h"
 #include "TMath.h"
+#include "TVirtualMutex.h"
 
 #include "TVirtualRefProxy.h"
 #include "TTreeFormulaManager.h"
@@ -52,6 +59,8 @@
 #include <stdlib.h>
 #include <typeinfo>
 #include <algorithm>
+#include <type_traits>
+#include <unordered_map>
 
 const Int_t kMaxLen     = 1024;
 
@@ -91,10 +100,23 @@ The following method are available from the TFormLeafInfo interface:
  -  IsString()
  -  ReadValue(char *where, Int_t instance = 0) : Internal function to interpret the location 'where'
  -  Update() : react to the possible loading of a shared library.
+
+Scalar expressions of arithmetic, logical and mathematical operations on simple
+numerical leaves can be compiled to native code with cling, which is used
+instead of the op-code interpreter, in particular by TTree::Draw and TTree::Scan.
+This is enabled with:
+~~~{.cpp}
+     TTreeFormula::SetJitCompilation(kTRUE);
+~~~
+Formulas that cannot be compiled (see JitCompile) are evaluated as usual.
+The setting is taken into account when a formula is created: a formula keeps
+being compiled, or not, when the files of a chain change.
 */
 
 ClassImp(TTreeFormula);
 
+Bool_t TTreeFormula::fgJitCompilation = kFALSE;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 inline static void R__LoadBranch(TBranch* br, Long64_t entry, Bool_t quickLoad)
@@ -316,6 +338,9 @@ void TTreeFormula::Init(const char*name, const char* expression)
 
    }
 
+   fJitRequested = fgJitCompilation;
+   if (fJitRequested) JitCompile();
+
    if(savedir) savedir->cd();
 }
 
@@ -3935,6 +3960,7 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
 // Note that the redundance and structure in this code is tailored to improve
 // efficiencies.
    if (TestBit(kMissingLeaf)) return 0;
+   if (std::is_same<T, Double_t>::value && fJitFunction && instance == 0) return EvalJitted();
    if (fNoper == 1 && fNcodes > 0) {
 
       switch (fLookupType[0]) {
@@ -4403,6 +4429,217 @@ template double TTreeFormula::EvalInstance<double> (int, char const**);
 template long double TTreeFormula::EvalInstance<long double> (int, char const**);
 template long long TTreeFormula::EvalInstance<long long> (int, char const**);
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the natively compiled version of this formula for instance 0.
+
+Double_t TTreeFormula::EvalJitted()
+{
+   fNeedLoading = kFALSE;
+   fDidBooleanOptimization = kFALSE;
+   for (Int_t code = 0; code < fNcodes; ++code) {
+      TBranch *branch = (TBranch*)fBranches.UncheckedAt(code);
+      if (branch) {
+         R__LoadBranch(branch, branch->GetTree()->GetReadEntry(), fQuickLoad);
+      }
+      fJitAddresses[code] = ((TLeaf*)fLeaves.UncheckedAt(code))->GetValuePointer();
+   }
+   return fJitFunction(fJitAddresses.data());
+}
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ type of the values of a leaf usable by a natively compiled
+/// formula, or nullptr if the leaf is not a simple numerical scalar.
+
+const char *R__JitLeafType(TLeaf *leaf)
+{
+   if (!leaf || leaf->GetLeafCount() || leaf->GetLen() != 1) return nullptr;
+   TClass *cl = leaf->IsA();
+   if (cl != TLeafB::Class() && cl != TLeafS::Class() && cl != TLeafI::Class() && cl != TLeafL::Class() &&
+       cl != TLeafF::Class() && cl != TLeafD::Class() && cl != TLeafO::Class())
+      return nullptr;
+   return leaf->GetTypeName();
+}
+
+// Helpers reproducing the protections of TTreeFormula::EvalInstance.
+const char *gJitHelpers = R"CODE(
+#include "TMath.h"
+#include <cmath>
+namespace ROOT { namespace Internal { namespace TTreeFormulaJit {
+inline Double_t Div(Double_t a, Double_t b) { return b == 0 ? 0 : a / b; }
+inline Double_t Mod(Double_t a, Double_t b) { return Long64_t(a) % Long64_t(b); }
+inline Double_t Tan(Double_t a) { return TMath::Cos(a) == 0 ? 0 : TMath::Tan(a); }
+inline Double_t ACos(Double_t a) { return TMath::Abs(a) > 1 ? 0 : TMath::ACos(a); }
+inline Double_t ASin(Double_t a) { return TMath::Abs(a) > 1 ? 0 : TMath::ASin(a); }
+inline Double_t TanH(Double_t a) { return TMath::CosH(a) == 0 ? 0 : TMath::TanH(a); }
+inline Double_t ACosH(Double_t a) { return a < 1 ? 0 : TMath::ACosH(a); }
+inline Double_t ATanH(Double_t a) { return TMath::Abs(a) > 1 ? 0 : TMath::ATanH(a); }
+inline Double_t Sq(Double_t a) { return a * a; }
+inline Double_t Log(Double_t a) { return a > 0 ? TMath::Log(a) : 0; }
+inline Double_t Log10(Double_t a) { return a > 0 ? TMath::Log10(a) : 0; }
+inline Double_t Exp(Double_t a) { return a < -700 ? 0 : TMath::Exp(a > 700 ? 700 : a); }
+inline Double_t Sign(Double_t a) { return a < 0 ? -1 : 1; }
+inline Double_t Min(Double_t a, Double_t b) { return a < b ? a : b; }
+inline Double_t Max(Double_t a, Double_t b) { return a < b ? b : a; }
+inline Double_t FMod(Double_t a, Double_t b) { return std::fmod(a, b); }
+inline Double_t BitAnd(ULong64_t a, ULong64_t b) { return a & b; }
+inline Double_t BitOr(ULong64_t a, ULong64_t b) { return a | b; }
+inline Double_t LeftShift(ULong64_t a, ULong64_t b) { return a << b; }
+inline Double_t RightShift(ULong64_t a, ULong64_t b) { return a >> b; }
+}}}
+)CODE";
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate and compile (with cling) a C++ function evaluating this formula,
+/// with the addresses of the leaf values bound directly, and use it instead
+/// of the op-code interpreter of EvalInstance for instance 0.
+///
+/// This is only possible for scalar expressions made of arithmetic, logical
+/// and mathematical operations on constants and simple numerical leaves.
+/// Returns false (and keeps using the interpreter) if the formula contains
+/// anything else, for example arrays, strings, aliases, data members, method
+/// calls or special functions like `Length$`, `Sum$` or `Entry$`.
+///
+/// The compiled functions are cached and shared by all the formulas with the
+/// same expression and leaf types.  See also SetJitCompilation.
+
+Bool_t TTreeFormula::JitCompile()
+{
+   fJitFunction = nullptr;
+   if (!fTree || fNoper < 2 || fMultiplicity != 0 || fHasCast || fAxis || TestBit(kMissingLeaf) ||
+       TestBit(kIsCharacter))
+      return kFALSE;
+
+   std::vector<std::string> stack;
+   auto unary = [&stack](const char *func) {
+      if (stack.empty()) return false;
+      stack.back() = std::string(func) + "(" + stack.back() + ")";
+      return true;
+   };
+   auto binary = [&stack](const char *func, const char *op) {
+      if (stack.size() < 2) return false;
+      std::string rhs = stack.back();
+      stack.pop_back();
+      if (func) stack.back() = std::string(func) + "(" + stack.back() + "," + rhs + ")";
+      else stack.back() = "Double_t(" + stack.back() + op + rhs + ")";
+      return true;
+   };
+
+   for (Int_t i = 0; i < fNoper; ++i) {
+      const Int_t oper = GetOper()[i];
+      const Int_t action = oper >> kTFOperShift;
+      const Int_t param = oper & kTFOperMask;
+      Bool_t ok = kTRUE;
+      switch (action) {
+         case kEnd: i = fNoper; break;
+         case kBoolOptimize: break; // Short-circuiting is done by the compiled && and ||.
+         case kConstant: {
+            if (!TMath::Finite(fConst[param])) return kFALSE;
+            stack.push_back(TString::Format("Double_t(%.17g)", fConst[param]).Data());
+            break;
+         }
+         case kDefinedVariable: {
+            if (param >= fNcodes || fLookupType[param] != kDirect || fCodes[param] < 0 || fNdimensions[param] != 0)
+               return kFALSE;
+            const char *type = R__JitLeafType((TLeaf*)fLeaves.UncheckedAt(param));
+            if (!type) return kFALSE;
+            stack.push_back(TString::Format("Double_t(*(const %s*)addr[%d])", type, param).Data());
+            break;
+         }
+         case kpi: stack.push_back("TMath::ACos(-1)"); break;
+         case kAdd:         ok = binary(nullptr, "+"); break;
+         case kSubstract:   ok = binary(nullptr, "-"); break;
+         case kMultiply:    ok = binary(nullptr, "*"); break;
+         case kDivide:      ok = binary("Div", nullptr); break;
+         case kModulo:      ok = binary("Mod", nullptr); break;
+         case katan2:       ok = binary("TMath::ATan2", nullptr); break;
+         case kfmod:        ok = binary("FMod", nullptr); break;
+         case kpow:         ok = binary("TMath::Power", nullptr); break;
+         case kmin:         ok = binary("Min", nullptr); break;
+         case kmax:         ok = binary("Max", nullptr); break;
+         case kAnd:         ok = binary(nullptr, "!=0&&0!="); break;
+         case kOr:          ok = binary(nullptr, "!=0||0!="); break;
+         case kEqual:       ok = binary(nullptr, "=="); break;
+         case kNotEqual:    ok = binary(nullptr, "!="); break;
+         case kLess:        ok = binary(nullptr, "<"); break;
+         case kGreater:     ok = binary(nullptr, ">"); break;
+         case kLessThan:    ok = binary(nullptr, "<="); break;
+         case kGreaterThan: ok = binary(nullptr, ">="); break;
+         case kBitAnd:      ok = binary("BitAnd", nullptr); break;
+         case kBitOr:       ok = binary("BitOr", nullptr); break;
+         case kLeftShift:   ok = binary("LeftShift", nullptr); break;
+         case kRightShift:  ok = binary("RightShift", nullptr); break;
+         case kcos:    ok = unary("TMath::Cos"); break;
+         case ksin:    ok = unary("TMath::Sin"); break;
+         case ktan:    ok = unary("Tan"); break;
+         case kacos:   ok = unary("ACos"); break;
+         case kasin:   ok = unary("ASin"); break;
+         case katan:   ok = unary("TMath::ATan"); break;
+         case kcosh:   ok = unary("TMath::CosH"); break;
+         case ksinh:   ok = unary("TMath::SinH"); break;
+         case ktanh:   ok = unary("TanH"); break;
+         case kacosh:  ok = unary("ACosH"); break;
+         case kasinh:  ok = unary("TMath::ASinH"); break;
+         case katanh:  ok = unary("ATanH"); break;
+         case ksq:     ok = unary("Sq"); break;
+         case ksqrt:   ok = unary("TMath::Sqrt(TMath::Abs"); if (ok) stack.back() += ")"; break;
+         case klog:    ok = unary("Log"); break;
+         case kexp:    ok = unary("Exp"); break;
+         case klog10:  ok = unary("Log10"); break;
+         case kabs:    ok = unary("TMath::Abs"); break;
+         case ksign:   ok = unary("Sign"); break;
+         case kint:    ok = unary("Double_t(Long64_t"); if (ok) stack.back() += ")"; break;
+         case kSignInv: ok = unary("-"); break;
+         case kNot:    ok = unary("Double_t(0==");  if (ok) stack.back() += ")"; break;
+         default: return kFALSE;
+      }
+      if (!ok) return kFALSE;
+   }
+   if (stack.size() != 1) return kFALSE;
+
+   std::string body = "(void * const *addr) {\n"
+                      "   using namespace ROOT::Internal::TTreeFormulaJit;\n"
+                      "   return " + stack.back() + ";\n}\n";
+
+   static std::unordered_map<std::string, JitFunction_t> gJitFunctions;
+   {
+      R__LOCKGUARD(gROOTMutex);
+      auto funcit = gJitFunctions.find(body);
+      if (funcit != gJitFunctions.end()) {
+         fJitFunction = funcit->second;
+      }
+   }
+
+   if (!fJitFunction) {
+      // to be sure the interpreter is initialized
+      ROOT::GetROOT();
+      R__ASSERT(gInterpreter);
+
+      static Bool_t helpersDeclared = gInterpreter->Declare(gJitHelpers);
+      if (!helpersDeclared) return kFALSE;
+
+      std::string name = TString::Format("R__TTreeFormulaJit_%zu", std::hash<std::string>()(body)).Data();
+      if (!gInterpreter->Declare(("Double_t " + name + body).c_str())) {
+         Warning("JitCompile", "Could not compile %s, using the interpreted version.", GetTitle());
+         return kFALSE;
+      }
+      TInterpreter::EErrorCode errorCode;
+      fJitFunction = (JitFunction_t)gInterpreter->Calc(("(long)&" + name).c_str(), &errorCode);
+      if (errorCode != TInterpreter::kNoError) {
+         fJitFunction = nullptr;
+         return kFALSE;
+      }
+      R__LOCKGUARD(gROOTMutex);
+      gJitFunctions.insert(std::make_pair(body, fJitFunction));
+   }
+
+   fJitAddresses.resize(fNcodes);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return DataMember corresponding to code.
 ///
@@ -5135,6 +5372,8 @@ void TTreeFormula::UpdateFormulaLeaves()
             break;
       }
    }
+   // The type of the leaves may differ in the new tree.
+   if (fJitRequested) JitCompile();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
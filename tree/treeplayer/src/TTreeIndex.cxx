@@ -11,33 +11,217 @@
 
 /** \class TTreeIndex
 A Tree Index with majorname and minorname.
+
+When the major and minor names are simple numerical branches of a TTree, their
+values are read with the bulk IO interface instead of being evaluated entry by
+entry with a TTreeFormula. The (major, minor) pairs are sorted with a radix sort,
+which runs in parallel when implicit multi-threading is enabled.
 */
 
 #include "TTreeIndex.h"
+#include "TBranch.h"
+#include "TBufferFile.h"
+#include "TLeaf.h"
+#include "TROOT.h"
 #include "TTree.h"
 #include "TMath.h"
+#include "ROOT/TBulkBranchRead.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TParallelAlgorithms.hxx"
+#endif
 
 ClassImp(TTreeIndex);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert count values of type T stored in buf to Long64_t, as the
+/// TTreeFormula evaluation of an index expression does.
+
+template <typename T>
+void ConvertIndexValues(const char *buf, Long64_t *values, Int_t count)
+{
+   T value;
+   for (Int_t i = 0; i < count; ++i) {
+      memcpy(&value, buf + i * sizeof(T), sizeof(T));
+      values[i] = (Long64_t)(LongDouble_t)value;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill values with the value of the index expression name for each of the n
+/// entries of tree, when name is an integer constant or the name of a branch
+/// of tree holding a single number per entry, readable with the bulk IO
+/// interface. Return false if the expression has to be evaluated by a
+/// TTreeFormula instead.
+
+bool ReadIndexValuesBulk(TTree *tree, const TString &name, Long64_t *values, Long64_t n)
+{
+   if (name.IsDec()) {
+      const Long64_t value = name.Atoll();
+      std::fill(values, values + n, value);
+      return true;
+   }
+   if (tree->IsA() != TTree::Class())
+      return false;
+   TBranch *branch = tree->GetBranch(name);
+   // The branch must belong to this tree (and not to one of its friends) and hold a single number
+   if (!branch || branch->GetTree() != tree || branch->GetListOfBranches()->GetEntriesFast() ||
+       branch->GetNleaves() != 1 || !branch->GetBulkRead().SupportsBulkRead())
+      return false;
+   TLeaf *leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+   if (leaf->GetLeafCount() || leaf->GetLenStatic() != 1 || branch->GetEntries() < n)
+      return false;
+
+   void (*convert)(const char *, Long64_t *, Int_t) = nullptr;
+   const char *type = leaf->GetTypeName();
+   if (!strcmp(type, "Int_t")) convert = ConvertIndexValues<Int_t>;
+   else if (!strcmp(type, "UInt_t")) convert = ConvertIndexValues<UInt_t>;
+   else if (!strcmp(type, "Long64_t")) convert = ConvertIndexValues<Long64_t>;
+   else if (!strcmp(type, "ULong64_t")) convert = ConvertIndexValues<ULong64_t>;
+   else if (!strcmp(type, "Short_t")) convert = ConvertIndexValues<Short_t>;
+   else if (!strcmp(type, "UShort_t")) convert = ConvertIndexValues<UShort_t>;
+   else if (!strcmp(type, "Char_t")) convert = ConvertIndexValues<Char_t>;
+   else if (!strcmp(type, "UChar_t")) convert = ConvertIndexValues<UChar_t>;
+   else if (!strcmp(type, "Float_t")) convert = ConvertIndexValues<Float_t>;
+   else if (!strcmp(type, "Double_t")) convert = ConvertIndexValues<Double_t>;
+   else
+      return false;
+
+   TBufferFile buf(TBuffer::kWrite, 32 * 1024);
+   Long64_t entry = 0;
+   while (entry < n) {
+      Int_t count = branch->GetBulkRead().GetBulkEntries(entry, buf);
+      if (count <= 0)
+         return false;
+      if (count > n - entry)
+         count = n - entry;
+      convert(buf.GetCurrent(), values + entry, count);
+      entry += count;
+   }
+   return true;
+}
 
-struct IndexSortComparator {
+////////////////////////////////////////////////////////////////////////////////
+/// Sort the n triplets (major[i], minor[i], index[i]) by increasing major and
+/// minor with a stable LSD radix sort on the bytes of the two signed 64 bit
+/// keys. Bytes which are the same for all keys are skipped, so that small
+/// (e.g. run and event) numbers only need a few passes. Each pass is done in
+/// parallel over chunks of the arrays when implicit multi-threading is enabled.
+/// The arrays must have been allocated with new[]; they may be swapped with
+/// the scratch arrays used by the sort.
+
+void RadixSortIndex(Long64_t *&major, Long64_t *&minor, Long64_t *&index, Long64_t n)
+{
+   if (n < 2)
+      return;
+   const ULong64_t kSignBit = 1ULL << 63;
+   const UInt_t kNDigits = 16; // 8 bytes of minor, then 8 bytes of major
+
+   UInt_t nChunks = 1;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && n >= (1 << 16))
+      nChunks = 4 * ROOT::GetImplicitMTPoolSize();
+#endif
+   const Long64_t chunkSize = (n + nChunks - 1) / nChunks;
+   nChunks = (n + chunkSize - 1) / chunkSize;
+
+   auto forEachChunk = [nChunks](const std::function<void(UInt_t)> &func) {
+#ifdef R__USE_IMT
+      if (nChunks > 1) {
+         ROOT::Parallel::For(0, nChunks, func);
+         return;
+      }
+#endif
+      for (UInt_t chunk = 0; chunk < nChunks; ++chunk)
+         func(chunk);
+   };
+   auto digitOf = [kSignBit](const Long64_t *major, const Long64_t *minor, Long64_t i, UInt_t digit) -> UInt_t {
+      const ULong64_t key = (ULong64_t)(digit < 8 ? minor[i] : major[i]) ^ kSignBit;
+      return (key >> (8 * (digit % 8))) & 0xff;
+   };
+
+   // Find the digits which need sorting: those whose bytes are not all equal
+   std::vector<ULong64_t> orMask(nChunks, 0), andMask(nChunks, ~0ULL), orMaskMinor(nChunks, 0),
+      andMaskMinor(nChunks, ~0ULL);
+   forEachChunk([&](UInt_t chunk) {
+      const Long64_t begin = chunk * chunkSize, end = std::min(n, begin + chunkSize);
+      for (Long64_t i = begin; i < end; ++i) {
+         orMask[chunk] |= major[i];
+         andMask[chunk] &= major[i];
+         orMaskMinor[chunk] |= minor[i];
+         andMaskMinor[chunk] &= minor[i];
+      }
+   });
+   ULong64_t variesMajor = 0, variesMinor = 0;
+   {
+      ULong64_t orAll = 0, andAll = ~0ULL, orAllMinor = 0, andAllMinor = ~0ULL;
+      for (UInt_t chunk = 0; chunk < nChunks; ++chunk) {
+         orAll |= orMask[chunk];
+         andAll &= andMask[chunk];
+         orAllMinor |= orMaskMinor[chunk];
+         andAllMinor &= andMaskMinor[chunk];
+      }
+      variesMajor = orAll ^ andAll;
+      variesMinor = orAllMinor ^ andAllMinor;
+   }
 
-  IndexSortComparator(Long64_t *major, Long64_t *minor)
-        : fValMajor(major), fValMinor(minor)
-  {}
+   Long64_t *tmpMajor = nullptr, *tmpMinor = nullptr, *tmpIndex = nullptr;
+   std::vector<Long64_t> counts(nChunks * 256);
+   for (UInt_t digit = 0; digit < kNDigits; ++digit) {
+      const ULong64_t varies = digit < 8 ? variesMinor : variesMajor;
+      if (!((varies >> (8 * (digit % 8))) & 0xff))
+         continue;
+      if (!tmpMajor) {
+         tmpMajor = new Long64_t[n];
+         tmpMinor = new Long64_t[n];
+         tmpIndex = new Long64_t[n];
+      }
 
-   template<typename Index>
-   bool operator()(Index i1, Index i2) {
-      if( *(fValMajor + i1) == *(fValMajor + i2) )
-         return *(fValMinor + i1) < *(fValMinor + i2);
-      else
-         return *(fValMajor + i1) < *(fValMajor + i2);
+      // Histogram of the digit in each chunk
+      std::fill(counts.begin(), counts.end(), 0);
+      forEachChunk([&](UInt_t chunk) {
+         Long64_t *count = &counts[chunk * 256];
+         const Long64_t begin = chunk * chunkSize, end = std::min(n, begin + chunkSize);
+         for (Long64_t i = begin; i < end; ++i)
+            ++count[digitOf(major, minor, i, digit)];
+      });
+      // Turn the counts into the position of the first element of each bucket of each chunk
+      Long64_t offset = 0;
+      for (UInt_t bucket = 0; bucket < 256; ++bucket) {
+         for (UInt_t chunk = 0; chunk < nChunks; ++chunk) {
+            const Long64_t count = counts[chunk * 256 + bucket];
+            counts[chunk * 256 + bucket] = offset;
+            offset += count;
+         }
+      }
+      // Stable scatter
+      forEachChunk([&](UInt_t chunk) {
+         Long64_t *position = &counts[chunk * 256];
+         const Long64_t begin = chunk * chunkSize, end = std::min(n, begin + chunkSize);
+         for (Long64_t i = begin; i < end; ++i) {
+            const Long64_t pos = position[digitOf(major, minor, i, digit)]++;
+            tmpMajor[pos] = major[i];
+            tmpMinor[pos] = minor[i];
+            tmpIndex[pos] = index[i];
+         }
+      });
+      std::swap(major, tmpMajor);
+      std::swap(minor, tmpMinor);
+      std::swap(index, tmpIndex);
    }
+   delete[] tmpMajor;
+   delete[] tmpMinor;
+   delete[] tmpIndex;
+}
 
-  // pointers to the start of index values tables keeping uppder 64bit and lower 64bit
-  // of combined indexed 128bit value
-  Long64_t *fValMajor, *fValMinor;
-};
+} // anonymous namespace
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -54,6 +238,7 @@ TTreeIndex::TTreeIndex(): TVirtualIndex()
    fMinorFormula       = 0;
    fMajorFormulaParent = 0;
    fMinorFormulaParent = 0;
+   fLastPos            = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -132,6 +317,7 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    fMinorFormula       = 0;
    fMajorFormulaParent = 0;
    fMinorFormulaParent = 0;
+   fLastPos            = 0;
    fMajorName          = majorname;
    fMinorName          = minorname;
    if (!T) return;
@@ -165,31 +351,28 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    Long64_t *tmp_minor = new Long64_t[fN];
    Long64_t i;
    Long64_t oldEntry = fTree->GetReadEntry();
-   Int_t current = -1;
-   for (i=0;i<fN;i++) {
-      Long64_t centry = fTree->LoadTree(i);
-      if (centry < 0) break;
-      if (fTree->GetTreeNumber() != current) {
-         current = fTree->GetTreeNumber();
-         fMajorFormula->UpdateFormulaLeaves();
-         fMinorFormula->UpdateFormulaLeaves();
+   // Read simple branches in bulk, evaluate the formula of other expressions for each entry
+   const Bool_t majorRead = ReadIndexValuesBulk(fTree, fMajorName, tmp_major, fN);
+   const Bool_t minorRead = ReadIndexValuesBulk(fTree, fMinorName, tmp_minor, fN);
+   if (!majorRead || !minorRead) {
+      Int_t current = -1;
+      for (i=0;i<fN;i++) {
+         Long64_t centry = fTree->LoadTree(i);
+         if (centry < 0) break;
+         if (fTree->GetTreeNumber() != current) {
+            current = fTree->GetTreeNumber();
+            fMajorFormula->UpdateFormulaLeaves();
+            fMinorFormula->UpdateFormulaLeaves();
+         }
+         if (!majorRead) tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+         if (!minorRead) tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
       }
-      tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
-      tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
    }
    fIndex = new Long64_t[fN];
    for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
-   //TMath::Sort(fN,w,fIndex,0);
-   fIndexValues = new Long64_t[fN];
-   fIndexValuesMinor = new Long64_t[fN];
-   for (i=0;i<fN;i++) {
-      fIndexValues[i] = tmp_major[fIndex[i]];
-      fIndexValuesMinor[i] = tmp_minor[fIndex[i]];
-   }
-
-   delete [] tmp_major;
-   delete [] tmp_minor;
+   RadixSortIndex(tmp_major, tmp_minor, fIndex, fN);
+   fIndexValues = tmp_major;
+   fIndexValuesMinor = tmp_minor;
    fTree->LoadTree(oldEntry);
 }
 
@@ -262,29 +445,9 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
 
    // Sort.
    if (!delaySort) {
-      Long64_t *addValues = GetIndexValues();
-      Long64_t *addValues2 = GetIndexValuesMinor();
-      Long64_t *ind = fIndex;
-      Long64_t *conv = new Long64_t[fN];
-
-      for(Long64_t i = 0; i < fN; i++) { conv[i] = i; }
-      std::sort(conv, conv+fN, IndexSortComparator(addValues, addValues2) );
-      //Long64_t *w = fIndexValues;
-      //TMath::Sort(fN,w,conv,0);
-
-      fIndex = new Long64_t[fN];
-      fIndexValues = new Long64_t[fN];
-      fIndexValuesMinor = new Long64_t[fN];
-
-      for (Int_t i=0;i<fN;i++) {
-         fIndex[i] = ind[conv[i]];
-         fIndexValues[i] = addValues[conv[i]];
-         fIndexValuesMinor[i] = addValues2[conv[i]];
-      }
-      delete [] addValues;
-      delete [] addValues2;
-      delete [] ind;
-      delete [] conv;
+      if (!fIndexValuesMinor) ConvertOldToNew();
+      RadixSortIndex(fIndexValues, fIndexValuesMinor, fIndex, fN);
+      fLastPos = 0;
    }
 }
 
@@ -350,9 +513,24 @@ Long64_t TTreeIndex::GetEntryNumberFriend(const TTree *parent)
 /// find position where major|minor values are in the IndexValues tables
 /// this is the index in IndexValues table, not entry# !
 /// use lower_bound STD algorithm.
+///
+/// The position found by the previous call and the next one are checked
+/// first: consecutive lookups of increasing values, as done when reading a
+/// friend tree sorted like its parent, then do not need a binary search.
 
 Long64_t TTreeIndex::FindValues(Long64_t major, Long64_t minor) const
 {
+   auto isLess = [this, major, minor](Long64_t i) {
+      return fIndexValues[i] < major || (fIndexValues[i] == major && fIndexValuesMinor[i] < minor);
+   };
+   const Long64_t last = fLastPos.load(std::memory_order_relaxed);
+   for (Long64_t hint = last; hint <= last + 1 && hint < fN; ++hint) {
+      if (!isLess(hint) && (hint == 0 || isLess(hint - 1))) {
+         if (hint != last) fLastPos.store(hint, std::memory_order_relaxed);
+         return hint;
+      }
+   }
+
    Long64_t mid, step, pos = 0, count = fN;
    // find lower bound using bisection
    while( count > 0 ) {
@@ -366,6 +544,7 @@ Long64_t TTreeIndex::FindValues(Long64_t major, Long64_t minor) const
       } else
          count = step;
    }
+   fLastPos.store(pos, std::memory_order_relaxed);
    return pos;
 }
 
@@ -560,6 +739,7 @@ void TTreeIndex::Streamer(TBuffer &R__b)
       }
       fIndex      = new Long64_t[fN];
       R__b.ReadFastArray(fIndex,fN);
+      fLastPos = 0;
       R__b.CheckByteCount(R__s, R__c, TTreeIndex::IsA());
    } else {
       R__c = R__b.WriteVersion(TTreeIndex::IsA(), kTRUE);
@@ -77,6 +77,15 @@ extra libraries (Histogram, display, etc).
 #include "TTreeCache.h"
 #include "TStyle.h"
 #include "TVirtualMutex.h"
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#endif
 
 #include "HFitInterface.h"
 #include "Foption.h"
@@ -2244,6 +2253,8 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
 
    Bool_t process = (selector->GetAbort() != TSelector::kAbortProcess &&
                     (selector->Version() != 0 || selector->GetStatus() != -1)) ? kTRUE : kFALSE;
+   if (process && selector == fSelector && ProcessDrawMT(firstentry, nentries))
+      process = kFALSE; // all the entries have already been processed
    if (process) {
 
       Long64_t readbytesatstart = 0;
@@ -2334,6 +2345,122 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
    return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Run the entry loop of TTree::Draw in parallel if implicit multi-threading is
+/// enabled (see ROOT::EnableImplicitMT) and fSelector fills a histogram with a
+/// fixed binning (see TSelectorDraw::CanProcessParallel).
+///
+/// The clusters of the tree are processed with ROOT::TTreeProcessorMT: each
+/// range of entries is processed with its own TTreeFormula instances and fills
+/// its own copy of the histogram; the copies are merged into the histogram of
+/// fSelector in the order of the entries, as soon as the ranges before them
+/// are done.
+///
+/// Return kFALSE, without processing any entry, if the loop must instead be
+/// run sequentially: the threads read the tree from its files, hence the whole
+/// tree must be processed, all its entries must be on disk and no setting
+/// only kept in memory (entry list, aliases, ...) may affect the result.
+
+Bool_t TTreePlayer::ProcessDrawMT(Long64_t firstentry, Long64_t nentries)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || !fSelector->CanProcessParallel())
+      return kFALSE;
+   if (firstentry != 0 || nentries != fTree->GetEntries() || fTree->GetEntryList() || fTree->GetEventList() ||
+       fTree->GetUpdate() || (fTree->GetListOfAliases() && fTree->GetListOfAliases()->GetEntries()))
+      return kFALSE;
+   if (fTree->IsA() != TChain::Class()) {
+      TFile *file = fTree->GetCurrentFile();
+      if (fTree->InheritsFrom(TChain::Class()) || !file || file->IsWritable())
+         return kFALSE;
+   }
+
+   std::unique_ptr<ROOT::TTreeProcessorMT> processor;
+   try {
+      processor.reset(new ROOT::TTreeProcessorMT(*fTree));
+   } catch (const std::exception &) {
+      // e.g. friend trees which are not in a file.
+      return kFALSE;
+   }
+
+   // The threads read either one file, with local entry numbers, or all of
+   // them, with global ones: identify the file by its index in the chain.
+   // The same file may be in a chain twice: its ranges are then the same.
+   using RangeKey_t = std::tuple<Int_t, std::string, Long64_t>;
+   std::map<std::string, Int_t> fileIndex;
+   // The files in the order of the entries, with their number of entries.
+   std::vector<std::pair<RangeKey_t, Long64_t>> files;
+   if (fTree->IsA() == TChain::Class()) {
+      auto chain = static_cast<TChain *>(fTree);
+      TIter nextfile(chain->GetListOfFiles());
+      Int_t ifile = 0;
+      while (TObject *element = nextfile()) {
+         auto found = fileIndex.emplace(element->GetTitle(), fileIndex.size()).first;
+         const Long64_t entries = chain->GetTreeOffset()[ifile + 1] - chain->GetTreeOffset()[ifile];
+         files.emplace_back(RangeKey_t(found->second, found->first, 0), entries);
+         ++ifile;
+      }
+   } else {
+      fileIndex.emplace(fTree->GetCurrentFile()->GetName(), 0);
+      files.emplace_back(RangeKey_t(0, fTree->GetCurrentFile()->GetName(), 0), fTree->GetEntries());
+   }
+
+   // Each range of entries fills its own copy of the histogram. The copies are
+   // merged in the order of the entries, so that the result does not depend
+   // on the scheduling of the ranges: a range is merged as soon as it and all
+   // the ranges before it are done, the others wait in pending with the
+   // entry following their last one. Whatever does not fit this order (e.g.
+   // ranges spanning several files) is merged at the end, in the key order.
+   std::mutex resultsMutex;
+   std::multimap<RangeKey_t, std::pair<Long64_t, std::unique_ptr<TSelectorDraw>>> pending;
+   std::size_t nextFile = 0;
+   Long64_t nextEntry = 0;
+   processor->Process([&](TTreeReader &reader) {
+      std::unique_ptr<TSelectorDraw> worker(new TSelectorDraw());
+      worker->InitParallelWorker(*fSelector);
+      Long64_t end;
+      const Long64_t first = worker->ProcessParallelRange(reader, end);
+      if (first < 0)
+         return;
+      std::string fileName;
+      Int_t index = -1;
+      if (auto chain = dynamic_cast<TChain *>(reader.GetTree())) {
+         TObjArray *chainFiles = chain->GetListOfFiles();
+         if (chainFiles->GetEntries() == 1) {
+            fileName = chainFiles->At(0)->GetTitle();
+            auto found = fileIndex.find(fileName);
+            if (found != fileIndex.end())
+               index = found->second;
+         }
+      }
+      std::lock_guard<std::mutex> lock(resultsMutex);
+      pending.emplace(RangeKey_t(index, fileName, first), std::make_pair(end, std::move(worker)));
+      while (nextFile < files.size()) {
+         RangeKey_t expected = files[nextFile].first;
+         std::get<2>(expected) = nextEntry;
+         auto ready = pending.find(expected);
+         if (ready == pending.end())
+            break;
+         fSelector->MergeParallelWorker(*ready->second.second);
+         nextEntry = ready->second.first;
+         pending.erase(ready);
+         if (nextEntry >= files[nextFile].second) {
+            ++nextFile;
+            nextEntry = 0;
+         }
+      }
+   });
+
+   for (auto &result : pending)
+      fSelector->MergeParallelWorker(*result.second.second);
+   return kTRUE;
+#else
+   (void)firstentry;
+   (void)nentries;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// cleanup pointers in the player pointing to obj
 
@@ -22,12 +22,22 @@ The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the
 each corresponding to a cluster in the TTree. This is possible thanks to the use
 of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
 objects.
+
+Each input file is a task which opens the file, unless its cluster boundaries are
+already known, and spawns one task per range of entries of the file. The ranges are
+made of whole clusters, fused according to the number of entries only (see
+GetMaxTasksPerFilePerWorker()). The tasks are scheduled by the thread pool: idle
+workers steal the ranges of any file, so that files of very different sizes do not
+leave workers without work at the end of the processing, and the next input files
+are opened by the workers while the ranges of the previous ones are being processed.
 */
 
 #include "TROOT.h"
+#include "TChainElement.h"
 #include "ROOT/TTreeProcessorMT.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 
+
 using namespace ROOT;
 
 namespace ROOT {
@@ -157,9 +167,13 @@ TTreeView::GetTreeReader(Long64_t start, Long64_t end, const std::string &treeNa
 
 ////////////////////////////////////////////////////////////////////////
 /// Return a vector of cluster boundaries for the given tree and files.
+/// Files for which metadata (number of entries and cluster boundaries) is
+/// available in fileMetadata are not opened. fileMetadata is either empty or
+/// has one element per file name.
 // EntryClusters and number of entries per file
 using ClustersAndEntries = std::pair<std::vector<std::vector<EntryCluster>>, std::vector<Long64_t>>;
-static ClustersAndEntries MakeClusters(const std::string &treeName, const std::vector<std::string> &fileNames)
+static ClustersAndEntries MakeClusters(const std::string &treeName, const std::vector<std::string> &fileNames,
+                                       const std::vector<FileMetadata> &fileMetadata)
 {
    // Note that as a side-effect of opening all files that are going to be used in the
    // analysis once, all necessary streamers will be loaded into memory.
@@ -169,7 +183,22 @@ static ClustersAndEntries MakeClusters(const std::string &treeName, const std::v
    std::vector<Long64_t> entriesPerFile;
    entriesPerFile.reserve(nFileNames);
    Long64_t offset = 0ll;
-   for (const auto &fileName : fileNames) {
+   for (auto fileIdx = 0u; fileIdx < nFileNames; ++fileIdx) {
+      const auto &fileName = fileNames[fileIdx];
+      if (!fileMetadata.empty() && fileMetadata[fileIdx].fEntries >= 0) {
+         // Use the cached entries and clusters, skipping the file open
+         const auto entries = fileMetadata[fileIdx].fEntries;
+         const auto &starts = fileMetadata[fileIdx].fClusterStarts;
+         std::vector<EntryCluster> clusters;
+         for (auto i = 0u; i < starts.size(); ++i) {
+            const auto end = i + 1 < starts.size() ? starts[i + 1] : entries;
+            clusters.emplace_back(EntryCluster{starts[i] + offset, end + offset});
+         }
+         offset += entries;
+         clustersPerFile.emplace_back(std::move(clusters));
+         entriesPerFile.emplace_back(entries);
+         continue;
+      }
       auto fileNameC = fileName.c_str();
       std::unique_ptr<TFile> f(TFile::Open(fileNameC)); // need TFile::Open to load plugins if need be
       if (!f || f->IsZombie()) {
@@ -417,6 +446,31 @@ TTreeProcessorMT::TTreeProcessorMT(const std::vector<std::string_view> &filename
 {
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Return the number of entries and cluster boundaries of each file of a chain,
+/// if the chain knows them for all of its files (see TChain::ScanMetadata and
+/// TChain::LoadMetadata). Return an empty vector otherwise.
+std::vector<Internal::FileMetadata> GetFileMetadataFromTree(TTree &tree)
+{
+   std::vector<Internal::FileMetadata> metadata;
+   if (tree.IsA() != TChain::Class())
+      return metadata;
+
+   const auto treeName = ROOT::Internal::GetTreeFullPath(tree);
+   TObjArray *filelist = static_cast<TChain &>(tree).GetListOfFiles();
+   metadata.reserve(filelist->GetEntries());
+   for (auto f : *filelist) {
+      const auto element = static_cast<TChainElement *>(f);
+      const auto entries = element->GetEntries();
+      const bool known = entries != TTree::kMaxEntries && element->GetLoadResult() >= 0 &&
+                         (entries == 0 || !element->GetClusterStarts().empty()) && treeName == element->GetName();
+      if (!known)
+         return std::vector<Internal::FileMetadata>();
+      metadata.emplace_back(Internal::FileMetadata{entries, element->GetClusterStarts()});
+   }
+   return metadata;
+}
+
 std::vector<std::string> GetFilesFromTree(TTree &tree)
 {
    std::vector<std::string> filenames;
@@ -449,7 +503,7 @@ std::vector<std::string> GetFilesFromTree(TTree &tree)
 /// \param[in] entries List of entry numbers to process.
 TTreeProcessorMT::TTreeProcessorMT(TTree &tree, const TEntryList &entries)
    : fFileNames(GetFilesFromTree(tree)), fTreeName(ROOT::Internal::GetTreeFullPath(tree)), fEntryList(entries),
-     fFriendInfo(GetFriendInfo(tree))
+     fFriendInfo(GetFriendInfo(tree)), fFileMetadata(GetFileMetadataFromTree(tree))
 {
 }
 
@@ -485,31 +539,51 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    const bool hasFriends = !friendNames.empty();
    const bool hasEntryList = fEntryList.GetN() > 0;
    const bool shouldRetrieveAllClusters = hasFriends || hasEntryList;
-   const auto clustersAndEntries =
-      shouldRetrieveAllClusters ? Internal::MakeClusters(fTreeName, fFileNames) : Internal::ClustersAndEntries{};
-   const auto &clusters = clustersAndEntries.first;
-   const auto &entries = clustersAndEntries.second;
+   TThreadExecutor pool;
+   const auto nFiles = fFileNames.size();
+   auto fileMetadata = [this](std::size_t fileIdx) {
+      return fFileMetadata.empty() ? std::vector<Internal::FileMetadata>()
+                                   : std::vector<Internal::FileMetadata>({fFileMetadata[fileIdx]});
+   };
+
+   // Clusters (with local entry numbers) and number of entries of each file, filled as files get opened.
+   // Each element is written by the task of the file before its ranges are processed.
+   std::vector<std::vector<Internal::EntryCluster>> clusters(nFiles);
+   std::vector<Long64_t> entries(nFiles, 0);
+   auto openFile = [&](std::size_t fileIdx) {
+      auto clustersAndEntries = Internal::MakeClusters(fTreeName, {fFileNames[fileIdx]}, fileMetadata(fileIdx));
+      clusters[fileIdx] = std::move(clustersAndEntries.first[0]);
+      entries[fileIdx] = clustersAndEntries.second[0];
+   };
+
+   // With an entry list or friend trees all files have to be known beforehand, to use global entry numbers.
+   // They are opened in parallel.
+   if (shouldRetrieveAllClusters) {
+      pool.Foreach(openFile, ROOT::TSeq<std::size_t>(nFiles));
+      Long64_t offset = 0ll;
+      for (auto fileIdx = 0u; fileIdx < nFiles; ++fileIdx) {
+         for (auto &c : clusters[fileIdx]) {
+            c.start += offset;
+            c.end += offset;
+         }
+         offset += entries[fileIdx];
+      }
+   }
 
    // Retrieve number of entries for each file for each friend tree
    const auto friendEntries =
       hasFriends ? Internal::GetFriendEntries(friendNames, friendFileNames) : std::vector<std::vector<Long64_t>>{};
 
-   TThreadExecutor pool;
-   // Parent task, spawns tasks that process each of the entry clusters for each input file
-   using Internal::EntryCluster;
+   // Parent task: opens the file if needed, then spawns the tasks processing its ranges of entries
    auto processFile = [&](std::size_t fileIdx) {
-      // theseFiles contains either all files or just the single file to process
-      const auto &theseFiles = shouldRetrieveAllClusters ? fFileNames : std::vector<std::string>({fFileNames[fileIdx]});
-      // Evaluate clusters (with local entry numbers) and number of entries for this file, if needed
-      const auto theseClustersAndEntries =
-         shouldRetrieveAllClusters ? Internal::ClustersAndEntries{} : Internal::MakeClusters(fTreeName, theseFiles);
+      if (!shouldRetrieveAllClusters)
+         openFile(fileIdx);
 
-      // All clusters for the file to process, either with global or local entry numbers
-      const auto &thisFileClusters = shouldRetrieveAllClusters ? clusters[fileIdx] : theseClustersAndEntries.first[0];
-
-      // Either all number of entries or just the ones for this file
-      const auto &theseEntries =
-         shouldRetrieveAllClusters ? entries : std::vector<Long64_t>({theseClustersAndEntries.second[0]});
+      // theseFiles contains either all files or just the single file to process, and theseEntries
+      // their number of entries
+      const auto &theseFiles =
+         shouldRetrieveAllClusters ? fFileNames : std::vector<std::string>({fFileNames[fileIdx]});
+      const auto &theseEntries = shouldRetrieveAllClusters ? entries : std::vector<Long64_t>({entries[fileIdx]});
 
       auto processCluster = [&](const Internal::EntryCluster &c) {
          std::unique_ptr<TTreeReader> reader;
@@ -519,16 +593,13 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
          func(*reader);
       };
 
-      pool.Foreach(processCluster, thisFileClusters);
+      pool.Foreach(processCluster, clusters[fileIdx]);
    };
 
-   std::vector<std::size_t> fileIdxs(fFileNames.size());
-   std::iota(fileIdxs.begin(), fileIdxs.end(), 0u);
-
    // Enable this IMT use case (activate its locks)
    Internal::TParTreeProcessingRAII ptpRAII;
 
-   pool.Foreach(processFile, fileIdxs);
+   pool.Foreach(processFile, ROOT::TSeq<std::size_t>(nFiles));
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,78 @@
+#include "ROOT/RMakeUnique.hxx"
+#include "TTree.h"
+#include "TTreeFormula.h"
+
+#include "gtest/gtest.h"
+
+std::unique_ptr<TTree> MakeJitTree()
+{
+   float f = 0.;
+   double d = 0.;
+   int i = 0;
+   Long64_t l = 0;
+   float arr[2] = {0., 0.};
+
+   auto tree = std::make_unique<TTree>("jit", "tree for natively compiled formulas");
+   tree->Branch("f", &f, "f/F");
+   tree->Branch("d", &d, "d/D");
+   tree->Branch("i", &i, "i/I");
+   tree->Branch("l", &l, "l/L");
+   tree->Branch("arr", &arr, "arr[2]/F");
+   for (int entry = 0; entry < 50; ++entry) {
+      f = 0.5f * entry - 7;
+      d = 3. - entry / 4.;
+      i = entry % 7 - 2;
+      l = entry * 1000000000LL;
+      arr[0] = entry;
+      arr[1] = -entry;
+      tree->Fill();
+   }
+   tree->ResetBranchAddresses();
+   return tree;
+}
+
+TEST(TTreeFormulaJit, SameResultAsInterpreter)
+{
+   auto tree = MakeJitTree();
+   const char *expressions[] = {"f*d+i", "sqrt(f*f+d*d)/(i+2)", "f>0 && d<0 || i==3", "!(i%3) ? 1 : 0",
+                                "TMath::Max(f,d)", "atan2(f,d)+exp(d)-log(f)", "(l>>3)&0xff",
+                                "f+arr[1]", "Sum$(arr)*f", "Entry$+f"};
+   for (auto expr : expressions) {
+      TTreeFormula interpreted("interpreted", expr, tree.get());
+      TTreeFormula::SetJitCompilation(kTRUE);
+      TTreeFormula jitted("jitted", expr, tree.get());
+      TTreeFormula::SetJitCompilation(kFALSE);
+      ASSERT_FALSE(interpreted.IsJitted());
+      for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry) {
+         tree->LoadTree(entry);
+         EXPECT_EQ(interpreted.EvalInstance(), jitted.EvalInstance()) << expr << " entry " << entry;
+      }
+   }
+}
+
+TEST(TTreeFormulaJit, Fallback)
+{
+   auto tree = MakeJitTree();
+   TTreeFormula::SetJitCompilation(kTRUE);
+   TTreeFormula simple("simple", "f*d+i", tree.get());
+   TTreeFormula array("array", "arr*f", tree.get());
+   TTreeFormula length("length", "Length$(arr)+f", tree.get());
+   TTreeFormula::SetJitCompilation(kFALSE);
+   EXPECT_TRUE(simple.IsJitted());
+   EXPECT_FALSE(array.IsJitted());
+   EXPECT_FALSE(length.IsJitted());
+}
+
+TEST(TTreeFormulaJit, DecidedAtCreation)
+{
+   auto tree = MakeJitTree();
+   TTreeFormula interpreted("interpreted", "f*d+i", tree.get());
+   TTreeFormula::SetJitCompilation(kTRUE);
+   TTreeFormula jitted("jitted", "f*d+i", tree.get());
+   // As when a chain moves to its next tree.
+   interpreted.UpdateFormulaLeaves();
+   TTreeFormula::SetJitCompilation(kFALSE);
+   jitted.UpdateFormulaLeaves();
+   EXPECT_FALSE(interpreted.IsJitted());
+   EXPECT_TRUE(jitted.IsJitted());
+}
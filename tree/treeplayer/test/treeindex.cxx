@@ -0,0 +1,100 @@
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeIndex.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <random>
+
+class TTreeIndexTest : public ::testing::Test {
+protected:
+   const char *fFileName = "treeindex.root";
+   const Long64_t fNEntries = 20000;
+
+   virtual void SetUp()
+   {
+      TFile f(fFileName, "RECREATE");
+      TTree t("t", "t");
+      Int_t run = 0;
+      Long64_t event = 0;
+      Float_t x = 0.;
+      t.Branch("run", &run);
+      t.Branch("event", &event);
+      t.Branch("x", &x);
+      t.SetAutoFlush(1000);
+      std::mt19937 rng(7);
+      for (Long64_t i = 0; i < fNEntries; ++i) {
+         run = static_cast<Int_t>(rng() % 20) - 5;
+         event = static_cast<Long64_t>(rng() % 100000) - 50000;
+         x = 0.5f * static_cast<Float_t>(rng() % 1000);
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   virtual void TearDown() { gSystem->Unlink(fFileName); }
+};
+
+// The index built from branches read in bulk must be the same as the one built from formulas
+TEST_F(TTreeIndexTest, BulkAndFormula)
+{
+   TFile f(fFileName);
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+
+   TTreeIndex bulk(t, "run", "event");
+   TTreeIndex formula(t, "run+0", "event*1");
+   ASSERT_EQ(bulk.GetN(), fNEntries);
+   ASSERT_EQ(formula.GetN(), fNEntries);
+   for (Long64_t i = 0; i < fNEntries; ++i) {
+      EXPECT_EQ(bulk.GetIndexValues()[i], formula.GetIndexValues()[i]);
+      EXPECT_EQ(bulk.GetIndexValuesMinor()[i], formula.GetIndexValuesMinor()[i]);
+      if (i > 0) {
+         const bool sorted = bulk.GetIndexValues()[i - 1] < bulk.GetIndexValues()[i] ||
+                             (bulk.GetIndexValues()[i - 1] == bulk.GetIndexValues()[i] &&
+                              bulk.GetIndexValuesMinor()[i - 1] <= bulk.GetIndexValuesMinor()[i]);
+         EXPECT_TRUE(sorted) << "at position " << i;
+      }
+   }
+
+   TTreeIndex floatIndex(t, "x", "0");
+   TTreeIndex floatFormula(t, "x*1", "0");
+   for (Long64_t i = 0; i < fNEntries; ++i)
+      EXPECT_EQ(floatIndex.GetIndexValues()[i], floatFormula.GetIndexValues()[i]);
+}
+
+TEST_F(TTreeIndexTest, Lookup)
+{
+   TFile f(fFileName);
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   ASSERT_GT(t->BuildIndex("run", "event"), 0);
+   auto index = t->GetTreeIndex();
+
+   Int_t run = 0;
+   Long64_t event = 0;
+   t->SetBranchAddress("run", &run);
+   t->SetBranchAddress("event", &event);
+   // Lookups in entry order and in index order (which uses the position of the previous lookup)
+   for (Long64_t i = 0; i < fNEntries; ++i) {
+      t->GetEntry(i);
+      const auto found = index->GetEntryNumberWithIndex(run, event);
+      ASSERT_GE(found, 0);
+      t->GetEntry(found);
+      EXPECT_EQ(index->GetEntryNumberWithIndex(run, event), found);
+   }
+   auto treeIndex = static_cast<TTreeIndex *>(index);
+   auto values = treeIndex->GetIndexValues();
+   auto valuesMinor = treeIndex->GetIndexValuesMinor();
+   Long64_t first = 0; // first position with the same key as position i
+   for (Long64_t i = 0; i < fNEntries; ++i) {
+      if (values[i] != values[first] || valuesMinor[i] != valuesMinor[first])
+         first = i;
+      EXPECT_EQ(index->GetEntryNumberWithIndex(values[i], valuesMinor[i]), treeIndex->GetIndex()[first]);
+   }
+   EXPECT_EQ(index->GetEntryNumberWithIndex(1000, 0), -1);
+   EXPECT_EQ(index->GetEntryNumberWithIndex(-1000, 0), -1);
+   t->ResetBranchAddresses();
+}
@@ -0,0 +1,160 @@
+#include <string>
+#include <vector>
+
+#include <TChain.h>
+#include <TFile.h>
+#include <TH2.h>
+#include <TProfile.h>
+#include <TROOT.h>
+#include <TSelectorDraw.h>
+#include <TSystem.h>
+#include <TTree.h>
+#include <TTreePlayer.h>
+#include <TVirtualPad.h>
+
+#include "gtest/gtest.h"
+
+class DrawMT : public ::testing::Test {
+protected:
+   const std::vector<std::string> fFileNames{"drawmt_0.root", "drawmt_1.root", "drawmt_2.root"};
+
+   void SetUp() override
+   {
+      int n = 0;
+      float x[4];
+      double y = 0.;
+      int entry = 0;
+      for (const auto &fileName : fFileNames) {
+         TFile file(fileName.c_str(), "RECREATE");
+         TTree t("t", "t");
+         t.SetAutoFlush(1000);
+         t.Branch("n", &n, "n/I");
+         t.Branch("x", x, "x[n]/F");
+         t.Branch("y", &y, "y/D");
+         for (int i = 0; i < 10000; ++i, ++entry) {
+            n = entry % 5;
+            for (int j = 0; j < n; ++j)
+               x[j] = (entry * 7 + j * 13) % 101 - 50.5f;
+            y = (entry % 97) * 0.25 - 3.;
+            t.Fill();
+         }
+         t.Write();
+      }
+   }
+
+   void TearDown() override
+   {
+      for (const auto &fileName : fFileNames)
+         gSystem->Unlink(fileName.c_str());
+   }
+};
+
+static void ExpectSameHistograms(const TH1 &serial, const TH1 &parallel)
+{
+   ASSERT_EQ(serial.GetNcells(), parallel.GetNcells());
+   EXPECT_EQ(serial.GetEntries(), parallel.GetEntries());
+   for (int i = 0; i < serial.GetNcells(); ++i) {
+      EXPECT_DOUBLE_EQ(serial.GetBinContent(i), parallel.GetBinContent(i)) << serial.GetName() << " bin " << i;
+      EXPECT_DOUBLE_EQ(serial.GetBinError(i), parallel.GetBinError(i)) << serial.GetName() << " bin " << i;
+   }
+}
+
+// Number of parallel workers merged by the last TTree::Draw of tree, 0 if it ran sequentially
+static int GetNMergedWorkers(TTree &tree)
+{
+   auto player = static_cast<TTreePlayer *>(tree.GetPlayer());
+   return static_cast<TSelectorDraw *>(player->GetSelector())->GetNMergedWorkers();
+}
+
+TEST_F(DrawMT, SameAsSequential)
+{
+   TChain chain("t");
+   for (const auto &fileName : fFileNames)
+      chain.Add(fileName.c_str());
+
+   // expression, selection, option
+   const std::vector<std::vector<std::string>> draws{{"y>>%s(50,-5,25)", "", "goff"},
+                                                     {"x>>%s(101,-51,51)", "y>0", "goff"},
+                                                     {"x:y>>%s(20,-5,25,20,-51,51)", "(n>2)*y", "goff"},
+                                                     {"x:y>>%s(20,-5,25)", "x>0", "goff prof"}};
+   int idraw = 0;
+   for (const auto &draw : draws) {
+      const auto serialName = "serial" + std::to_string(idraw);
+      const auto parallelName = "parallel" + std::to_string(idraw++);
+      const auto nSerial = chain.Draw(Form(draw[0].c_str(), serialName.c_str()), draw[1].c_str(), draw[2].c_str());
+      EXPECT_EQ(0, GetNMergedWorkers(chain)) << draw[0];
+      ROOT::EnableImplicitMT(4);
+      const auto nParallel =
+         chain.Draw(Form(draw[0].c_str(), parallelName.c_str()), draw[1].c_str(), draw[2].c_str());
+      ROOT::DisableImplicitMT();
+      EXPECT_LT(1, GetNMergedWorkers(chain)) << draw[0];
+      EXPECT_EQ(nSerial, nParallel) << draw[0];
+
+      auto serial = static_cast<TH1 *>(gDirectory->Get(serialName.c_str()));
+      auto parallel = static_cast<TH1 *>(gDirectory->Get(parallelName.c_str()));
+      ASSERT_NE(serial, nullptr);
+      ASSERT_NE(parallel, nullptr);
+      EXPECT_EQ(serial->IsA(), parallel->IsA());
+      ExpectSameHistograms(*serial, *parallel);
+   }
+}
+
+TEST_F(DrawMT, Project)
+{
+   TFile file(fFileNames[1].c_str());
+   auto tree = static_cast<TTree *>(file.Get("t"));
+   ASSERT_NE(tree, nullptr);
+
+   TH1D serial("serial", "serial", 40, -60., 60.);
+   TH1D parallel("parallel", "parallel", 40, -60., 60.);
+   tree->Project("serial", "x", "y*y");
+   ROOT::EnableImplicitMT(4);
+   tree->Project("parallel", "x", "y*y");
+   ROOT::DisableImplicitMT();
+   EXPECT_LT(1, GetNMergedWorkers(*tree));
+   ExpectSameHistograms(serial, parallel);
+}
+
+TEST_F(DrawMT, Deterministic)
+{
+   TChain chain("t");
+   for (const auto &fileName : fFileNames)
+      chain.Add(fileName.c_str());
+
+   ROOT::EnableImplicitMT(4);
+   chain.Draw("x*y>>first(100,-1000,1000)", "y*0.1", "goff");
+   chain.Draw("x*y>>second(100,-1000,1000)", "y*0.1", "goff");
+   ROOT::DisableImplicitMT();
+   auto first = static_cast<TH1 *>(gDirectory->Get("first"));
+   auto second = static_cast<TH1 *>(gDirectory->Get("second"));
+   ASSERT_NE(first, nullptr);
+   ASSERT_NE(second, nullptr);
+   for (int i = 0; i < first->GetNcells(); ++i) {
+      EXPECT_EQ(first->GetBinContent(i), second->GetBinContent(i)) << "bin " << i;
+      EXPECT_EQ(first->GetBinError(i), second->GetBinError(i)) << "bin " << i;
+   }
+}
+
+TEST_F(DrawMT, DrawOnPad)
+{
+   TChain chain("t");
+   for (const auto &fileName : fFileNames)
+      chain.Add(fileName.c_str());
+
+   // The profiles are only displayed once the action of the selector is
+   // positive, i.e. after the estimate pass, which the workers skip.
+   const bool batch = gROOT->IsBatch();
+   gROOT->SetBatch(kTRUE);
+   ROOT::EnableImplicitMT(4);
+   for (const auto &draw : std::vector<std::string>{"x:y>>padprof(20,-5,25)", "x:y:n>>padprof2d(5,0,5,20,-5,25)"}) {
+      chain.Draw(draw.c_str(), "", "prof");
+      EXPECT_LT(1, GetNMergedWorkers(chain)) << draw;
+      ASSERT_NE(nullptr, gPad) << draw;
+      const auto name = draw.substr(draw.find(">>") + 2, draw.find('(') - draw.find(">>") - 2);
+      auto hist = gDirectory->Get(name.c_str());
+      ASSERT_NE(nullptr, hist) << draw;
+      EXPECT_EQ(hist, gPad->GetListOfPrimitives()->FindObject(name.c_str())) << draw;
+   }
+   ROOT::DisableImplicitMT();
+   gROOT->SetBatch(batch);
+}
@@ -1,6 +1,8 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <map>
+#include <mutex>
 #include <random>
 #include <string>
 #include <thread>
@@ -217,6 +219,46 @@ TEST(TreeProcessorMT, LimitNTasks_CheckClusters)
    ROOT::DisableImplicitMT();
 }
 
+TEST(TreeProcessorMT, UnevenFiles)
+{
+   const std::vector<unsigned int> nEvents{3, 400, 1, 57};
+   const std::vector<std::string> filenames{"TreeProcessorMT_UnevenFiles_0.root", "TreeProcessorMT_UnevenFiles_1.root",
+                                            "TreeProcessorMT_UnevenFiles_2.root", "TreeProcessorMT_UnevenFiles_3.root"};
+   const auto treename = "t";
+   for (auto i = 0u; i < filenames.size(); ++i)
+      WriteFileManyClusters(nEvents[i], treename, filenames[i].c_str());
+
+   std::mutex m;
+   std::map<std::string, std::vector<std::pair<Long64_t, Long64_t>>> rangesPerFile;
+   auto get_ranges = [&m, &rangesPerFile](TTreeReader &t) {
+      const std::string fname = t.GetTree()->GetCurrentFile()->GetName();
+      std::lock_guard<std::mutex> l(m);
+      rangesPerFile[fname].emplace_back(t.GetEntriesRange());
+   };
+
+   ROOT::DisableImplicitMT();
+   ROOT::EnableImplicitMT(4);
+
+   // Once with files opened while processing, once with metadata cached in the chain
+   for (auto scan : {false, true}) {
+      TChain chain(treename);
+      for (const auto &f : filenames)
+         chain.Add(f.c_str());
+      if (scan)
+         chain.ScanMetadata();
+      ROOT::TTreeProcessorMT p(chain);
+      p.Process(get_ranges);
+
+      ASSERT_EQ(rangesPerFile.size(), filenames.size());
+      for (auto i = 0u; i < filenames.size(); ++i)
+         CheckClusters(rangesPerFile[filenames[i]], nEvents[i]);
+      rangesPerFile.clear();
+   }
+
+   DeleteFiles(filenames);
+   ROOT::DisableImplicitMT();
+}
+
 TEST(TreeProcessorMT, PathName)
 {
    auto fname = "root://eospublic.cern.ch//eos/root-eos/cms_opendata_2012_nanoaod/ZZTo4mu.root";